@@ -4,11 +4,90 @@
 #include "Components/SKGAttachmentManager.h"
 #include "Components/SKGAttachmentComponent.h"
 #include "Interfaces/SKGAttachmentInterface.h"
+#include "SKGAttachmentActor.h"
+#include "SKGAttachmentMeshMergeWorldSubsystem.h"
 
 #include "Net/UnrealNetwork.h"
 #include "Net/Core/PushModel/PushModel.h"
 #include "TimerManager.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/ShapeComponent.h"
+#include "GameFramework/Pawn.h"
 #include "Misc/SKGAttachmentFunctionLibrary.h"
+#include "Algo/BinarySearch.h"
+
+DECLARE_CYCLE_STAT(TEXT("CacheAttachmentComponents"), STAT_SKGCacheAttachmentComponents, STATGROUP_SKGAttachment);
+DECLARE_CYCLE_STAT(TEXT("UpdateAttachmentCache"), STAT_SKGUpdateAttachmentCache, STATGROUP_SKGAttachment);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AttachmentCacheFullRebuilds"), STAT_SKGAttachmentCacheFullRebuilds, STATGROUP_SKGAttachment);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AttachmentCacheIncrementalUpdates"), STAT_SKGAttachmentCacheIncrementalUpdates, STATGROUP_SKGAttachment);
+DECLARE_CYCLE_STAT(TEXT("MergeAttachmentMeshes"), STAT_SKGMergeAttachmentMeshes, STATGROUP_SKGAttachment);
+DECLARE_DWORD_COUNTER_STAT(TEXT("MergedAttachmentMeshComponents"), STAT_SKGMergedAttachmentMeshComponents, STATGROUP_SKGAttachment);
+DECLARE_CYCLE_STAT(TEXT("ResolveAttachmentOverlaps"), STAT_SKGResolveAttachmentOverlaps, STATGROUP_SKGAttachment);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AttachmentOverlapTests"), STAT_SKGAttachmentOverlapTests, STATGROUP_SKGAttachment);
+
+namespace SKGAttachmentCache
+{
+	// Attachments that are being destroyed are treated as already removed
+	AActor* GetCacheableAttachment(const USKGAttachmentComponent* AttachmentComponent)
+	{
+		AActor* Attachment = AttachmentComponent->GetAttachment();
+		if (IsValid(Attachment) && !Attachment->IsActorBeingDestroyed() && Attachment->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
+		{
+			return Attachment;
+		}
+		return nullptr;
+	}
+
+	// Same order as a rebuild, the attachments own components first and then the components below each of them in turn
+	void GatherChildAttachmentComponents(const USKGAttachmentComponent* AttachmentComponent, TArray<USKGAttachmentComponent*>& OutAttachmentComponents)
+	{
+		if (AActor* Attachment = GetCacheableAttachment(AttachmentComponent))
+		{
+			const int32 Start = OutAttachmentComponents.Num();
+			for (USKGAttachmentComponent* Component : ISKGAttachmentInterface::Execute_GetAttachmentComponents(Attachment))
+			{
+				if (IsValid(Component))
+				{
+					OutAttachmentComponents.Add(Component);
+				}
+			}
+			const int32 End = OutAttachmentComponents.Num();
+			for (int32 i = Start; i < End; ++i)
+			{
+				GatherChildAttachmentComponents(OutAttachmentComponents[i], OutAttachmentComponents);
+			}
+		}
+	}
+}
+
+void FSKGAttachmentComponentItem::PreReplicatedRemove(const FSKGAttachmentComponentArray& InArraySerializer)
+{
+	if (InArraySerializer.AttachmentManager && RegisteredAttachmentComponent.IsValid())
+	{
+		InArraySerializer.AttachmentManager->UnregisterAttachmentComponent(RegisteredAttachmentComponent.Get());
+	}
+	RegisteredAttachmentComponent.Reset();
+}
+
+void FSKGAttachmentComponentItem::PostReplicatedAdd(const FSKGAttachmentComponentArray& InArraySerializer)
+{
+	if (InArraySerializer.AttachmentManager && AttachmentComponent)
+	{
+		RegisteredAttachmentComponent = AttachmentComponent;
+		InArraySerializer.AttachmentManager->RegisterAttachmentComponent(AttachmentComponent);
+	}
+}
+
+void FSKGAttachmentComponentItem::PostReplicatedChange(const FSKGAttachmentComponentArray& InArraySerializer)
+{
+	// Also hit when a component that could not be resolved on add gets mapped
+	if (InArraySerializer.AttachmentManager && RegisteredAttachmentComponent.Get() != AttachmentComponent)
+	{
+		PreReplicatedRemove(InArraySerializer);
+		PostReplicatedAdd(InArraySerializer);
+	}
+}
 
 // Sets default values for this component's properties
 USKGAttachmentManager::USKGAttachmentManager()
@@ -18,9 +97,25 @@ USKGAttachmentManager::USKGAttachmentManager()
 
 	bSpawnDefaultPartsFromPreset = true;
 	InitalOnAttachmentUpdatedDelay = 0.25f;
+	bValidateAttachmentCacheUpdates = false;
 	bInitDone = false;
+	bApplyingAttachmentChanges = false;
 	bEssentialAttachmentsValid = false;
 	NewMaxAttachments = 10;
+	bMergeAttachmentMeshes = false;
+	AttachmentMeshMergeDelay = 1.0f;
+	bMergeWhenLocallyControlled = false;
+	MeshMergeSerial = 0;
+	bUseAttachmentBroadphase = true;
+	BroadphaseAxis = 0;
+	BroadphaseMaxAxisSize = 0.0;
+	bAttachmentBroadphaseDirty = true;
+}
+
+void USKGAttachmentManager::PostInitProperties()
+{
+	Super::PostInitProperties();
+	ReplicatedAttachmentComponents.AttachmentManager = this;
 }
 
 // Called when the game starts
@@ -38,7 +133,7 @@ void USKGAttachmentManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	FDoRepLifetimeParams Params;
 	Params.bIsPushBased = true;
-	DOREPLIFETIME_WITH_PARAMS_FAST(USKGAttachmentManager, AttachmentComponents, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USKGAttachmentManager, ReplicatedAttachmentComponents, Params);
 }
 
 void USKGAttachmentManager::SetMasterPoseComponent(USkeletalMeshComponent* SkeletalMeshComponent, float Delay) const
@@ -66,13 +161,13 @@ bool USKGAttachmentManager::AttachmentExists(USKGAttachmentComponent* Attachment
 	return false;
 }
 
-void USKGAttachmentManager::OnRep_AttachmentComponents()
-{
-	HandleCachingAttachmentComponents();
-}
-
 void USKGAttachmentManager::AttachmentChanged(USKGAttachmentComponent* AttachmentComponent)
 {
+	if (bInitDone)
+	{
+		UpdateAttachmentCache(AttachmentComponent);
+	}
+	
 	if (IsValid(AttachmentComponent) && CachedEssentialAttachmentComponents.Contains(AttachmentComponent))
 	{
 		if (AttachmentComponent->HasAttachment())
@@ -126,6 +221,14 @@ void USKGAttachmentManager::DestroyAll()
 
 void USKGAttachmentManager::HideAllAttachments(bool bHide)
 {
+	for (UStaticMeshComponent* MergedMeshComponent : MergedMeshComponents)
+	{
+		if (IsValid(MergedMeshComponent))
+		{
+			MergedMeshComponent->SetHiddenInGame(bHide);
+		}
+	}
+	
 	TArray<AActor*> ActorsToDestroy;
 	ActorsToDestroy.Reserve(CachedAttachmentComponents.Num());
 	for (int i = 0; i < CachedAttachmentComponents.Num(); ++i)
@@ -180,12 +283,90 @@ void USKGAttachmentManager::SetCollisionAll(bool bEnable)
 
 void USKGAttachmentManager::AddAttachment(USKGAttachmentComponent* AttachmentComponent)
 {
-	if (IsValid(AttachmentComponent))
+	if (IsValid(AttachmentComponent) && !AttachmentComponents.Contains(AttachmentComponent))
+	{
+		FSKGAttachmentComponentItem& Item = ReplicatedAttachmentComponents.Items.Emplace_GetRef(AttachmentComponent);
+		Item.RegisteredAttachmentComponent = AttachmentComponent;
+		ReplicatedAttachmentComponents.MarkItemDirty(Item);
+		MARK_PROPERTY_DIRTY_FROM_NAME(USKGAttachmentManager, ReplicatedAttachmentComponents, this);
+		RegisterAttachmentComponent(AttachmentComponent);
+	}
+}
+
+void USKGAttachmentManager::RemoveAttachment(USKGAttachmentComponent* AttachmentComponent)
+{
+	const int32 Index = ReplicatedAttachmentComponents.Items.IndexOfByPredicate([AttachmentComponent](const FSKGAttachmentComponentItem& Item) { return Item.AttachmentComponent == AttachmentComponent; });
+	if (Index != INDEX_NONE)
+	{
+		ReplicatedAttachmentComponents.Items.RemoveAt(Index);
+		ReplicatedAttachmentComponents.MarkArrayDirty();
+		MARK_PROPERTY_DIRTY_FROM_NAME(USKGAttachmentManager, ReplicatedAttachmentComponents, this);
+		UnregisterAttachmentComponent(AttachmentComponent);
+	}
+}
+
+void USKGAttachmentManager::RegisterAttachmentComponent(USKGAttachmentComponent* AttachmentComponent)
+{
+	if (!IsValid(AttachmentComponent) || AttachmentComponents.Contains(AttachmentComponent))
+	{
+		return;
+	}
+	
+	AttachmentComponents.Add(AttachmentComponent);
+	if (!bInitDone)
+	{
+		HandleCachingAttachmentComponents();
+		return;
+	}
+
+	AttachmentChanges.Reset();
+	// Top level components lead the cache in AttachmentComponents order, this one is last
+	CachedAttachmentComponents.Insert(AttachmentComponent, AttachmentComponents.Num() - 1);
+	CachedComponentAttachments.Add(AttachmentComponent, nullptr);
+	if (AttachmentComponent->IsEssential())
+	{
+		CachedEssentialAttachmentComponents.Add(AttachmentComponent);
+		HandleEssentialAttachmentValidation();
+	}
+	if (AActor* Attachment = SKGAttachmentCache::GetCacheableAttachment(AttachmentComponent))
+	{
+		int32 InsertIndex = GetCachedSubtreeStart(AttachmentComponent);
+		AddAttachmentToCache(AttachmentComponent, Attachment, true, InsertIndex);
+	}
+	BroadcastAttachmentChanges();
+}
+
+void USKGAttachmentManager::UnregisterAttachmentComponent(USKGAttachmentComponent* AttachmentComponent)
+{
+	if (!AttachmentComponents.Contains(AttachmentComponent))
+	{
+		return;
+	}
+	
+	if (!bInitDone)
+	{
+		AttachmentComponents.Remove(AttachmentComponent);
+		HandleCachingAttachmentComponents();
+		return;
+	}
+
+	AttachmentChanges.Reset();
+	// Still registered here so its subtree is located in the root block order
+	if (AActor** CachedAttachment = CachedComponentAttachments.Find(AttachmentComponent))
+	{
+		if (*CachedAttachment)
+		{
+			RemoveAttachmentFromCache(AttachmentComponent);
+		}
+		CachedComponentAttachments.Remove(AttachmentComponent);
+	}
+	AttachmentComponents.Remove(AttachmentComponent);
+	CachedAttachmentComponents.RemoveSingle(AttachmentComponent);
+	if (CachedEssentialAttachmentComponents.Remove(AttachmentComponent))
 	{
-		AttachmentComponents.Add(AttachmentComponent);
-		MARK_PROPERTY_DIRTY_FROM_NAME(USKGAttachmentManager, AttachmentComponents, this);
-		OnRep_AttachmentComponents();
+		HandleEssentialAttachmentValidation();
 	}
+	BroadcastAttachmentChanges();
 }
 
 TArray<USKGAttachmentComponent*> USKGAttachmentManager::GetAllAttachmentComponents(bool bReCache)
@@ -227,23 +408,242 @@ void USKGAttachmentManager::HandleEssentialAttachmentValidation()
 	}
 }
 
+void USKGAttachmentManager::UpdateAttachmentCache(USKGAttachmentComponent* AttachmentComponent)
+{
+	AActor** CachedAttachment = IsValid(AttachmentComponent) ? CachedComponentAttachments.Find(AttachmentComponent) : nullptr;
+	if (!bInitDone || !CachedAttachment)
+	{
+		HandleCachingAttachmentComponents();
+		return;
+	}
+
+	AActor* Attachment = SKGAttachmentCache::GetCacheableAttachment(AttachmentComponent);
+	const bool bHadAttachment = *CachedAttachment != nullptr;
+	if (*CachedAttachment == Attachment)
+	{
+		return;
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SKGUpdateAttachmentCache);
+		INC_DWORD_STAT(STAT_SKGAttachmentCacheIncrementalUpdates);
+		AttachmentChanges.Reset();
+		if (bHadAttachment)
+		{
+			RemoveAttachmentFromCache(AttachmentComponent);
+		}
+		if (Attachment)
+		{
+			int32 InsertIndex = GetCachedSubtreeStart(AttachmentComponent);
+			AddAttachmentToCache(AttachmentComponent, Attachment, true, InsertIndex);
+		}
+		MarkOwnerAttachmentCachesDirty(AttachmentComponent);
+	}
+
+	BroadcastAttachmentChanges();
+}
+
+void USKGAttachmentManager::BroadcastAttachmentChanges()
+{
+	bAttachmentBroadphaseDirty = true;
+	if (bValidateAttachmentCacheUpdates)
+	{
+		ValidateAttachmentCache();
+	}
+	
+	if (AttachmentChanges.Num())
+	{
+		for (const FSKGAttachmentChange& AttachmentChange : AttachmentChanges)
+		{
+			OnAttachmentCacheChanged.Broadcast(AttachmentChange);
+		}
+		bApplyingAttachmentChanges = true;
+		CallOnAttachmentUpdated();
+		bApplyingAttachmentChanges = false;
+		AttachmentChanges.Reset();
+	}
+}
+
+void USKGAttachmentManager::AddAttachmentToCache(USKGAttachmentComponent* AttachmentComponent, AActor* Attachment, bool bRecordChange, int32& InsertIndex)
+{
+	CachedComponentAttachments.Add(AttachmentComponent, Attachment);
+	AddAttachmentToClassIndex(Attachment);
+	if (bRecordChange)
+	{
+		AttachmentChanges.Emplace(AttachmentComponent, Attachment, ESKGAttachmentChangeType::Added);
+	}
+	if (ASKGAttachmentActor* AttachmentActor = Cast<ASKGAttachmentActor>(Attachment))
+	{
+		AttachmentActor->MarkAttachmentCacheDirty();
+	}
+
+	// Grouped by level like a rebuild, the components on this attachment first and then the subtree of each of them
+	TArray<USKGAttachmentComponent*, TInlineAllocator<8>> ChildComponents;
+	for (USKGAttachmentComponent* Component : ISKGAttachmentInterface::Execute_GetAttachmentComponents(Attachment))
+	{
+		if (IsValid(Component))
+		{
+			CachedAttachmentComponents.Insert(Component, InsertIndex++);
+			CachedChildAttachmentComponents.Add(AttachmentComponent, Component);
+			CachedParentAttachmentComponents.Add(Component, AttachmentComponent);
+			CachedComponentAttachments.Add(Component, nullptr);
+			ChildComponents.Add(Component);
+		}
+	}
+	for (USKGAttachmentComponent* Component : ChildComponents)
+	{
+		if (AActor* ChildAttachment = SKGAttachmentCache::GetCacheableAttachment(Component))
+		{
+			AddAttachmentToCache(Component, ChildAttachment, bRecordChange, InsertIndex);
+		}
+	}
+}
+
+void USKGAttachmentManager::RemoveAttachmentFromCache(USKGAttachmentComponent* AttachmentComponent)
+{
+	// The subtree is contiguous in the cache, drop it in one go before the child links are cleared
+	CachedAttachmentComponents.RemoveAt(GetCachedSubtreeStart(AttachmentComponent), GetCachedSubtreeSize(AttachmentComponent), false);
+	RemoveCachedAttachment(AttachmentComponent);
+}
+
+void USKGAttachmentManager::RemoveCachedAttachment(USKGAttachmentComponent* AttachmentComponent)
+{
+	AActor*& CachedAttachment = CachedComponentAttachments.FindChecked(AttachmentComponent);
+	AttachmentChanges.Emplace(AttachmentComponent, CachedAttachment, ESKGAttachmentChangeType::Removed);
+	RemoveAttachmentFromClassIndex(CachedAttachment);
+	CachedAttachment = nullptr;
+
+	TArray<USKGAttachmentComponent*, TInlineAllocator<8>> ChildComponents;
+	CachedChildAttachmentComponents.MultiFind(AttachmentComponent, ChildComponents);
+	CachedChildAttachmentComponents.Remove(AttachmentComponent);
+	for (USKGAttachmentComponent* Component : ChildComponents)
+	{
+		CachedParentAttachmentComponents.Remove(Component);
+		if (const AActor* const* ChildAttachment = CachedComponentAttachments.Find(Component))
+		{
+			if (*ChildAttachment)
+			{
+				RemoveCachedAttachment(Component);
+			}
+			CachedComponentAttachments.Remove(Component);
+		}
+	}
+}
+
+int32 USKGAttachmentManager::GetCachedSubtreeSize(USKGAttachmentComponent* AttachmentComponent) const
+{
+	int32 Size = 0;
+	for (auto It = CachedChildAttachmentComponents.CreateConstKeyIterator(AttachmentComponent); It; ++It)
+	{
+		Size += 1 + GetCachedSubtreeSize(It.Value());
+	}
+	return Size;
+}
+
+int32 USKGAttachmentManager::GetCachedSubtreeStart(USKGAttachmentComponent* AttachmentComponent) const
+{
+	// A components subtree follows its siblings and the subtrees of the siblings before it,
+	// top level components are the siblings at the start of the cache
+	TArrayView<USKGAttachmentComponent* const> Siblings = AttachmentComponents;
+	int32 Start = AttachmentComponents.Num();
+	if (USKGAttachmentComponent* const* ParentComponent = CachedParentAttachmentComponents.Find(AttachmentComponent))
+	{
+		const int32 ParentStart = GetCachedSubtreeStart(*ParentComponent);
+		const int32 NumSiblings = CachedChildAttachmentComponents.Num(*ParentComponent);
+		Siblings = MakeArrayView(CachedAttachmentComponents.GetData() + ParentStart, NumSiblings);
+		Start = ParentStart + NumSiblings;
+	}
+
+	for (USKGAttachmentComponent* Sibling : Siblings)
+	{
+		if (Sibling == AttachmentComponent)
+		{
+			break;
+		}
+		Start += GetCachedSubtreeSize(Sibling);
+	}
+	return Start;
+}
+
+void USKGAttachmentManager::MarkOwnerAttachmentCachesDirty(const USKGAttachmentComponent* AttachmentComponent) const
+{
+	// Attachment actors above the changed component hold a flattened cache of everything below them
+	AActor* Owner = AttachmentComponent->GetOwner();
+	for (int32 i = 0; i < USKGAttachmentFunctionLibrary::MaxAttachmentStack && Owner && Owner != GetOwner(); ++i)
+	{
+		if (ASKGAttachmentActor* AttachmentActor = Cast<ASKGAttachmentActor>(Owner))
+		{
+			AttachmentActor->MarkAttachmentCacheDirty();
+		}
+		Owner = Owner->GetOwner();
+	}
+}
+
+bool USKGAttachmentManager::ValidateAttachmentCache() const
+{
+	TArray<USKGAttachmentComponent*> ExpectedAttachmentComponents;
+	ExpectedAttachmentComponents.Reserve(CachedAttachmentComponents.Num());
+	ExpectedAttachmentComponents.Append(AttachmentComponents);
+	for (const USKGAttachmentComponent* AttachmentComponent : AttachmentComponents)
+	{
+		if (IsValid(AttachmentComponent))
+		{
+			SKGAttachmentCache::GatherChildAttachmentComponents(AttachmentComponent, ExpectedAttachmentComponents);
+		}
+	}
+
+	bool bValid = ExpectedAttachmentComponents.Num() == CachedAttachmentComponents.Num();
+	for (int32 i = 0; i < ExpectedAttachmentComponents.Num(); ++i)
+	{
+		const USKGAttachmentComponent* AttachmentComponent = ExpectedAttachmentComponents[i];
+		if (!IsValid(AttachmentComponent))
+		{
+			continue;
+		}
+		const AActor* const* CachedAttachment = CachedComponentAttachments.Find(AttachmentComponent);
+		if (!CachedAttachmentComponents.Contains(AttachmentComponent) || !CachedAttachment || *CachedAttachment != SKGAttachmentCache::GetCacheableAttachment(AttachmentComponent))
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s: Attachment cache out of sync for component: %s"), *GetNameSafe(GetOwner()), *GetNameSafe(AttachmentComponent));
+			bValid = false;
+		}
+		else if (!CachedAttachmentComponents.IsValidIndex(i) || CachedAttachmentComponents[i] != AttachmentComponent)
+		{	// Consumers such as Sights[0] depend on the cache order matching a rebuild
+			UE_LOG(LogTemp, Error, TEXT("%s: Attachment cache order differs from a full rebuild at index %d: %s"), *GetNameSafe(GetOwner()), i, *GetNameSafe(AttachmentComponent));
+			bValid = false;
+		}
+	}
+	if (ExpectedAttachmentComponents.Num() != CachedAttachmentComponents.Num())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s: Attachment cache has %d components, full rebuild has %d"), *GetNameSafe(GetOwner()), CachedAttachmentComponents.Num(), ExpectedAttachmentComponents.Num());
+	}
+	return bValid;
+}
+
 void USKGAttachmentManager::CacheAttachmentComponents()
 {
+	SCOPE_CYCLE_COUNTER(STAT_SKGCacheAttachmentComponents);
+	INC_DWORD_STAT(STAT_SKGAttachmentCacheFullRebuilds);
 	bInitDone = true;
+	bAttachmentBroadphaseDirty = true;
 	
 	CachedAttachmentComponents.Empty();
 	CachedAttachmentComponents.Reserve(12);
 	CachedAttachmentComponents.Append(AttachmentComponents);
+	CachedComponentAttachments.Reset();
+	CachedChildAttachmentComponents.Reset();
+	CachedParentAttachmentComponents.Reset();
+	AttachmentClassIndex.Reset();
 	CachedEssentialAttachmentComponents.Empty();
 	CachedEssentialAttachmentComponents.Reserve(AttachmentComponents.Num());
 	for (USKGAttachmentComponent* AttachmentComponent : AttachmentComponents)
 	{
 		if (IsValid(AttachmentComponent))
 		{
-			AActor* Actor = AttachmentComponent->GetAttachment();
-			if (IsValid(Actor) && Actor->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
+			CachedComponentAttachments.Add(AttachmentComponent, nullptr);
+			if (AActor* Actor = SKGAttachmentCache::GetCacheableAttachment(AttachmentComponent))
 			{
-				CachedAttachmentComponents.Append(ISKGAttachmentInterface::Execute_GetAllAttachmentComponents(Actor, true));
+				int32 InsertIndex = CachedAttachmentComponents.Num();
+				AddAttachmentToCache(AttachmentComponent, Actor, false, InsertIndex);
 			}
 
 			if (AttachmentComponent->IsEssential())
@@ -260,6 +660,12 @@ void USKGAttachmentManager::CacheAttachmentComponents()
 
 void USKGAttachmentManager::CallOnAttachmentUpdated()
 {
+	// Managers that never merge skip the unmerge and the timer on every attachment change
+	if (IsAttachmentMeshMerged() || ShouldMergeAttachmentMeshes() || (GetWorld() && GetWorld()->GetTimerManager().IsTimerActive(TMeshMergeTimerHandle)))
+	{
+		InvalidateAttachmentMeshMerge();
+	}
+
 	if (GetOwner() && GetOwner()->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
 	{
 		ISKGAttachmentInterface::Execute_OnAttachmentUpdated(GetOwner());
@@ -283,26 +689,516 @@ TArray<AActor*> USKGAttachmentManager::GetAttachmentsOfType(const TSubclassOf<AA
 	return Attachments;
 }
 
+TArray<AActor*> USKGAttachmentManager::GetAllAttachmentsOfType(const TSubclassOf<AActor> Type)
+{
+	return GetAttachmentsOfClass(Type);
+}
+
+const TArray<AActor*>& USKGAttachmentManager::GetAttachmentsOfClass(const UClass* Type)
+{
+	static const TArray<AActor*> EmptyAttachments;
+	if (!Type)
+	{
+		return EmptyAttachments;
+	}
+	if (!bInitDone)
+	{
+		// The index is built with the first cache, until then walk the tree
+		TArray<USKGAttachmentComponent*> AllAttachmentComponents = AttachmentComponents;
+		for (const USKGAttachmentComponent* AttachmentComponent : AttachmentComponents)
+		{
+			if (IsValid(AttachmentComponent))
+			{
+				SKGAttachmentCache::GatherChildAttachmentComponents(AttachmentComponent, AllAttachmentComponents);
+			}
+		}
+		UninitializedAttachmentsOfClass.Reset();
+		for (const USKGAttachmentComponent* AttachmentComponent : AllAttachmentComponents)
+		{
+			AActor* Attachment = IsValid(AttachmentComponent) ? SKGAttachmentCache::GetCacheableAttachment(AttachmentComponent) : nullptr;
+			if (Attachment && Attachment->IsA(Type))
+			{
+				UninitializedAttachmentsOfClass.Add(Attachment);
+			}
+		}
+		return UninitializedAttachmentsOfClass;
+	}
+	
+	const TArray<AActor*>* Attachments = AttachmentClassIndex.Find(Type);
+	return Attachments ? *Attachments : EmptyAttachments;
+}
+
+void USKGAttachmentManager::AddAttachmentToClassIndex(AActor* Attachment)
+{
+	for (const UClass* Class = Attachment->GetClass(); Class && Class != AActor::StaticClass()->GetSuperClass(); Class = Class->GetSuperClass())
+	{
+		AttachmentClassIndex.FindOrAdd(Class).Add(Attachment);
+	}
+}
+
+void USKGAttachmentManager::RemoveAttachmentFromClassIndex(AActor* Attachment)
+{
+	for (const UClass* Class = Attachment->GetClass(); Class && Class != AActor::StaticClass()->GetSuperClass(); Class = Class->GetSuperClass())
+	{
+		if (TArray<AActor*>* Attachments = AttachmentClassIndex.Find(Class))
+		{
+			Attachments->RemoveSingle(Attachment);
+		}
+	}
+}
+
 FString USKGAttachmentManager::SerializeAttachments(FString& Error) const
 {
 	return USKGAttachmentFunctionLibrary::SerializeAttachmentParent(GetOwner(), Error);
 }
 
+void USKGAttachmentManager::InvalidateAttachmentMeshMerge()
+{
+	UnmergeAttachmentMeshes();
+	if (bMergeAttachmentMeshes && GetWorld() && GetNetMode() != NM_DedicatedServer)
+	{
+		GetWorld()->GetTimerManager().SetTimer(TMeshMergeTimerHandle, this, &USKGAttachmentManager::MergeAttachmentMeshes, FMath::Max(AttachmentMeshMergeDelay, 0.01f), false);
+	}
+}
+
+void USKGAttachmentManager::UnmergeAttachmentMeshes()
+{
+	++MeshMergeSerial;
+	for (int32 i = 0; i < MergedSourceMeshComponents.Num(); ++i)
+	{
+		if (IsValid(MergedSourceMeshComponents[i]))
+		{
+			MergedSourceMeshComponents[i]->SetVisibility(MergedSourceMeshVisibility[i]);
+		}
+	}
+	MergedSourceMeshComponents.Empty();
+	MergedSourceMeshVisibility.Empty();
+	
+	for (UStaticMeshComponent* MergedMeshComponent : MergedMeshComponents)
+	{
+		if (IsValid(MergedMeshComponent))
+		{
+			MergedMeshComponent->DestroyComponent();
+		}
+	}
+	MergedMeshComponents.Empty();
+}
+
+bool USKGAttachmentManager::ShouldMergeAttachmentMeshes() const
+{
+	if (!bMergeAttachmentMeshes || GetNetMode() == NM_DedicatedServer)
+	{
+		return false;
+	}
+	if (!bMergeWhenLocallyControlled)
+	{
+		for (const AActor* Actor = GetOwner(); Actor; Actor = Actor->GetOwner())
+		{
+			if (const APawn* Pawn = Cast<APawn>(Actor))
+			{
+				return !Pawn->IsLocallyControlled();
+			}
+		}
+	}
+	return true;
+}
+
+bool USKGAttachmentManager::GetMergeBone(const UStaticMeshComponent* StaticMeshComponent, const UMeshComponent* RootMesh, FName& OutBone) const
+{
+	// Parts are grouped by the root bone they follow so animated bones (magazine, charging handle) keep working
+	const USceneComponent* Child = StaticMeshComponent;
+	for (const USceneComponent* Parent = Child->GetAttachParent(); Parent; Parent = Parent->GetAttachParent())
+	{
+		if (Parent == RootMesh)
+		{
+			const USkinnedMeshComponent* SkinnedRootMesh = Cast<USkinnedMeshComponent>(RootMesh);
+			OutBone = SkinnedRootMesh ? SkinnedRootMesh->GetSocketBoneName(Child->GetAttachSocketName()) : NAME_None;
+			return true;
+		}
+		// Following the bones of a skeletal part, cannot be baked into a static mesh
+		if (Parent->IsA<USkinnedMeshComponent>() && Child->GetAttachSocketName() != NAME_None)
+		{
+			return false;
+		}
+		Child = Parent;
+	}
+	return false;
+}
+
+void USKGAttachmentManager::MergeAttachmentMeshes()
+{
+	SCOPE_CYCLE_COUNTER(STAT_SKGMergeAttachmentMeshes);
+	UnmergeAttachmentMeshes();
+	
+	AActor* OwningActor = GetOwner();
+	if (!ShouldMergeAttachmentMeshes() || !OwningActor || !OwningActor->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
+	{
+		return;
+	}
+	UMeshComponent* RootMesh = ISKGAttachmentInterface::Execute_GetMesh(OwningActor);
+	if (!IsValid(RootMesh))
+	{
+		return;
+	}
+
+	USKGAttachmentMeshMergeWorldSubsystem* MeshMergeSubsystem = GetWorld()->GetSubsystem<USKGAttachmentMeshMergeWorldSubsystem>();
+	TMap<FName, TArray<UStaticMeshComponent*>> BoneGroups;
+	for (const USKGAttachmentComponent* AttachmentComponent : CachedAttachmentComponents)
+	{
+		const AActor* Attachment = IsValid(AttachmentComponent) ? AttachmentComponent->GetAttachment() : nullptr;
+		if (IsValid(Attachment) && !Attachment->IsHidden())
+		{
+			TInlineComponentArray<UStaticMeshComponent*> StaticMeshComponents(Attachment);
+			for (UStaticMeshComponent* StaticMeshComponent : StaticMeshComponents)
+			{
+				FName Bone;
+				// Hidden parts stay out so unmerging never has to guess what should be shown
+				if (!StaticMeshComponent->GetVisibleFlag() || !GetMergeBone(StaticMeshComponent, RootMesh, Bone))
+				{
+					continue;
+				}
+				if (USKGAttachmentFunctionLibrary::CanMergeStaticMeshComponent(StaticMeshComponent))
+				{
+					BoneGroups.FindOrAdd(Bone).Add(StaticMeshComponent);
+				}
+				else if (MeshMergeSubsystem)
+				{
+					MeshMergeSubsystem->ReportNonCPUAccessibleMesh(StaticMeshComponent);
+				}
+			}
+		}
+	}
+
+	for (const TPair<FName, TArray<UStaticMeshComponent*>>& BoneGroup : BoneGroups)
+	{
+		// Nothing is saved by merging a single mesh
+		if (BoneGroup.Value.Num() < 2)
+		{
+			continue;
+		}
+		
+		// The parts stay as they are until the merged mesh is ready
+		const TArray<TWeakObjectPtr<UStaticMeshComponent>> SourceMeshComponents(BoneGroup.Value);
+		USKGAttachmentFunctionLibrary::CreateMergedStaticMeshAsync(RootMesh->GetSocketTransform(BoneGroup.Key), BoneGroup.Value,
+			FSKGOnMergedStaticMeshCreated::CreateUObject(this, &USKGAttachmentManager::OnMergedStaticMeshCreated, MeshMergeSerial, BoneGroup.Key, SourceMeshComponents));
+	}
+}
+
+void USKGAttachmentManager::OnMergedStaticMeshCreated(UStaticMesh* MergedMesh, uint32 MergeSerial, FName Bone, TArray<TWeakObjectPtr<UStaticMeshComponent>> SourceMeshComponents)
+{
+	AActor* OwningActor = GetOwner();
+	if (!MergedMesh || MergeSerial != MeshMergeSerial || !OwningActor || !ShouldMergeAttachmentMeshes())
+	{
+		return;
+	}
+	UMeshComponent* RootMesh = ISKGAttachmentInterface::Execute_GetMesh(OwningActor);
+	if (!IsValid(RootMesh))
+	{
+		return;
+	}
+	for (const TWeakObjectPtr<UStaticMeshComponent>& SourceMeshComponent : SourceMeshComponents)
+	{
+		if (!SourceMeshComponent.IsValid())
+		{
+			return;
+		}
+	}
+
+	UStaticMeshComponent* MergedMeshComponent = NewObject<UStaticMeshComponent>(OwningActor, NAME_None, RF_Transient);
+	MergedMeshComponent->SetStaticMesh(MergedMesh);
+	MergedMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	MergedMeshComponent->SetupAttachment(RootMesh, Bone);
+	MergedMeshComponent->RegisterComponent();
+	MergedMeshComponents.Add(MergedMeshComponent);
+
+	for (const TWeakObjectPtr<UStaticMeshComponent>& SourceMeshComponent : SourceMeshComponents)
+	{
+		MergedSourceMeshComponents.Add(SourceMeshComponent.Get());
+		MergedSourceMeshVisibility.Add(SourceMeshComponent->GetVisibleFlag());
+		SourceMeshComponent->SetVisibility(false);
+	}
+	INC_DWORD_STAT_BY(STAT_SKGMergedAttachmentMeshComponents, SourceMeshComponents.Num());
+}
+
+void USKGAttachmentManager::RebuildAttachmentBroadphase()
+{
+	bAttachmentBroadphaseDirty = false;
+
+	TArray<FSKGAttachmentBoundsProxy> OldProxies = MoveTemp(AttachmentBoundsProxies);
+	const TMap<const AActor*, int32> OldProxyIndices = MoveTemp(AttachmentBoundsProxyIndices);
+	AttachmentBoundsProxies.Reset(CachedComponentAttachments.Num());
+	FBox TotalBounds(ForceInit);
+	for (const TPair<USKGAttachmentComponent*, AActor*>& CachedAttachment : CachedComponentAttachments)
+	{
+		ASKGAttachmentActor* AttachmentActor = Cast<ASKGAttachmentActor>(CachedAttachment.Value);
+		if (IsValid(AttachmentActor) && AttachmentActor->GetOverlapCheckComponent())
+		{
+			FSKGAttachmentBoundsProxy& Proxy = AttachmentBoundsProxies.AddDefaulted_GetRef();
+			Proxy.Attachment = AttachmentActor;
+			if (UpdateAttachmentBounds(Proxy))
+			{
+				TotalBounds += Proxy.Bounds;
+			}
+
+			// Keep the overlap state of attachments that were already in the broadphase
+			const int32* OldIndex = OldProxyIndices.Find(AttachmentActor);
+			if (OldIndex && OldProxies.IsValidIndex(*OldIndex))
+			{
+				Proxy.OverlappingAttachments = MoveTemp(OldProxies[*OldIndex].OverlappingAttachments);
+			}
+		}
+	}
+
+	// Sweep along the longest axis of the build, for a firearm that is down the barrel
+	const FVector Extent = TotalBounds.IsValid ? TotalBounds.GetExtent() : FVector::ZeroVector;
+	BroadphaseAxis = Extent.X >= Extent.Y ? (Extent.X >= Extent.Z ? 0 : 2) : (Extent.Y >= Extent.Z ? 1 : 2);
+	SortAttachmentBroadphase();
+}
+
+void USKGAttachmentManager::SortAttachmentBroadphase()
+{
+	const int32 Axis = BroadphaseAxis;
+	AttachmentBoundsProxies.Sort([Axis](const FSKGAttachmentBoundsProxy& A, const FSKGAttachmentBoundsProxy& B)
+	{
+		return A.Bounds.Min[Axis] < B.Bounds.Min[Axis];
+	});
+
+	AttachmentBoundsProxyIndices.Reset();
+	BroadphaseMaxAxisSize = 0.0;
+	for (int32 i = 0; i < AttachmentBoundsProxies.Num(); ++i)
+	{
+		const FSKGAttachmentBoundsProxy& Proxy = AttachmentBoundsProxies[i];
+		AttachmentBoundsProxyIndices.Add(Proxy.Attachment.Get(), i);
+		if (Proxy.Bounds.IsValid)
+		{
+			BroadphaseMaxAxisSize = FMath::Max(BroadphaseMaxAxisSize, Proxy.Bounds.Max[Axis] - Proxy.Bounds.Min[Axis]);
+		}
+	}
+}
+
+void USKGAttachmentManager::ReinsertAttachmentBoundsProxies(TConstArrayView<ASKGAttachmentActor*> MovedAttachments)
+{
+	TArray<int32, TInlineAllocator<8>> MovedIndices;
+	for (const ASKGAttachmentActor* AttachmentActor : MovedAttachments)
+	{
+		if (const int32* Index = AttachmentBoundsProxyIndices.Find(AttachmentActor))
+		{
+			MovedIndices.AddUnique(*Index);
+		}
+	}
+	if (MovedIndices.IsEmpty())
+	{
+		return;
+	}
+
+	// Back to front so the indices still to be removed stay put
+	MovedIndices.Sort(TGreater<int32>());
+	int32 FirstShiftedIndex = MovedIndices.Last();
+	int32 LastShiftedIndex = MovedIndices[0];
+	TArray<FSKGAttachmentBoundsProxy, TInlineAllocator<8>> MovedProxies;
+	for (const int32 Index : MovedIndices)
+	{
+		FSKGAttachmentBoundsProxy& Proxy = MovedProxies.Add_GetRef(MoveTemp(AttachmentBoundsProxies[Index]));
+		AttachmentBoundsProxies.RemoveAt(Index, 1, false);
+		UpdateAttachmentBounds(Proxy);
+	}
+
+	const int32 Axis = BroadphaseAxis;
+	for (int32 i = 0; i < MovedProxies.Num(); ++i)
+	{
+		FSKGAttachmentBoundsProxy& Proxy = MovedProxies[i];
+		if (Proxy.Bounds.IsValid)
+		{
+			// Only ever grows between rebuilds, a stale larger value just starts the sweep a little earlier
+			BroadphaseMaxAxisSize = FMath::Max(BroadphaseMaxAxisSize, Proxy.Bounds.Max[Axis] - Proxy.Bounds.Min[Axis]);
+		}
+		const int32 InsertIndex = Algo::LowerBoundBy(AttachmentBoundsProxies, Proxy.Bounds.Min[Axis], [Axis](const FSKGAttachmentBoundsProxy& OtherProxy) { return OtherProxy.Bounds.Min[Axis]; });
+		AttachmentBoundsProxies.Insert(MoveTemp(Proxy), InsertIndex);
+		FirstShiftedIndex = FMath::Min(FirstShiftedIndex, InsertIndex);
+		// Every later insert can push this one back by one
+		LastShiftedIndex = FMath::Max(LastShiftedIndex, InsertIndex + MovedProxies.Num() - 1 - i);
+	}
+
+	// Proxies outside the shifted range had as many removed before them as were inserted
+	LastShiftedIndex = FMath::Min(LastShiftedIndex, AttachmentBoundsProxies.Num() - 1);
+	for (int32 i = FirstShiftedIndex; i <= LastShiftedIndex; ++i)
+	{
+		AttachmentBoundsProxyIndices.Add(AttachmentBoundsProxies[i].Attachment.Get(), i);
+	}
+}
+
+FSKGAttachmentBoundsProxy* USKGAttachmentManager::FindAttachmentBoundsProxy(const AActor* Attachment)
+{
+	const int32* Index = AttachmentBoundsProxyIndices.Find(Attachment);
+	return Index && AttachmentBoundsProxies.IsValidIndex(*Index) ? &AttachmentBoundsProxies[*Index] : nullptr;
+}
+
+bool USKGAttachmentManager::UpdateAttachmentBounds(FSKGAttachmentBoundsProxy& Proxy) const
+{
+	const ASKGAttachmentActor* AttachmentActor = Proxy.Attachment.Get();
+	const UShapeComponent* OverlapComponent = AttachmentActor ? AttachmentActor->GetOverlapCheckComponent() : nullptr;
+	if (!OverlapComponent || !GetOwner())
+	{
+		Proxy.Bounds = FBox(ForceInit);
+		return false;
+	}
+
+	// Owner space so the broadphase stays valid while the firearm itself moves
+	Proxy.Bounds = OverlapComponent->Bounds.GetBox().InverseTransformBy(GetOwner()->GetActorTransform());
+	return true;
+}
+
+void USKGAttachmentManager::SetAttachmentsOverlapping(FSKGAttachmentBoundsProxy& Proxy, ASKGAttachmentActor* OtherAttachment, bool bOverlapping)
+{
+	ASKGAttachmentActor* AttachmentActor = Proxy.Attachment.Get();
+	FSKGAttachmentBoundsProxy* OtherProxy = FindAttachmentBoundsProxy(OtherAttachment);
+	if (bOverlapping)
+	{
+		Proxy.OverlappingAttachments.AddUnique(OtherAttachment);
+		if (OtherProxy)
+		{
+			OtherProxy->OverlappingAttachments.AddUnique(AttachmentActor);
+		}
+	}
+	else
+	{
+		Proxy.OverlappingAttachments.Remove(OtherAttachment);
+		if (OtherProxy)
+		{
+			OtherProxy->OverlappingAttachments.Remove(AttachmentActor);
+		}
+	}
+
+	// Both sides get notified, same as when both overlap shapes generate overlap events
+	AttachmentActor->HandleAttachmentOverlap(OtherAttachment, bOverlapping);
+	OtherAttachment->HandleAttachmentOverlap(AttachmentActor, bOverlapping);
+}
+
+void USKGAttachmentManager::ResolveAttachmentOverlaps(ASKGAttachmentActor* MovedAttachment)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SKGResolveAttachmentOverlaps);
+	if (!IsValid(MovedAttachment))
+	{
+		return;
+	}
+	if (bAttachmentBroadphaseDirty)
+	{
+		RebuildAttachmentBroadphase();
+	}
+
+	// Everything attached to the moved attachment moved with it
+	TArray<ASKGAttachmentActor*, TInlineAllocator<8>> MovedAttachments;
+	MovedAttachments.Add(MovedAttachment);
+	for (const USKGAttachmentComponent* AttachmentComponent : ISKGAttachmentInterface::Execute_GetAllAttachmentComponents(MovedAttachment, false))
+	{
+		if (AttachmentComponent)
+		{
+			if (ASKGAttachmentActor* AttachmentActor = Cast<ASKGAttachmentActor>(AttachmentComponent->GetAttachment()))
+			{
+				MovedAttachments.Add(AttachmentActor);
+			}
+		}
+	}
+	ReinsertAttachmentBoundsProxies(MovedAttachments);
+
+	TArray<ASKGAttachmentActor*, TInlineAllocator<8>> Neighbours;
+	for (ASKGAttachmentActor* AttachmentActor : MovedAttachments)
+	{
+		FSKGAttachmentBoundsProxy* Proxy = FindAttachmentBoundsProxy(AttachmentActor);
+		UShapeComponent* OverlapComponent = AttachmentActor->GetOverlapCheckComponent();
+		if (!Proxy || !OverlapComponent || !AttachmentActor->IsResolvingOverlaps())
+		{
+			continue;
+		}
+
+		Neighbours.Reset();
+		if (Proxy->Bounds.IsValid)
+		{
+			// Nothing that starts more than the largest proxy size before this one can reach it
+			const int32 Axis = BroadphaseAxis;
+			const double SweepStart = Proxy->Bounds.Min[Axis] - BroadphaseMaxAxisSize;
+			const int32 StartIndex = Algo::LowerBoundBy(AttachmentBoundsProxies, SweepStart, [Axis](const FSKGAttachmentBoundsProxy& OtherProxy) { return OtherProxy.Bounds.Min[Axis]; });
+			for (int32 i = StartIndex; i < AttachmentBoundsProxies.Num(); ++i)
+			{
+				const FSKGAttachmentBoundsProxy& OtherProxy = AttachmentBoundsProxies[i];
+				if (OtherProxy.Bounds.Min[Axis] > Proxy->Bounds.Max[Axis])
+				{
+					break;
+				}
+				
+				ASKGAttachmentActor* OtherAttachment = OtherProxy.Attachment.Get();
+				if (OtherAttachment && OtherAttachment != AttachmentActor && OtherAttachment->IsResolvingOverlaps() && OtherProxy.Bounds.IsValid && OtherProxy.Bounds.Intersect(Proxy->Bounds))
+				{
+					INC_DWORD_STAT(STAT_SKGAttachmentOverlapTests);
+					if (OverlapComponent->ComponentOverlapComponent(OtherAttachment->GetOverlapCheckComponent(), OverlapComponent->GetComponentLocation(), OverlapComponent->GetComponentQuat(), FCollisionQueryParams::DefaultQueryParam))
+					{
+						Neighbours.Add(OtherAttachment);
+					}
+				}
+			}
+		}
+
+		const TArray<TWeakObjectPtr<ASKGAttachmentActor>> PreviousOverlaps = Proxy->OverlappingAttachments;
+		for (const TWeakObjectPtr<ASKGAttachmentActor>& PreviousOverlap : PreviousOverlaps)
+		{
+			if (!PreviousOverlap.IsValid())
+			{
+				Proxy->OverlappingAttachments.Remove(PreviousOverlap);
+			}
+			else if (!Neighbours.Contains(PreviousOverlap.Get()))
+			{
+				SetAttachmentsOverlapping(*Proxy, PreviousOverlap.Get(), false);
+			}
+		}
+		for (ASKGAttachmentActor* Neighbour : Neighbours)
+		{
+			if (!Proxy->OverlappingAttachments.Contains(Neighbour))
+			{
+				SetAttachmentsOverlapping(*Proxy, Neighbour, true);
+			}
+		}
+	}
+}
+
+void USKGAttachmentManager::ClearAttachmentOverlaps(ASKGAttachmentActor* Attachment)
+{
+	if (FSKGAttachmentBoundsProxy* Proxy = FindAttachmentBoundsProxy(Attachment))
+	{
+		const TArray<TWeakObjectPtr<ASKGAttachmentActor>> PreviousOverlaps = Proxy->OverlappingAttachments;
+		for (const TWeakObjectPtr<ASKGAttachmentActor>& PreviousOverlap : PreviousOverlaps)
+		{
+			if (PreviousOverlap.IsValid())
+			{
+				SetAttachmentsOverlapping(*Proxy, PreviousOverlap.Get(), false);
+			}
+		}
+		Proxy->OverlappingAttachments.Reset();
+	}
+}
+
 template <typename Type>
 TArray<Type*> USKGAttachmentManager::GetAttachmentsOfType()
 {
 	TArray<Type*> Attachments;
-	
-	for (const USKGAttachmentComponent* Component : AttachmentComponents)
+	if constexpr (TIsIInterface<Type>::Value)
 	{
-		if (Component)
+		// The component map has no useful order, walk the cache instead
+		for (USKGAttachmentComponent* AttachmentComponent : CachedAttachmentComponents)
 		{
-			if (Type* Casted = Component->GetAttachment<Type>())
+			if (Type* Casted = Cast<Type>(CachedComponentAttachments.FindRef(AttachmentComponent)))
 			{
 				Attachments.Add(Casted);
 			}
 		}
 	}
-
+	else
+	{
+		const TArray<AActor*>& ClassAttachments = GetAttachmentsOfClass(Type::StaticClass());
+		Attachments.Reserve(ClassAttachments.Num());
+		for (AActor* Attachment : ClassAttachments)
+		{
+			Attachments.Add(CastChecked<Type>(Attachment));
+		}
+	}
 	return Attachments;
 }
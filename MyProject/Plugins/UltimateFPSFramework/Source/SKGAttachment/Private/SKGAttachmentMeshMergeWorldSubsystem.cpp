@@ -0,0 +1,238 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+
+#include "SKGAttachmentMeshMergeWorldSubsystem.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+#include "StaticMeshAttributes.h"
+#include "MeshDescriptionBuilder.h"
+#include "Materials/MaterialInterface.h"
+#include "Async/Async.h"
+
+DECLARE_CYCLE_STAT(TEXT("CreateMergedStaticMesh"), STAT_SKGCreateMergedStaticMesh, STATGROUP_SKGAttachment);
+DECLARE_CYCLE_STAT(TEXT("BuildMergedMeshDescription"), STAT_SKGBuildMergedMeshDescription, STATGROUP_SKGAttachment);
+DECLARE_DWORD_COUNTER_STAT(TEXT("MergedStaticMeshesBuilt"), STAT_SKGMergedStaticMeshesBuilt, STATGROUP_SKGAttachment);
+DECLARE_DWORD_COUNTER_STAT(TEXT("MergedStaticMeshesReused"), STAT_SKGMergedStaticMeshesReused, STATGROUP_SKGAttachment);
+
+namespace SKGAttachmentMeshMerge
+{
+	FSignature GetSignature(const FTransform& RelativeTo, const TArray<UStaticMeshComponent*>& StaticMeshComponents)
+	{
+		FSignature Signature;
+		Signature.Parts.Reserve(StaticMeshComponents.Num());
+		for (const UStaticMeshComponent* Component : StaticMeshComponents)
+		{
+			FPart& Part = Signature.Parts.AddDefaulted_GetRef();
+			Part.StaticMesh = FObjectKey(Component->GetStaticMesh());
+			Signature.Hash = HashCombine(Signature.Hash, GetTypeHash(Part.StaticMesh));
+			for (int32 i = 0; i < Component->GetNumMaterials(); ++i)
+			{
+				Part.Materials.Add(FObjectKey(Component->GetMaterial(i)));
+				Signature.Hash = HashCombine(Signature.Hash, GetTypeHash(Part.Materials.Last()));
+			}
+			const FTransform MeshTransform = Component->GetComponentTransform().GetRelativeTransform(RelativeTo);
+			Part.Location = FIntVector(MeshTransform.GetLocation() * 100.0f);
+			Part.Rotation = FIntVector(MeshTransform.Rotator().Euler() * 100.0f);
+			Part.Scale = FIntVector(MeshTransform.GetScale3D() * 100.0f);
+			Signature.Hash = HashCombine(Signature.Hash, HashCombine(GetTypeHash(Part.Location), HashCombine(GetTypeHash(Part.Rotation), GetTypeHash(Part.Scale))));
+		}
+		return Signature;
+	}
+
+	// Worker thread, only reads the CPU copy of the source render data
+	void BuildMeshDescription(FPendingMerge& PendingMerge)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SKGBuildMergedMeshDescription);
+		FStaticMeshAttributes Attributes(PendingMerge.MeshDescription);
+		Attributes.Register();
+		
+		FMeshDescriptionBuilder MeshBuilder;
+		MeshBuilder.SetMeshDescription(&PendingMerge.MeshDescription);
+		MeshBuilder.EnablePolyGroups();
+		MeshBuilder.SetNumUVLayers(1);
+
+		TMap<UMaterialInterface*, FPolygonGroupID> MaterialGroups;
+		TArray<FVertexInstanceID> VertexInstances;
+		TArray<uint32> Indices;
+		for (const FSource& Source : PendingMerge.Sources)
+		{
+			const FStaticMeshLODResources& LODResource = Source.StaticMesh->GetRenderData()->LODResources[0];
+			const FPositionVertexBuffer& PositionBuffer = LODResource.VertexBuffers.PositionVertexBuffer;
+			const FStaticMeshVertexBuffer& VertexBuffer = LODResource.VertexBuffers.StaticMeshVertexBuffer;
+			const FTransform& MeshTransform = Source.MeshTransform;
+			const bool bFlipWinding = MeshTransform.GetDeterminant() < 0.0f;
+			const bool bHasUVs = VertexBuffer.GetNumTexCoords() > 0;
+
+			VertexInstances.Reset(PositionBuffer.GetNumVertices());
+			for (uint32 i = 0; i < PositionBuffer.GetNumVertices(); ++i)
+			{
+				const FVertexID VertexID = MeshBuilder.AppendVertex(MeshTransform.TransformPosition(FVector(PositionBuffer.VertexPosition(i))));
+				const FVertexInstanceID InstanceID = MeshBuilder.AppendInstance(VertexID);
+				const FVector4f TangentZ = VertexBuffer.VertexTangentZ(i);
+				const FVector Normal = MeshTransform.TransformVectorNoScale(FVector(TangentZ));
+				const FVector Tangent = MeshTransform.TransformVectorNoScale(FVector(VertexBuffer.VertexTangentX(i)));
+				MeshBuilder.SetInstanceTangentSpace(InstanceID, Normal, Tangent, TangentZ.W < 0.0f);
+				if (bHasUVs)
+				{
+					MeshBuilder.SetInstanceUV(InstanceID, FVector2D(VertexBuffer.GetVertexUV(i, 0)), 0);
+				}
+				VertexInstances.Add(InstanceID);
+			}
+
+			LODResource.IndexBuffer.GetCopy(Indices);
+			for (const FStaticMeshSection& Section : LODResource.Sections)
+			{
+				UMaterialInterface* Material = Source.Materials.IsValidIndex(Section.MaterialIndex) ? Source.Materials[Section.MaterialIndex] : nullptr;
+				FPolygonGroupID GroupID;
+				if (const FPolygonGroupID* FoundGroupID = MaterialGroups.Find(Material))
+				{
+					GroupID = *FoundGroupID;
+				}
+				else
+				{
+					GroupID = MeshBuilder.AppendPolygonGroup();
+					Attributes.GetPolygonGroupMaterialSlotNames()[GroupID] = FName(TEXT("MergedMaterial"), MaterialGroups.Num());
+					PendingMerge.GroupMaterials.Add(Material);
+					MaterialGroups.Add(Material, GroupID);
+				}
+				
+				for (uint32 Triangle = 0; Triangle < Section.NumTriangles; ++Triangle)
+				{
+					const uint32 Index = Section.FirstIndex + Triangle * 3;
+					const FVertexInstanceID V0 = VertexInstances[Indices[Index]];
+					const FVertexInstanceID V1 = VertexInstances[Indices[Index + 1]];
+					const FVertexInstanceID V2 = VertexInstances[Indices[Index + 2]];
+					if (bFlipWinding)
+					{
+						MeshBuilder.AppendTriangle(V0, V2, V1, GroupID);
+					}
+					else
+					{
+						MeshBuilder.AppendTriangle(V0, V1, V2, GroupID);
+					}
+				}
+			}
+		}
+	}
+}
+
+void USKGAttachmentMeshMergeWorldSubsystem::Deinitialize()
+{
+	// Builds still on a worker find nothing to finish and their callbacks are dropped
+	PendingMerges.Empty();
+	MergedStaticMeshes.Empty();
+	ReportedNonCPUAccessibleMeshes.Empty();
+	Super::Deinitialize();
+}
+
+void USKGAttachmentMeshMergeWorldSubsystem::CreateMergedStaticMeshAsync(const FTransform& RelativeTo, const TArray<UStaticMeshComponent*>& StaticMeshComponents, FSKGOnMergedStaticMeshCreated OnCreated)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SKGCreateMergedStaticMesh);
+	if (!StaticMeshComponents.Num())
+	{
+		OnCreated.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	SKGAttachmentMeshMerge::FSignature Signature = SKGAttachmentMeshMerge::GetSignature(RelativeTo, StaticMeshComponents);
+	if (const TWeakObjectPtr<UStaticMesh>* CachedMesh = MergedStaticMeshes.Find(Signature))
+	{
+		if (CachedMesh->IsValid())
+		{
+			INC_DWORD_STAT(STAT_SKGMergedStaticMeshesReused);
+			OnCreated.ExecuteIfBound(CachedMesh->Get());
+			return;
+		}
+	}
+	if (const TSharedPtr<SKGAttachmentMeshMerge::FPendingMerge>* PendingMerge = PendingMerges.Find(Signature))
+	{
+		INC_DWORD_STAT(STAT_SKGMergedStaticMeshesReused);
+		(*PendingMerge)->Callbacks.Add(MoveTemp(OnCreated));
+		return;
+	}
+	INC_DWORD_STAT(STAT_SKGMergedStaticMeshesBuilt);
+
+	TSharedPtr<SKGAttachmentMeshMerge::FPendingMerge> PendingMerge = MakeShared<SKGAttachmentMeshMerge::FPendingMerge>();
+	PendingMerge->Callbacks.Add(MoveTemp(OnCreated));
+	PendingMerge->Sources.Reserve(StaticMeshComponents.Num());
+	for (const UStaticMeshComponent* Component : StaticMeshComponents)
+	{
+		SKGAttachmentMeshMerge::FSource& Source = PendingMerge->Sources.AddDefaulted_GetRef();
+		Source.StaticMesh = Component->GetStaticMesh();
+		Source.MeshTransform = Component->GetComponentTransform().GetRelativeTransform(RelativeTo);
+		for (int32 i = 0; i < Component->GetNumMaterials(); ++i)
+		{
+			Source.Materials.Add(Component->GetMaterial(i));
+		}
+	}
+	PendingMerges.Add(Signature, PendingMerge);
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis = TWeakObjectPtr<USKGAttachmentMeshMergeWorldSubsystem>(this), Signature = MoveTemp(Signature), PendingMerge = MoveTemp(PendingMerge)]() mutable
+	{
+		SKGAttachmentMeshMerge::BuildMeshDescription(*PendingMerge);
+		// Moved along so the last reference (an FGCObject) is always released on the game thread
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Signature = MoveTemp(Signature), PendingMerge = MoveTemp(PendingMerge)]()
+		{
+			if (USKGAttachmentMeshMergeWorldSubsystem* MeshMergeSubsystem = WeakThis.Get())
+			{
+				MeshMergeSubsystem->FinishMerge(Signature, PendingMerge);
+			}
+		});
+	});
+}
+
+void USKGAttachmentMeshMergeWorldSubsystem::FinishMerge(const SKGAttachmentMeshMerge::FSignature& Signature, const TSharedPtr<SKGAttachmentMeshMerge::FPendingMerge>& PendingMerge)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SKGCreateMergedStaticMesh);
+	// Gone when the world was torn down while this was building
+	const TSharedPtr<SKGAttachmentMeshMerge::FPendingMerge>* CurrentMerge = PendingMerges.Find(Signature);
+	if (!CurrentMerge || *CurrentMerge != PendingMerge)
+	{
+		return;
+	}
+	PendingMerges.Remove(Signature);
+
+	UStaticMesh* MergedMesh = NewObject<UStaticMesh>(GetTransientPackage(), NAME_None, RF_Transient);
+	for (int32 i = 0; i < PendingMerge->GroupMaterials.Num(); ++i)
+	{
+		MergedMesh->GetStaticMaterials().Add(FStaticMaterial(PendingMerge->GroupMaterials[i], FName(TEXT("MergedMaterial"), i)));
+	}
+	UStaticMesh::FBuildMeshDescriptionsParams BuildParams;
+	BuildParams.bBuildSimpleCollision = false;
+	BuildParams.bFastBuild = true;
+	MergedMesh->BuildFromMeshDescriptions({ &PendingMerge->MeshDescription }, BuildParams);
+
+	// Merged meshes only live as long as the components showing them, drop the entries that outlived theirs
+	for (TMap<SKGAttachmentMeshMerge::FSignature, TWeakObjectPtr<UStaticMesh>>::TIterator It = MergedStaticMeshes.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	MergedStaticMeshes.Add(Signature, MergedMesh);
+
+	for (FSKGOnMergedStaticMeshCreated& Callback : PendingMerge->Callbacks)
+	{
+		Callback.ExecuteIfBound(MergedMesh);
+	}
+}
+
+void USKGAttachmentMeshMergeWorldSubsystem::ReportNonCPUAccessibleMesh(const UStaticMeshComponent* StaticMeshComponent)
+{
+	const UStaticMesh* StaticMesh = StaticMeshComponent ? StaticMeshComponent->GetStaticMesh() : nullptr;
+	if (!StaticMesh || StaticMesh->bAllowCPUAccess)
+	{
+		return;
+	}
+
+	bool bAlreadyReported = false;
+	ReportedNonCPUAccessibleMeshes.Add(FObjectKey(StaticMesh), &bAlreadyReported);
+	if (!bAlreadyReported)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: Static mesh %s on %s is not merged, enable Allow CPUAccess on the mesh so its render data can be read at runtime"),
+			*GetName(), *StaticMesh->GetPathName(), *GetNameSafe(StaticMeshComponent->GetOwner()));
+	}
+}
@@ -0,0 +1,184 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+
+#include "SKGAttachmentPoolWorldSubsystem.h"
+#include "Components/SKGAttachmentComponent.h"
+#include "Interfaces/SKGAttachmentInterface.h"
+#include "Misc/SKGAttachmentDeveloperSettings.h"
+#include "Misc/SKGAttachmentFunctionLibrary.h"
+
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("PooledAttachmentsSpawned"), STAT_SKGPooledAttachmentsSpawned, STATGROUP_SKGAttachment);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PooledAttachmentsReused"), STAT_SKGPooledAttachmentsReused, STATGROUP_SKGAttachment);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("PooledAttachments"), STAT_SKGPooledAttachments, STATGROUP_SKGAttachment);
+
+void USKGAttachmentPoolWorldSubsystem::Deinitialize()
+{
+	EmptyPool();
+	Super::Deinitialize();
+}
+
+void USKGAttachmentPoolWorldSubsystem::SetAttachmentActive(AActor* Attachment, bool bActive) const
+{
+	const AActor* DefaultAttachment = Attachment->GetClass()->GetDefaultObject<AActor>();
+	Attachment->SetActorHiddenInGame(!bActive);
+	Attachment->SetActorEnableCollision(bActive && DefaultAttachment->GetActorEnableCollision());
+	Attachment->SetActorTickEnabled(bActive && DefaultAttachment->PrimaryActorTick.bStartWithTickEnabled);
+}
+
+void USKGAttachmentPoolWorldSubsystem::SetAttachmentTreeActive(AActor* Attachment, bool bActive) const
+{
+	SetAttachmentActive(Attachment, bActive);
+	if (Attachment->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
+	{
+		for (const USKGAttachmentComponent* AttachmentComponent : ISKGAttachmentInterface::Execute_GetAllAttachmentComponents(Attachment, false))
+		{
+			if (AttachmentComponent && IsValid(AttachmentComponent->GetAttachment()))
+			{
+				SetAttachmentActive(AttachmentComponent->GetAttachment(), bActive);
+			}
+		}
+	}
+}
+
+void USKGAttachmentPoolWorldSubsystem::StripAttachmentTree(AActor* Attachment) const
+{
+	if (Attachment->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
+	{
+		for (USKGAttachmentComponent* AttachmentComponent : ISKGAttachmentInterface::Execute_GetAttachmentComponents(Attachment))
+		{
+			if (AttachmentComponent && IsValid(AttachmentComponent->GetAttachment()))
+			{
+				AActor* ChildAttachment = AttachmentComponent->GetAttachment();
+				AttachmentComponent->ClearCurrentAttachment();
+				DestroyAttachmentTree(ChildAttachment);
+			}
+		}
+	}
+}
+
+void USKGAttachmentPoolWorldSubsystem::DestroyAttachmentTree(AActor* Attachment) const
+{
+	if (Attachment->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
+	{
+		for (const USKGAttachmentComponent* AttachmentComponent : ISKGAttachmentInterface::Execute_GetAllAttachmentComponents(Attachment, true))
+		{
+			if (AttachmentComponent && IsValid(AttachmentComponent->GetAttachment()))
+			{
+				AttachmentComponent->GetAttachment()->Destroy();
+			}
+		}
+	}
+	Attachment->Destroy();
+}
+
+AActor* USKGAttachmentPoolWorldSubsystem::AcquireAttachment(TSubclassOf<AActor> AttachmentClass, AActor* Owner, const FTransform& Transform)
+{
+	if (!AttachmentClass)
+	{
+		return nullptr;
+	}
+	++PoolStats.Acquired;
+	
+	if (FSKGAttachmentPool* Pool = Pools.Find(AttachmentClass))
+	{
+		while (Pool->Attachments.Num())
+		{
+			AActor* Attachment = Pool->Attachments.Pop(false);
+			--PoolStats.Pooled;
+			DEC_DWORD_STAT(STAT_SKGPooledAttachments);
+			if (!IsValid(Attachment))
+			{
+				continue;
+			}
+
+			++PoolStats.Reused;
+			INC_DWORD_STAT(STAT_SKGPooledAttachmentsReused);
+			Attachment->SetOwner(Owner);
+			Attachment->SetActorTransform(Transform);
+			if (Attachment->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
+			{
+				ISKGAttachmentInterface::Execute_SetOffset(Attachment, 0.0f);
+			}
+			SetAttachmentActive(Attachment, true);
+			// Released attachments come back bare, put the default attachments back like a fresh spawn would
+			if (Attachment->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
+			{
+				for (USKGAttachmentComponent* AttachmentComponent : ISKGAttachmentInterface::Execute_GetAttachmentComponents(Attachment))
+				{
+					if (AttachmentComponent)
+					{
+						AttachmentComponent->HandleAttachmentConstruction();
+					}
+				}
+			}
+			return Attachment;
+		}
+	}
+
+	AActor* Attachment = GetWorld()->SpawnActorDeferred<AActor>(AttachmentClass, FTransform(), Owner);
+	if (Attachment)
+	{
+		++PoolStats.Spawned;
+		INC_DWORD_STAT(STAT_SKGPooledAttachmentsSpawned);
+		Attachment->SetReplicates(false);
+		UGameplayStatics::FinishSpawningActor(Attachment, Transform);
+	}
+	return Attachment;
+}
+
+void USKGAttachmentPoolWorldSubsystem::ReleaseAttachment(AActor* Attachment)
+{
+	if (!IsValid(Attachment))
+	{
+		return;
+	}
+	++PoolStats.Released;
+
+	const USKGAttachmentDeveloperSettings* Settings = GetDefault<USKGAttachmentDeveloperSettings>();
+	FSKGAttachmentPool& Pool = Pools.FindOrAdd(Attachment->GetClass());
+	// Replicated attachments have a network identity and can't be handed to another owner
+	if (!Settings->bPoolPreviewAttachments || Attachment->GetIsReplicated() || Pool.Attachments.Num() >= Settings->MaxPooledAttachmentsPerClass)
+	{
+		DestroyAttachmentTree(Attachment);
+		return;
+	}
+
+	Attachment->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	// Whatever was attached while it was in use is not part of the pooled class, only the bare actor is kept
+	StripAttachmentTree(Attachment);
+	SetAttachmentTreeActive(Attachment, false);
+	Attachment->SetOwner(nullptr);
+	Pool.Attachments.Add(Attachment);
+	
+	++PoolStats.Pooled;
+	PoolStats.PeakPooled = FMath::Max(PoolStats.PeakPooled, PoolStats.Pooled);
+	INC_DWORD_STAT(STAT_SKGPooledAttachments);
+}
+
+void USKGAttachmentPoolWorldSubsystem::EmptyPool()
+{
+	for (TPair<UClass*, FSKGAttachmentPool>& Pool : Pools)
+	{
+		for (AActor* Attachment : Pool.Value.Attachments)
+		{
+			if (IsValid(Attachment))
+			{
+				DestroyAttachmentTree(Attachment);
+			}
+		}
+	}
+	Pools.Empty();
+	SET_DWORD_STAT(STAT_SKGPooledAttachments, 0);
+	PoolStats.Pooled = 0;
+}
+
+void USKGAttachmentPoolWorldSubsystem::ResetPoolStats()
+{
+	const int32 Pooled = PoolStats.Pooled;
+	PoolStats = FSKGAttachmentPoolStats();
+	PoolStats.Pooled = Pooled;
+	PoolStats.PeakPooled = Pooled;
+}
@@ -0,0 +1,98 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/SKGAttachmentTestUtils.h"
+
+#include "Algo/Sort.h"
+#include "Components/ShapeComponent.h"
+#include "Math/RandomStream.h"
+
+namespace SKGAttachmentBroadphaseTests
+{
+	// Every resolving attachment against every other one, what the broadphase has to agree with
+	static TArray<ASKGAttachmentActor*> GatherBruteForceOverlaps(const TArray<ASKGAttachmentActor*>& Attachments, const ASKGAttachmentActor* Attachment)
+	{
+		TArray<ASKGAttachmentActor*> Overlaps;
+		UShapeComponent* OverlapComponent = Attachment->GetOverlapCheckComponent();
+		for (ASKGAttachmentActor* OtherAttachment : Attachments)
+		{
+			if (OtherAttachment != Attachment && OtherAttachment->IsResolvingOverlaps() &&
+				OverlapComponent->ComponentOverlapComponent(OtherAttachment->GetOverlapCheckComponent(), OverlapComponent->GetComponentLocation(), OverlapComponent->GetComponentQuat(), FCollisionQueryParams::DefaultQueryParam))
+			{
+				Overlaps.Add(OtherAttachment);
+			}
+		}
+		return Overlaps;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGAttachmentBroadphaseBruteForceTest, "UltimateFPSFramework.AttachmentManager.BroadphaseMatchesBruteForce", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGAttachmentBroadphaseBruteForceTest::RunTest(const FString& Parameters)
+{
+	using namespace SKGAttachmentTests;
+	using namespace SKGAttachmentBroadphaseTests;
+	FScopedTestWorld TestWorld;
+	TArray<USKGAttachmentComponent*> RootComponents;
+	USKGAttachmentManager* AttachmentManager = SpawnAttachmentHost(TestWorld.World, 8, RootComponents);
+	if (!TestTrue(TEXT("Manager uses the broadphase"), AttachmentManager->UsesAttachmentBroadphase()))
+	{
+		return false;
+	}
+
+	// Different sizes along the barrel, every top level attachment carries a child so drags move more than one proxy
+	FRandomStream RandomStream(1234);
+	TArray<ASKGAttachmentActor*> TopLevelAttachments;
+	TArray<ASKGAttachmentActor*> Attachments;
+	for (USKGAttachmentComponent* RootComponent : RootComponents)
+	{
+		ASKGAttachmentActor* Attachment = SpawnAttachment(TestWorld.World, 1, FVector(RandomStream.FRandRange(2.0f, 12.0f), 2.0f, 2.0f));
+		ASKGAttachmentActor* Child = SpawnAttachment(TestWorld.World, 0, FVector(RandomStream.FRandRange(1.0f, 4.0f), 1.0f, 1.0f));
+		RootComponent->AddExistingAttachment(Attachment);
+		GetAttachmentComponents(Attachment)[0]->AddExistingAttachment(Child);
+		Attachment->SetActorRelativeLocation(FVector(RandomStream.FRandRange(-60.0f, 60.0f), 0.0f, 0.0f));
+		Child->SetActorRelativeLocation(FVector(RandomStream.FRandRange(-8.0f, 8.0f), 0.0f, 0.0f));
+		TopLevelAttachments.Add(Attachment);
+		Attachments.Add(Attachment);
+		Attachments.Add(Child);
+	}
+	for (ASKGAttachmentActor* Attachment : Attachments)
+	{
+		if (!TestNotNull(TEXT("Attachment found its overlap shape"), Attachment->GetOverlapCheckComponent()))
+		{
+			return false;
+		}
+		ISKGAttachmentInterface::Execute_EnableGenerateOverlapEvents(Attachment, true);
+	}
+
+	int32 NumOverlapsSeen = 0;
+	auto CheckOverlaps = [&](int32 Step)
+	{
+		TestTrue(FString::Printf(TEXT("Step %d: broadphase is sorted and indexed"), Step), FSKGAttachmentManagerTestAccess::IsBroadphaseConsistent(AttachmentManager));
+		for (const ASKGAttachmentActor* Attachment : Attachments)
+		{
+			TArray<ASKGAttachmentActor*> Expected = GatherBruteForceOverlaps(Attachments, Attachment);
+			TArray<ASKGAttachmentActor*> Actual = FSKGAttachmentManagerTestAccess::GetOverlappingAttachments(AttachmentManager, Attachment);
+			Algo::Sort(Expected);
+			Algo::Sort(Actual);
+			TestEqual(FString::Printf(TEXT("Step %d: %s overlaps match brute force"), Step, *Attachment->GetName()), Actual, Expected);
+			NumOverlapsSeen += Expected.Num();
+		}
+	};
+
+	CheckOverlaps(0);
+	for (int32 Step = 1; Step <= 64; ++Step)
+	{
+		ASKGAttachmentActor* Dragged = TopLevelAttachments[RandomStream.RandHelper(TopLevelAttachments.Num())];
+		Dragged->SetActorRelativeLocation(FVector(RandomStream.FRandRange(-60.0f, 60.0f), 0.0f, 0.0f));
+		AttachmentManager->ResolveAttachmentOverlaps(Dragged);
+		CheckOverlaps(Step);
+	}
+	TestTrue(TEXT("The drags produced overlaps to compare"), NumOverlapsSeen > 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,68 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/SKGAttachmentTestUtils.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGAttachmentCacheIncrementalTest, "UltimateFPSFramework.AttachmentManager.IncrementalCacheMatchesRebuild", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGAttachmentCacheIncrementalTest::RunTest(const FString& Parameters)
+{
+	using namespace SKGAttachmentTests;
+	FScopedTestWorld TestWorld;
+	TArray<USKGAttachmentComponent*> RootComponents;
+	USKGAttachmentManager* AttachmentManager = SpawnAttachmentHost(TestWorld.World, 3, RootComponents);
+
+	auto CheckCache = [&](const TCHAR* Step)
+	{
+		TArray<USKGAttachmentComponent*> ExpectedCache;
+		GatherExpectedCache(RootComponents, ExpectedCache);
+		TestEqual(FString::Printf(TEXT("%s: incremental cache matches the rebuild order"), Step), AttachmentManager->GetCachedAttachmentComponents(), ExpectedCache);
+		TestTrue(FString::Printf(TEXT("%s: cache validates"), Step), AttachmentManager->ValidateAttachmentCache());
+	};
+
+	// Components are filled out of order and at every depth so inserts land in the middle of the levels below the top
+	ASKGAttachmentActor* Handguard = SpawnAttachment(TestWorld.World, 3);
+	ASKGAttachmentActor* Barrel = SpawnAttachment(TestWorld.World, 2);
+	ASKGAttachmentActor* Stock = SpawnAttachment(TestWorld.World, 1);
+	ASKGAttachmentActor* Sight = SpawnAttachment(TestWorld.World, 1);
+	ASKGAttachmentActor* Magnifier = SpawnAttachment(TestWorld.World, 0);
+	ASKGAttachmentActor* Muzzle = SpawnAttachment(TestWorld.World, 1);
+	ASKGAttachmentActor* Suppressor = SpawnAttachment(TestWorld.World, 0);
+	ASKGAttachmentActor* Grip = SpawnAttachment(TestWorld.World, 0);
+
+	RootComponents[1]->AddExistingAttachment(Handguard);
+	CheckCache(TEXT("Handguard"));
+	RootComponents[2]->AddExistingAttachment(Stock);
+	CheckCache(TEXT("Stock"));
+	GetAttachmentComponents(Handguard)[2]->AddExistingAttachment(Sight);
+	CheckCache(TEXT("Sight"));
+	GetAttachmentComponents(Handguard)[0]->AddExistingAttachment(Barrel);
+	CheckCache(TEXT("Barrel"));
+	GetAttachmentComponents(Sight)[0]->AddExistingAttachment(Magnifier);
+	CheckCache(TEXT("Magnifier"));
+	GetAttachmentComponents(Barrel)[1]->AddExistingAttachment(Muzzle);
+	CheckCache(TEXT("Muzzle"));
+	GetAttachmentComponents(Muzzle)[0]->AddExistingAttachment(Suppressor);
+	CheckCache(TEXT("Suppressor"));
+	RootComponents[0]->AddExistingAttachment(Grip);
+	CheckCache(TEXT("Grip"));
+
+	// Removing a branch in the middle and putting it back elsewhere
+	GetAttachmentComponents(Handguard)[0]->ClearCurrentAttachment();
+	CheckCache(TEXT("Barrel removed"));
+	GetAttachmentComponents(Handguard)[1]->AddExistingAttachment(Barrel);
+	CheckCache(TEXT("Barrel moved"));
+	RootComponents[1]->ClearCurrentAttachment();
+	CheckCache(TEXT("Handguard removed"));
+	RootComponents[1]->AddExistingAttachment(Handguard);
+	CheckCache(TEXT("Handguard added back"));
+
+	const TArray<USKGAttachmentComponent*> IncrementalCache = AttachmentManager->GetCachedAttachmentComponents();
+	TestEqual(TEXT("A full rebuild gives the same cache"), AttachmentManager->GetAllAttachmentComponents(true), IncrementalCache);
+	return true;
+}
+
+#endif
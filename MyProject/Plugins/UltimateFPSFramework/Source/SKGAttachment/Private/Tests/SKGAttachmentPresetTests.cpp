@@ -0,0 +1,131 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/SKGAttachmentFunctionLibrary.h"
+#include "SKGAttachmentActor.h"
+
+namespace SKGAttachmentPresetTests
+{
+	// Header is magic, version, flags and uncompressed size, the body starts with the string table count
+	static constexpr int32 BodyOffset = sizeof(uint32) + sizeof(uint16) * 2 + sizeof(int32);
+
+	// Native classes only, they are always loaded so deserializing never has anything left unresolved
+	static FSKGAttachmentParent CreatePreset()
+	{
+		FSKGAttachmentParent Preset;
+		Preset.AttachmentClass = ASKGAttachmentActor::StaticClass();
+		for (int32 i = 0; i < 24; ++i)
+		{
+			FSKGAttachmentAttachList& Entry = Preset.AttachmentList.AddDefaulted_GetRef();
+			Entry.ComponentName = FString::Printf(TEXT("AttachmentComponent_%d"), i % 6);
+			Entry.ComponentNameHash = USKGAttachmentFunctionLibrary::HashComponentName(Entry.ComponentName);
+			Entry.ParentAttachment = i % 2 ? ASKGAttachmentActor::StaticClass() : nullptr;
+			Entry.Attachment = ASKGAttachmentActor::StaticClass();
+			Entry.AttachmentOffset = i * 0.25f;
+		}
+		return Preset;
+	}
+
+	static void WriteInt32(TArray<uint8>& Bytes, int32 Offset, int32 Value)
+	{
+		FMemory::Memcpy(Bytes.GetData() + Offset, &Value, sizeof(Value));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGAttachmentPresetRoundTripTest, "UltimateFPSFramework.AttachmentPreset.RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGAttachmentPresetRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace SKGAttachmentPresetTests;
+	const FSKGAttachmentParent Preset = CreatePreset();
+	for (const bool bCompress : { false, true })
+	{
+		const TArray<uint8> BinaryPreset = USKGAttachmentFunctionLibrary::SerializeAttachmentStructBinary(Preset, bCompress);
+		TArray<FSoftObjectPath> UnresolvedClassPaths;
+		FString Error;
+		const FSKGAttachmentParent ReadPreset = USKGAttachmentFunctionLibrary::DeserializeAttachmentBinaryWithoutLoading(BinaryPreset, UnresolvedClassPaths, Error);
+		const TCHAR* Mode = bCompress ? TEXT("compressed") : TEXT("uncompressed");
+		TestTrue(FString::Printf(TEXT("%s preset reads without error: %s"), Mode, *Error), Error.IsEmpty());
+		TestEqual(FString::Printf(TEXT("%s preset has nothing unresolved"), Mode), UnresolvedClassPaths.Num(), 0);
+		TestTrue(FString::Printf(TEXT("%s preset keeps the attachment class"), Mode), ReadPreset.AttachmentClass == Preset.AttachmentClass);
+		if (!TestEqual(FString::Printf(TEXT("%s preset keeps every entry"), Mode), ReadPreset.AttachmentList.Num(), Preset.AttachmentList.Num()))
+		{
+			continue;
+		}
+		for (int32 i = 0; i < Preset.AttachmentList.Num(); ++i)
+		{
+			const FSKGAttachmentAttachList& Expected = Preset.AttachmentList[i];
+			const FSKGAttachmentAttachList& Actual = ReadPreset.AttachmentList[i];
+			TestEqual(FString::Printf(TEXT("%s entry %d component name"), Mode, i), Actual.ComponentName, Expected.ComponentName);
+			TestEqual(FString::Printf(TEXT("%s entry %d component hash"), Mode, i), Actual.ComponentNameHash, Expected.ComponentNameHash);
+			TestTrue(FString::Printf(TEXT("%s entry %d classes"), Mode, i), Actual.ParentRootActor == Expected.ParentRootActor && Actual.ParentAttachment == Expected.ParentAttachment && Actual.Attachment == Expected.Attachment);
+			TestEqual(FString::Printf(TEXT("%s entry %d offset"), Mode, i), Actual.AttachmentOffset, Expected.AttachmentOffset);
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGAttachmentPresetCorruptInputTest, "UltimateFPSFramework.AttachmentPreset.CorruptInput", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGAttachmentPresetCorruptInputTest::RunTest(const FString& Parameters)
+{
+	using namespace SKGAttachmentPresetTests;
+	const TArray<uint8> BinaryPreset = USKGAttachmentFunctionLibrary::SerializeAttachmentStructBinary(CreatePreset(), false);
+	auto ExpectRejected = [this](const TCHAR* What, const TArray<uint8>& Corrupt)
+	{
+		TArray<FSoftObjectPath> UnresolvedClassPaths;
+		FString Error;
+		const FSKGAttachmentParent ReadPreset = USKGAttachmentFunctionLibrary::DeserializeAttachmentBinaryWithoutLoading(Corrupt, UnresolvedClassPaths, Error);
+		TestFalse(FString::Printf(TEXT("%s is rejected"), What), Error.IsEmpty());
+		TestEqual(FString::Printf(TEXT("%s yields no entries"), What), ReadPreset.AttachmentList.Num(), 0);
+	};
+
+	ExpectRejected(TEXT("Empty data"), TArray<uint8>());
+
+	TArray<uint8> Corrupt = BinaryPreset;
+	Corrupt[0] ^= 0xFF;
+	ExpectRejected(TEXT("Wrong magic"), Corrupt);
+
+	for (const int32 Length : { BodyOffset, BodyOffset + 3, BinaryPreset.Num() / 2, BinaryPreset.Num() - 1 })
+	{
+		ExpectRejected(*FString::Printf(TEXT("Truncated to %d bytes"), Length), TArray<uint8>(BinaryPreset.GetData(), Length));
+	}
+
+	Corrupt = BinaryPreset;
+	Corrupt.Add(0);
+	ExpectRejected(TEXT("Trailing bytes"), Corrupt);
+
+	// Counts far beyond the data must fail before they are allocated
+	Corrupt = BinaryPreset;
+	WriteInt32(Corrupt, BodyOffset, MAX_int32);
+	ExpectRejected(TEXT("Huge string table count"), Corrupt);
+	WriteInt32(Corrupt, BodyOffset, -1);
+	ExpectRejected(TEXT("Negative string table count"), Corrupt);
+
+	Corrupt = BinaryPreset;
+	WriteInt32(Corrupt, BodyOffset + sizeof(int32), MAX_int32);
+	ExpectRejected(TEXT("Huge string length"), Corrupt);
+	WriteInt32(Corrupt, BodyOffset + sizeof(int32), MIN_int32 + 1);
+	ExpectRejected(TEXT("Huge wide string length"), Corrupt);
+
+	// The last entry is the hash followed by four indices and the offset, at the very end of an uncompressed preset
+	Corrupt = BinaryPreset;
+	const int32 LastHashOffset = Corrupt.Num() - static_cast<int32>(sizeof(uint32) + sizeof(int32) * 4 + sizeof(float));
+	Corrupt[LastHashOffset] ^= 0xFF;
+	ExpectRejected(TEXT("Component hash that does not match its name"), Corrupt);
+
+	// A compressed preset claiming more than zlib can expand to
+	TArray<uint8> Compressed = USKGAttachmentFunctionLibrary::SerializeAttachmentStructBinary(CreatePreset(), true);
+	constexpr int32 FlagsOffset = sizeof(uint32) + sizeof(uint16);
+	if (TestTrue(TEXT("The repetitive preset is stored compressed"), (Compressed[FlagsOffset] & 1) != 0))
+	{
+		WriteInt32(Compressed, BodyOffset - sizeof(int32), MAX_int32);
+		ExpectRejected(TEXT("Compressed preset with a huge uncompressed size"), Compressed);
+	}
+	return true;
+}
+
+#endif
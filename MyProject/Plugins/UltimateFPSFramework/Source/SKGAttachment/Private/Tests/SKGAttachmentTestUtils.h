@@ -0,0 +1,152 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SKGAttachmentActor.h"
+#include "Components/SKGAttachmentComponent.h"
+#include "Components/SKGAttachmentManager.h"
+#include "Interfaces/SKGAttachmentInterface.h"
+#include "Misc/SKGAttachmentDeveloperSettings.h"
+
+#include "Components/BoxComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "UObject/UnrealType.h"
+
+struct FSKGAttachmentManagerTestAccess
+{
+	static TArray<ASKGAttachmentActor*> GetOverlappingAttachments(USKGAttachmentManager* AttachmentManager, const ASKGAttachmentActor* Attachment)
+	{
+		TArray<ASKGAttachmentActor*> OverlappingAttachments;
+		if (const FSKGAttachmentBoundsProxy* Proxy = AttachmentManager->FindAttachmentBoundsProxy(Attachment))
+		{
+			for (const TWeakObjectPtr<ASKGAttachmentActor>& OverlappingAttachment : Proxy->OverlappingAttachments)
+			{
+				OverlappingAttachments.Add(OverlappingAttachment.Get());
+			}
+		}
+		return OverlappingAttachments;
+	}
+
+	// Proxies sorted along the sweep axis and every one of them found at its own index
+	static bool IsBroadphaseConsistent(const USKGAttachmentManager* AttachmentManager)
+	{
+		const TArray<FSKGAttachmentBoundsProxy>& Proxies = AttachmentManager->AttachmentBoundsProxies;
+		const int32 Axis = AttachmentManager->BroadphaseAxis;
+		for (int32 i = 0; i < Proxies.Num(); ++i)
+		{
+			const int32* Index = AttachmentManager->AttachmentBoundsProxyIndices.Find(Proxies[i].Attachment.Get());
+			if (!Index || *Index != i || (i > 0 && Proxies[i - 1].Bounds.Min[Axis] > Proxies[i].Bounds.Min[Axis]))
+			{
+				return false;
+			}
+		}
+		return AttachmentManager->AttachmentBoundsProxyIndices.Num() == Proxies.Num();
+	}
+};
+
+// Builds attachment trees in a throwaway game world, nothing here needs an asset
+namespace SKGAttachmentTests
+{
+	struct FScopedTestWorld
+	{
+		UWorld* World;
+
+		FScopedTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+		}
+
+		~FScopedTestWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+	};
+
+	// Compatibility is normally set up in the editor, the tests attach anything anywhere
+	inline USKGAttachmentComponent* CreateAttachmentComponent(AActor* Owner)
+	{
+		USKGAttachmentComponent* AttachmentComponent = NewObject<USKGAttachmentComponent>(Owner);
+		if (const FBoolProperty* AllowAllProperty = FindFProperty<FBoolProperty>(USKGAttachmentComponent::StaticClass(), TEXT("bAllowAllAttachments")))
+		{
+			AllowAllProperty->SetPropertyValue_InContainer(AttachmentComponent, true);
+		}
+		AttachmentComponent->SetupAttachment(Owner->GetRootComponent());
+		return AttachmentComponent;
+	}
+
+	// Plain actor holding the attachment manager and its top level attachment components
+	inline USKGAttachmentManager* SpawnAttachmentHost(UWorld* World, int32 NumAttachmentComponents, TArray<USKGAttachmentComponent*>& OutAttachmentComponents)
+	{
+		AActor* Host = World->SpawnActor<AActor>();
+		USceneComponent* Root = NewObject<USceneComponent>(Host, TEXT("Root"));
+		Host->SetRootComponent(Root);
+		Root->RegisterComponent();
+
+		USKGAttachmentManager* AttachmentManager = NewObject<USKGAttachmentManager>(Host);
+		AttachmentManager->RegisterComponent();
+		for (int32 i = 0; i < NumAttachmentComponents; ++i)
+		{
+			USKGAttachmentComponent* AttachmentComponent = CreateAttachmentComponent(Host);
+			AttachmentComponent->RegisterComponent();
+			AttachmentManager->AddAttachment(AttachmentComponent);
+			OutAttachmentComponents.Add(AttachmentComponent);
+		}
+		// Builds the cache now instead of after the initial delay, every change from here on is incremental
+		AttachmentManager->GetAllAttachmentComponents(true);
+		return AttachmentManager;
+	}
+
+	// Attachment actors pick up their attachment components, mesh and overlap shape when their components initialize
+	inline ASKGAttachmentActor* SpawnAttachment(UWorld* World, int32 NumAttachmentComponents, const FVector& OverlapExtent = FVector::ZeroVector)
+	{
+		ASKGAttachmentActor* Attachment = World->SpawnActorDeferred<ASKGAttachmentActor>(ASKGAttachmentActor::StaticClass(), FTransform::Identity);
+		UStaticMeshComponent* AttachmentMesh = NewObject<UStaticMeshComponent>(Attachment, TEXT("AttachmentMesh"));
+		AttachmentMesh->ComponentTags.Add(GetDefault<USKGAttachmentDeveloperSettings>()->AttachmentMeshTag);
+		Attachment->SetRootComponent(AttachmentMesh);
+		Attachment->AddInstanceComponent(AttachmentMesh);
+		if (!OverlapExtent.IsZero())
+		{
+			UBoxComponent* OverlapBox = NewObject<UBoxComponent>(Attachment, TEXT("OverlapBox"));
+			OverlapBox->ComponentTags.Add(GetDefault<USKGAttachmentDeveloperSettings>()->AttachmentOverlapTag);
+			OverlapBox->SetBoxExtent(OverlapExtent, false);
+			OverlapBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+			OverlapBox->SetupAttachment(AttachmentMesh);
+			Attachment->AddInstanceComponent(OverlapBox);
+		}
+		for (int32 i = 0; i < NumAttachmentComponents; ++i)
+		{
+			Attachment->AddInstanceComponent(CreateAttachmentComponent(Attachment));
+		}
+		Attachment->FinishSpawning(FTransform::Identity);
+		return Attachment;
+	}
+
+	inline TArray<USKGAttachmentComponent*> GetAttachmentComponents(AActor* Attachment)
+	{
+		return ISKGAttachmentInterface::Execute_GetAttachmentComponents(Attachment);
+	}
+
+	// What a full rebuild produces, walked with the public interface only: each level's components first, then the levels below each of them in turn
+	inline void GatherExpectedCache(const TArray<USKGAttachmentComponent*>& AttachmentComponents, TArray<USKGAttachmentComponent*>& OutCache)
+	{
+		OutCache.Append(AttachmentComponents);
+		for (const USKGAttachmentComponent* AttachmentComponent : AttachmentComponents)
+		{
+			if (AActor* Attachment = AttachmentComponent->GetAttachment())
+			{
+				GatherExpectedCache(GetAttachmentComponents(Attachment), OutCache);
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,32 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SKGAttachmentDataTypes.h"
+#include "PDA_AttachmentMetadata.generated.h"
+
+UCLASS()
+class SKGATTACHMENT_API UPDA_AttachmentMetadata : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+public:
+	// Generated when an attachment blueprint compiles, keyed by attachment class
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SKGAttachment|Metadata")
+	TMap<TSoftClassPtr<AActor>, FSKGAttachmentMetadata> Metadata;
+
+	const FSKGAttachmentMetadata* FindMetadata(const TSoftClassPtr<AActor>& AttachmentClass) const { return Metadata.Find(AttachmentClass); }
+
+	// The settings only hold a soft reference, the asset manager cooks the table through this type (see DefaultGame.ini)
+	static const FPrimaryAssetType PrimaryAssetType;
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override { return FPrimaryAssetId(PrimaryAssetType, GetFName()); }
+
+#if WITH_EDITOR
+	// Reads the mesh, sockets and rails from the class defaults and construction script without spawning the attachment
+	static bool BuildMetadata(const UClass* AttachmentClass, FSKGAttachmentMetadata& OutMetadata);
+	// Returns true if the entry for the class was added, changed or removed
+	bool UpdateMetadata(const UClass* AttachmentClass);
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
+};
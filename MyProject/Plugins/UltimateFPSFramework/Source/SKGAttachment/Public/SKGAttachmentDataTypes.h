@@ -5,6 +5,39 @@
 #include "GameFramework/Actor.h"
 #include "SKGAttachmentDataTypes.generated.h"
 
+class USKGAttachmentComponent;
+class UStaticMesh;
+class USkeletalMesh;
+
+UENUM(BlueprintType)
+enum class ESKGAttachmentChangeType : uint8
+{
+	Added		UMETA(DisplayName = "Added"),
+	Removed		UMETA(DisplayName = "Removed")
+};
+
+// A single attachment entering or leaving an attachment managers cache
+USTRUCT(BlueprintType)
+struct FSKGAttachmentChange
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly, Category = "SKGAttachment|AttachmentData")
+	USKGAttachmentComponent* AttachmentComponent = nullptr;
+	// For removals this is the attachment the component previously held
+	UPROPERTY(BlueprintReadOnly, Category = "SKGAttachment|AttachmentData")
+	AActor* Attachment = nullptr;
+	UPROPERTY(BlueprintReadOnly, Category = "SKGAttachment|AttachmentData")
+	ESKGAttachmentChangeType ChangeType = ESKGAttachmentChangeType::Added;
+
+	FSKGAttachmentChange(){}
+	FSKGAttachmentChange(USKGAttachmentComponent* INAttachmentComponent, AActor* INAttachment, ESKGAttachmentChangeType INChangeType)
+	{
+		AttachmentComponent = INAttachmentComponent;
+		Attachment = INAttachment;
+		ChangeType = INChangeType;
+	}
+};
+
 USTRUCT(BlueprintType)
 struct FSKGAttachmentAttachList
 {
@@ -19,6 +52,8 @@ struct FSKGAttachmentAttachList
 	TSubclassOf<AActor> Attachment;
 	UPROPERTY(BlueprintReadWrite, Category = "SKGAttachment|AttachmentData")
 	float AttachmentOffset = 0.0f;
+	// Stable hash of ComponentName, binary presets identify components by this instead of the string
+	uint32 ComponentNameHash = 0;
 	
 	bool bHasBeenCreated = false;
 };
@@ -147,4 +182,47 @@ struct FSKGDataAssetAttachment
 	{
 		return ActorClass == DataAssetAttachment.ActorClass && bEnabledForUse == DataAssetAttachment.bEnabledForUse;
 	}
-};
\ No newline at end of file
+};
+
+// Rail data of an attachment component on an attachment class
+USTRUCT(BlueprintType)
+struct FSKGAttachmentComponentMetadata
+{
+	GENERATED_BODY()
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SKGAttachment|Metadata")
+	FName ComponentName;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SKGAttachment|Metadata")
+	FVector2D MinMaxOffset = FVector2D::ZeroVector;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SKGAttachment|Metadata")
+	float OffsetSnapDistance = 0.0f;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SKGAttachment|Metadata")
+	TArray<float> SnapPoints;
+
+	bool operator == (const FSKGAttachmentComponentMetadata& Other) const
+	{
+		return ComponentName == Other.ComponentName && MinMaxOffset == Other.MinMaxOffset && OffsetSnapDistance == Other.OffsetSnapDistance && SnapPoints == Other.SnapPoints;
+	}
+};
+
+// What tools and UI need to know about an attachment class without loading it
+USTRUCT(BlueprintType)
+struct FSKGAttachmentMetadata
+{
+	GENERATED_BODY()
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SKGAttachment|Metadata")
+	TSoftObjectPtr<UStaticMesh> StaticMesh;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SKGAttachment|Metadata")
+	TSoftObjectPtr<USkeletalMesh> SkeletalMesh;
+	// Bounds of the attachment mesh in actor space
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SKGAttachment|Metadata")
+	FBox Bounds = FBox(ForceInit);
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SKGAttachment|Metadata")
+	TArray<FName> SocketNames;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SKGAttachment|Metadata")
+	TArray<FSKGAttachmentComponentMetadata> AttachmentComponents;
+
+	bool operator == (const FSKGAttachmentMetadata& Other) const
+	{
+		return StaticMesh == Other.StaticMesh && SkeletalMesh == Other.SkeletalMesh && Bounds == Other.Bounds && SocketNames == Other.SocketNames && AttachmentComponents == Other.AttachmentComponents;
+	}
+};
@@ -0,0 +1,74 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SKGAttachmentPoolWorldSubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FSKGAttachmentPoolStats
+{
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly, Category = "SKGAttachment|Pool")
+	int32 Acquired = 0;
+	// Acquires served from the pool without spawning
+	UPROPERTY(BlueprintReadOnly, Category = "SKGAttachment|Pool")
+	int32 Reused = 0;
+	UPROPERTY(BlueprintReadOnly, Category = "SKGAttachment|Pool")
+	int32 Spawned = 0;
+	UPROPERTY(BlueprintReadOnly, Category = "SKGAttachment|Pool")
+	int32 Released = 0;
+	// Most hidden attachments held at once across all classes
+	UPROPERTY(BlueprintReadOnly, Category = "SKGAttachment|Pool")
+	int32 PeakPooled = 0;
+	UPROPERTY(BlueprintReadOnly, Category = "SKGAttachment|Pool")
+	int32 Pooled = 0;
+
+	float GetReuseRate() const { return Acquired > 0 ? static_cast<float>(Reused) / Acquired : 0.0f; }
+};
+
+USTRUCT()
+struct FSKGAttachmentPool
+{
+	GENERATED_BODY()
+	UPROPERTY()
+	TArray<AActor*> Attachments;
+};
+
+// Per class pool of hidden, non replicated attachment actors for local preview flows
+UCLASS()
+class SKGATTACHMENT_API USKGAttachmentPoolWorldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	UPROPERTY()
+	TMap<UClass*, FSKGAttachmentPool> Pools;
+	FSKGAttachmentPoolStats PoolStats;
+	
+	virtual void Deinitialize() override;
+	// Hidden with collision and tick off, or back to the class defaults
+	void SetAttachmentActive(AActor* Attachment, bool bActive) const;
+	void SetAttachmentTreeActive(AActor* Attachment, bool bActive) const;
+	// Destroys everything attached to the attachment, leaving the attachment itself
+	void StripAttachmentTree(AActor* Attachment) const;
+	void DestroyAttachmentTree(AActor* Attachment) const;
+
+public:
+	// Returns a pooled attachment or spawns a new non replicated one. Owner, transform, collision, tick and default attachments are reset
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Pool")
+	AActor* AcquireAttachment(TSubclassOf<AActor> AttachmentClass, AActor* Owner, const FTransform& Transform);
+	// Destroys the attachments on it, hides and deactivates the attachment and keeps it for reuse
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Pool")
+	void ReleaseAttachment(AActor* Attachment);
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Pool")
+	void EmptyPool();
+	
+	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Pool")
+	FSKGAttachmentPoolStats GetPoolStats() const { return PoolStats; }
+	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Pool")
+	float GetReuseRate() const { return PoolStats.GetReuseRate(); }
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Pool")
+	void ResetPoolStats();
+};
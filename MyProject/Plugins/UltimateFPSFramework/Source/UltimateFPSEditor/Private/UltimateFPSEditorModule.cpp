@@ -8,6 +8,11 @@
 #include "Visualizers/SKGAttachmentComponentVisualizer.h"
 #include "Visualizers/SKGFirearmStabilizerVisualizer.h"
 #include "Components/SKGFirearmStabilizerComponent.h"
+#include "Interfaces/SKGAttachmentInterface.h"
+#include "Misc/PDA_AttachmentMetadata.h"
+#include "Misc/SKGAttachmentDeveloperSettings.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
 
 #define LOCTEXT_NAMESPACE "FUltimateFPSEditorModule"
 
@@ -30,6 +35,12 @@ void FUltimateFPSEditorModule::StartupModule()
 			StabilizerComponentVisualizer->OnRegister();
 		}
 	}
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().AddRaw(this, &FUltimateFPSEditorModule::OnBlueprintPreCompile);
+		GEditor->OnBlueprintCompiled().AddRaw(this, &FUltimateFPSEditorModule::OnBlueprintCompiled);
+	}
 }
 
 void FUltimateFPSEditorModule::ShutdownModule()
@@ -41,6 +52,46 @@ void FUltimateFPSEditorModule::ShutdownModule()
 		GUnrealEd->UnregisterComponentVisualizer(USKGAttachmentComponent::StaticClass()->GetFName());
 		GUnrealEd->UnregisterComponentVisualizer(USKGFirearmStabilizerComponent::StaticClass()->GetFName());
 	}
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().RemoveAll(this);
+		GEditor->OnBlueprintCompiled().RemoveAll(this);
+	}
+}
+
+void FUltimateFPSEditorModule::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	if (Blueprint && Blueprint->ParentClass && Blueprint->ParentClass->IsChildOf(AActor::StaticClass()))
+	{
+		CompiledAttachmentBlueprints.AddUnique(Blueprint);
+	}
+}
+
+void FUltimateFPSEditorModule::OnBlueprintCompiled()
+{
+	const TArray<TWeakObjectPtr<UBlueprint>> Blueprints = MoveTemp(CompiledAttachmentBlueprints);
+	CompiledAttachmentBlueprints.Reset();
+	
+	UPDA_AttachmentMetadata* MetadataTable = GetDefault<USKGAttachmentDeveloperSettings>()->AttachmentMetadata.LoadSynchronous();
+	if (!MetadataTable)
+	{
+		return;
+	}
+
+	bool bMetadataChanged = false;
+	for (const TWeakObjectPtr<UBlueprint>& Blueprint : Blueprints)
+	{
+		const UClass* GeneratedClass = Blueprint.IsValid() ? Blueprint->GeneratedClass.Get() : nullptr;
+		if (GeneratedClass && GeneratedClass->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
+		{
+			bMetadataChanged |= MetadataTable->UpdateMetadata(GeneratedClass);
+		}
+	}
+	if (bMetadataChanged)
+	{
+		MetadataTable->MarkPackageDirty();
+	}
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -21,12 +21,14 @@ ASKGMagnifier::ASKGMagnifier()
 
 void ASKGMagnifier::OnRep_FlippedOut()
 {
+	MarkFirearmAimSocketsDirty();
 	OnUse();
 }
 
 void ASKGMagnifier::SetFullyFlipped(bool bIsFullyFlippedOut)
 {
 	bFullyFlipped = bIsFullyFlippedOut;
+	MarkFirearmAimSocketsDirty();
 	if (bFlippedOut)
 	{
 		Execute_DisableRenderTarget(this, true);
@@ -96,9 +98,18 @@ void ASKGMagnifier::Server_Flip_Implementation(bool bFlip)
 {
 	bFlippedOut = bFlip;
 	MARK_PROPERTY_DIRTY_FROM_NAME(ASKGMagnifier, bFlippedOut, this);
+	MarkFirearmAimSocketsDirty();
 	OnUse();
 }
 
+void ASKGMagnifier::MarkFirearmAimSocketsDirty()
+{
+	if (GetOwningFirearm())
+	{
+		OwningFirearm->MarkAimSocketsDirty();
+	}
+}
+
 void ASKGMagnifier::CycleMagnifier()
 {
 	bFullyFlipped = false;
@@ -118,6 +129,7 @@ void ASKGMagnifier::Use_Implementation()
 {
 	bFlippedOut = !bFlippedOut;
 	bFullyFlipped = false;
+	MarkFirearmAimSocketsDirty();
 	
 	if (bFlippedOut)
 	{
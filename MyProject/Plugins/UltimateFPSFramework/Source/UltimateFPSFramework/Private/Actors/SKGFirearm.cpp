@@ -65,6 +65,7 @@ ASKGFirearm::ASKGFirearm(const FObjectInitializer& ObjectInitializer)
 	TimeSinceLastShot = 0.0f;
 
 	CurrentFirearmPose = ESKGFirearmPose::None;
+	AimSocketVersion = 0;
 	FirstPersonShortStockPose = FTransform();
 	ThirdPersonShortStockPose = FTransform();
 	FirstPersonBasePoseOffset = FTransform();
@@ -491,6 +492,7 @@ void ASKGFirearm::SetPointAimIndex_Implementation(int32 Index)
 	{
 		PointAimIndex = INDEX_NONE;
 	}
+	MarkAimSocketsDirty();
 	
 	if (!HasAuthority())
 	{
@@ -871,8 +873,14 @@ bool ASKGFirearm::IsStabilized() const
 void ASKGFirearm::OnAttachmentUpdated_Implementation()
 {
 	Super::OnAttachmentUpdated_Implementation();
+	MarkAimSocketsDirty();
 	RefreshCurrentSight();
 	HandleSightComponents();
+
+	if (CharacterComponent && CharacterComponent->GetAnimationInstance())
+	{
+		CharacterComponent->GetAnimationInstance()->InvalidateHeldActorCache();
+	}
 }
 
 void ASKGFirearm::OnRep_FireMode()
@@ -1019,6 +1027,7 @@ FSKGProjectileTransform ASKGFirearm::GetProjectileSocketTransformToCenter(const
 
 void ASKGFirearm::OnRep_CurrentSightComponent()
 {
+	MarkAimSocketsDirty();
 	if (GetCharacterComponent() && CharacterComponent->GetAnimationInstance())
 	{
 		if (!CharacterComponent->IsLocallyControlled())
@@ -1172,6 +1181,7 @@ void ASKGFirearm::CycleSights_Implementation(bool bDownArray, bool bStopAtEndOfA
 	{
 		Execute_ActivateCurrentSight(this, false);
 		CurrentSightComponent = NewSightComponent;
+		MarkAimSocketsDirty();
 	}
 	
 	if (bFoundValidSight)
@@ -1252,6 +1262,7 @@ void ASKGFirearm::SetSight_Implementation(USKGAttachmentComponent* SightComponen
 	if (IsValid(SightComponent) && PartComponents.Contains(SightComponent))
 	{
 		CurrentSightComponent = SightComponent;
+		MarkAimSocketsDirty();
 		if (HasAuthority())
 		{
 			MARK_PROPERTY_DIRTY_FROM_NAME(ASKGFirearm, CurrentSightComponent, this);
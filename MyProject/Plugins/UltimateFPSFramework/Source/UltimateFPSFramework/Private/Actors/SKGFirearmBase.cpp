@@ -28,6 +28,7 @@ ASKGFirearmBase::ASKGFirearmBase(const FObjectInitializer& ObjectInitializer)
 	AttachmentManager = CreateDefaultSubobject<USKGAttachmentManager>(TEXT("FPSTemplateAttachmentManager"));
 
 	bShouldSpawnDefaultsFromPreset = true;
+	FirearmStatsVersion = 0;
 	
 	DefaultFirearmStats.Weight = 7.0f;
 	DefaultFirearmStats.Ergonomics = 50.0f;
@@ -229,39 +230,119 @@ void ASKGFirearmBase::HandleCachingAttachment(USKGAttachmentComponent* Attachmen
 	if (IsValid(AttachmentComponent))
 	{
 		AActor* Part = AttachmentComponent->GetAttachment();
-		if (IsValid(Part) && Part->GetClass()->ImplementsInterface(USKGFirearmAttachmentsInterface::StaticClass()))
+		if (IsValid(Part))
 		{
-			bool bAimable = false;
-			bool bHasRenderTarget = false;
-			if (Part->GetClass()->ImplementsInterface(USKGAimInterface::StaticClass()))
+			FSKGFirearmCachedPartInfo PartInfo;
+			PartInfo.Part = Part;
+			PartInfo.bIsFirearmPart = Part->GetClass()->ImplementsInterface(USKGFirearmAttachmentsInterface::StaticClass());
+			if (PartInfo.bIsFirearmPart)
 			{
-				bAimable = ISKGAimInterface::Execute_IsAimable(Part);
+				PartInfo.PartType = ISKGFirearmAttachmentsInterface::Execute_GetPartType(Part);
+				if (Part->GetClass()->ImplementsInterface(USKGAimInterface::StaticClass()))
+				{
+					PartInfo.bIsAimable = ISKGAimInterface::Execute_IsAimable(Part);
+				}
+				if (Part->GetClass()->ImplementsInterface(USKGRenderTargetInterface::StaticClass()))
+				{
+					PartInfo.bHasRenderTarget = ISKGRenderTargetInterface::Execute_HasRenderTarget(Part);
+				}
+				if (HasAuthority())
+				{
+					PartInfo.PartStats = ISKGFirearmAttachmentsInterface::Execute_GetPartStats(Part, false);
+				}
 			}
-			if (Part->GetClass()->ImplementsInterface(USKGRenderTargetInterface::StaticClass()))
-			{
-				bHasRenderTarget = ISKGRenderTargetInterface::Execute_HasRenderTarget(Part);
-			}
-			CachedComponents.AddAttachment(AttachmentComponent, ISKGFirearmAttachmentsInterface::Execute_GetPartType(Part), bAimable, bHasRenderTarget);
-			if (HasAuthority())
+			CachedPartInfo.Add(AttachmentComponent, PartInfo);
+		}
+	}
+}
+
+void ASKGFirearmBase::RebuildCachedParts()
+{
+	const TArray<USKGAttachmentComponent*>& AttachmentComponents = AttachmentManager->GetCachedAttachmentComponents();
+	CachedComponents.Empty();
+	CachedParts.Reset(AttachmentComponents.Num());
+	for (TPair<ESKGPartType, TArray<AActor*>>& PartTypeParts : PartTypeIndex)
+	{
+		PartTypeParts.Value.Reset();
+	}
+	PartStatsTotals.Reset();
+	for (USKGAttachmentComponent* AttachmentComponent : AttachmentComponents)
+	{
+		const FSKGFirearmCachedPartInfo* PartInfo = CachedPartInfo.Find(AttachmentComponent);
+		if (PartInfo && IsValid(PartInfo->Part))
+		{
+			if (PartInfo->bIsFirearmPart)
 			{
-				MARK_PROPERTY_DIRTY_FROM_NAME(ASKGFirearmBase, CachedComponents, this);
+				CachedComponents.AddAttachment(AttachmentComponent, PartInfo->PartType, PartInfo->bIsAimable, PartInfo->bHasRenderTarget);
+				PartTypeIndex.FindOrAdd(PartInfo->PartType).Add(PartInfo->Part);
+				PartStatsTotals.Add(PartInfo->PartStats);
 			}
+			CachedParts.Add(PartInfo->Part);
 		}
 	}
+	CachedParts.Shrink();
+	FinishCachedPartsUpdate();
 }
 
-void ASKGFirearmBase::HandleUpdateFirearmStats(USKGAttachmentComponent* AttachmentComponent)
+void ASKGFirearmBase::AddCachedPart(USKGAttachmentComponent* AttachmentComponent, const FSKGFirearmCachedPartInfo& PartInfo)
 {
-	if (HasAuthority() && IsValid(AttachmentComponent))
+	if (!IsValid(PartInfo.Part))
 	{
-		AActor* Part = AttachmentComponent->GetAttachment();
-		if (IsValid(Part) && Part->GetClass()->ImplementsInterface(USKGFirearmAttachmentsInterface::StaticClass()))
+		return;
+	}
+	
+	if (PartInfo.bIsFirearmPart)
+	{
+		CachedComponents.InsertAttachment(AttachmentComponent, PartInfo.PartType, PartInfo.bIsAimable, PartInfo.bHasRenderTarget, AttachmentManager->GetCachedAttachmentComponents());
+		PartTypeIndex.FindOrAdd(PartInfo.PartType).Add(PartInfo.Part);
+		PartStatsTotals.Add(PartInfo.PartStats);
+	}
+	CachedParts.Add(PartInfo.Part);
+}
+
+bool ASKGFirearmBase::RemoveCachedPart(USKGAttachmentComponent* AttachmentComponent, const FSKGFirearmCachedPartInfo& PartInfo)
+{
+	if (!CachedParts.RemoveSingleSwap(PartInfo.Part, false))
+	{	// Never made it into the cached parts (destroyed before caching)
+		return true;
+	}
+	
+	if (PartInfo.bIsFirearmPart)
+	{
+		TArray<AActor*>& PartsOfType = PartTypeIndex.FindOrAdd(PartInfo.PartType);
+		PartsOfType.RemoveSingleSwap(PartInfo.Part, false);
+		PartStatsTotals.Remove(PartInfo.PartStats);
+		// Another part of the same type has to take over the emptied slot, only a walk in cache order knows which
+		if (CachedComponents.RemoveAttachment(AttachmentComponent) && PartsOfType.Num())
 		{
-			const FSKGFirearmPartStats PartStats = ISKGFirearmAttachmentsInterface::Execute_GetPartStats(Part, false);
-			FSKGFirearmStats::UpdateStats(FirearmStats, DefaultFirearmStats, PartStats);
-			MARK_PROPERTY_DIRTY_FROM_NAME(ASKGFirearmBase, FirearmStats, this);
+			return false;
 		}
 	}
+	return true;
+}
+
+void ASKGFirearmBase::FinishCachedPartsUpdate()
+{
+	if (HasAuthority())
+	{
+		PartStatsTotals.Apply(FirearmStats, DefaultFirearmStats);
+		MARK_PROPERTY_DIRTY_FROM_NAME(ASKGFirearmBase, CachedComponents, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(ASKGFirearmBase, FirearmStats, this);
+		NotifyFirearmStatsChanged();
+	}
+}
+
+void ASKGFirearmBase::NotifyFirearmStatsChanged()
+{
+	++FirearmStatsVersion;
+	OnFirearmStatsChanged.Broadcast(this);
+}
+
+const TArray<AActor*>& ASKGFirearmBase::GetPartsOfType(ESKGPartType PartType) const
+{
+	static const TArray<AActor*> EmptyParts;
+	const TArray<AActor*>* Parts = PartTypeIndex.Find(PartType);
+	return Parts ? *Parts : EmptyParts;
 }
 
 TArray<USKGAttachmentComponent*> ASKGFirearmBase::GetAttachmentComponents_Implementation()
@@ -281,30 +362,45 @@ TArray<USKGAttachmentComponent*> ASKGFirearmBase::GetAllAttachmentComponents_Imp
 
 void ASKGFirearmBase::OnAttachmentUpdated_Implementation()
 {
-	CachedComponents.Empty();
-	CachedParts.Empty();
-	CachedParts.Reserve(AttachmentManager->GetAllAttachmentComponents(false).Num());
-	if (HasAuthority())
+	if (AttachmentManager->IsApplyingAttachmentChanges())
 	{
-		FirearmStats = DefaultFirearmStats;
-	}
-	for (USKGAttachmentComponent* AttachmentComponent : AttachmentManager->GetAllAttachmentComponents(false))
-	{
-		if (IsValid(AttachmentComponent))
+		// Only query and apply the parts that changed, everything else stays as cached
+		bool bNeedsRebuild = false;
+		for (const FSKGAttachmentChange& AttachmentChange : AttachmentManager->GetAttachmentChanges())
 		{
-			HandleCachingAttachment(AttachmentComponent);
-			HandleUpdateFirearmStats(AttachmentComponent);
-			if (AActor* Attachment = AttachmentComponent->GetAttachment())
+			USKGAttachmentComponent* AttachmentComponent = AttachmentChange.AttachmentComponent;
+			FSKGFirearmCachedPartInfo PartInfo;
+			if (CachedPartInfo.RemoveAndCopyValue(AttachmentComponent, PartInfo))
 			{
-				CachedParts.Add(AttachmentComponent->GetAttachment());
+				bNeedsRebuild |= !RemoveCachedPart(AttachmentComponent, PartInfo);
 			}
+			if (AttachmentChange.ChangeType != ESKGAttachmentChangeType::Removed)
+			{
+				HandleCachingAttachment(AttachmentComponent);
+				if (const FSKGFirearmCachedPartInfo* NewPartInfo = CachedPartInfo.Find(AttachmentComponent))
+				{
+					AddCachedPart(AttachmentComponent, *NewPartInfo);
+				}
+			}
+		}
+		
+		if (bNeedsRebuild)
+		{
+			RebuildCachedParts();
+		}
+		else
+		{
+			FinishCachedPartsUpdate();
 		}
 	}
-	CachedParts.Shrink();
-
-	if (HasAuthority())
+	else
 	{
-		MARK_PROPERTY_DIRTY_FROM_NAME(ASKGFirearmBase, CachedComponents, this);
+		CachedPartInfo.Reset();
+		for (USKGAttachmentComponent* AttachmentComponent : AttachmentManager->GetCachedAttachmentComponents())
+		{
+			HandleCachingAttachment(AttachmentComponent);
+		}
+		RebuildCachedParts();
 	}
 }
 
@@ -8,6 +8,7 @@
 #include "Interfaces/SKGAimInterface.h"
 #include "Interfaces/SKGInfraredInterface.h"
 #include "Components/SKGCharacterMovementComponent.h"
+#include "SKGInfraredWorldSubsystem.h"
 
 #include "Components/SkeletalMeshComponent.h"
 #include "Camera/CameraComponent.h"
@@ -24,12 +25,22 @@
 #include "GameFramework/PlayerController.h"
 #include "Camera/PlayerCameraManager.h"
 
-DECLARE_CYCLE_STAT(TEXT("SKGTick"), STAT_SKGTick, STATGROUP_SKGCharacterComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SKGControlYawSends"), STAT_SKGControlYawSends, STATGROUP_SKGCharacterComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SKGLeanSends"), STAT_SKGLeanSends, STATGROUP_SKGCharacterComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SKGLeanSendsCoalesced"), STAT_SKGLeanSendsCoalesced, STATGROUP_SKGCharacterComponent);
+
+namespace SKGControlYaw
+{
+	// Finest precision that still fits a full turn in a uint16
+	static constexpr float MinPrecision = 360.0f / 65535.0f;
+}
 
 USKGCharacterComponent::USKGCharacterComponent()
 {
+	// Nothing here needs a tick, control yaw is gathered in PreReplication and the infrared strobe is a world timer.
+	// Keep the tick function registered (but disabled) so subclasses and Blueprints can still enable it
 	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.TickInterval = 1.0f / 30.0f; // tick firearm collision at 30fps
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 	SetIsReplicatedByDefault(true);
 	
 	FirearmCollisionChannel = ECC_GameTraceChannel2;
@@ -64,7 +75,17 @@ USKGCharacterComponent::USKGCharacterComponent()
 
 	LookUpDownOffset = 0.0f;
 	
+	ControlYawReplicationPrecision = 0.5f;
+	ControlYawMinSendInterval = 1.0f / 30.0f;
+	ControlYawInterpSpeed = 15.0f;
+	QuantizedControlYaw = 0;
 	ControlYaw = 0.0f;
+	ControlYawTarget = 0.0f;
+	ControlYawUpdateTime = 0.0;
+	LastControlYawSendTime = -1.0;
+	bHasReceivedControlYaw = false;
+	LeanSendMinInterval = 0.05f;
+	LastLeanSendTime = -1.0;
 
 	bIsThirdPersonDefault = false;
 	bInThirdPerson = bIsThirdPersonDefault;
@@ -83,6 +104,16 @@ void USKGCharacterComponent::BeginPlay()
 	SetupPawnComponents();
 }
 
+void USKGCharacterComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USKGInfraredWorldSubsystem* InfraredSubsystem = GetWorld() ? GetWorld()->GetSubsystem<USKGInfraredWorldSubsystem>() : nullptr)
+	{
+		InfraredSubsystem->RemoveStrobeViewer(this);
+	}
+	
+	Super::EndPlay(EndPlayReason);
+}
+
 void USKGCharacterComponent::PostInitProperties()
 {
 	Super::PostInitProperties();
@@ -102,10 +133,10 @@ void USKGCharacterComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty
 	ParamsOwnerOnly.bIsPushBased = true;
 	ParamsOwnerOnly.Condition = COND_SkipOwner;
 	DOREPLIFETIME_WITH_PARAMS_FAST(USKGCharacterComponent, Flags, ParamsOwnerOnly);
-	DOREPLIFETIME_WITH_PARAMS_FAST(USKGCharacterComponent, LeanSettings, ParamsOwnerOnly);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USKGCharacterComponent, ReplicatedLean, ParamsOwnerOnly);
 	DOREPLIFETIME_WITH_PARAMS_FAST(USKGCharacterComponent, SprintType, ParamsOwnerOnly);
 	DOREPLIFETIME_WITH_PARAMS_FAST(USKGCharacterComponent, FirearmPose, ParamsOwnerOnly);
-	DOREPLIFETIME_WITH_PARAMS_FAST(USKGCharacterComponent, ControlYaw, ParamsOwnerOnly);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USKGCharacterComponent, QuantizedControlYaw, ParamsOwnerOnly);
 }
 
 void USKGCharacterComponent::OnRep_Flags()
@@ -125,17 +156,66 @@ void USKGCharacterComponent::OnRep_Flags()
 	SetFreeLook(bFreeLook);
 }
 
-void USKGCharacterComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void USKGCharacterComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	SCOPE_CYCLE_COUNTER(STAT_SKGTick);
+	Super::PreReplication(ChangedPropertyTracker);
+	// Only needed when the owner is actually about to replicate, so this runs at the net update rate instead of a component tick.
+	// Marking dirty only when the quantized value changes keeps still players out of the push model compare
 	if (HasAuthority())
 	{
-		ControlYaw = GetControlRotation().Yaw;
-		MARK_PROPERTY_DIRTY_FROM_NAME(USKGCharacterComponent, ControlYaw, this);
+		const double WorldTime = GetWorld()->GetTimeSeconds();
+		if (WorldTime - LastControlYawSendTime >= ControlYawMinSendInterval)
+		{
+			const uint16 NewQuantizedControlYaw = QuantizeControlYaw(GetControlRotation().Yaw);
+			if (NewQuantizedControlYaw != QuantizedControlYaw)
+			{
+				QuantizedControlYaw = NewQuantizedControlYaw;
+				LastControlYawSendTime = WorldTime;
+				MARK_PROPERTY_DIRTY_FROM_NAME(USKGCharacterComponent, QuantizedControlYaw, this);
+				INC_DWORD_STAT(STAT_SKGControlYawSends);
+			}
+		}
+	}
+}
+
+float USKGCharacterComponent::GetControlYawPrecision() const
+{
+	return FMath::Max(ControlYawReplicationPrecision, SKGControlYaw::MinPrecision);
+}
+
+uint16 USKGCharacterComponent::QuantizeControlYaw(float Yaw) const
+{
+	const float Precision = GetControlYawPrecision();
+	const int32 NumSteps = FMath::Min(FMath::CeilToInt32(360.0f / Precision), 65536);
+	return static_cast<uint16>(FMath::RoundToInt32(FRotator::ClampAxis(Yaw) / Precision) % NumSteps);
+}
+
+void USKGCharacterComponent::OnRep_QuantizedControlYaw()
+{
+	// Finish the time spent moving towards the previous target before switching to the new one
+	UpdateRemoteControlYaw();
+	ControlYawTarget = DequantizeControlYaw(QuantizedControlYaw);
+	if (!bHasReceivedControlYaw || ControlYawInterpSpeed <= 0.0f)
+	{
+		bHasReceivedControlYaw = true;
+		ControlYaw = ControlYawTarget;
+	}
+}
+
+void USKGCharacterComponent::UpdateRemoteControlYaw()
+{
+	if (HasAuthority() || !GetWorld())
+	{
+		return;
 	}
 	
-	HandleInfraredMaterialCollection();
+	const double WorldTime = GetWorld()->GetTimeSeconds();
+	const float DeltaSeconds = static_cast<float>(WorldTime - ControlYawUpdateTime);
+	ControlYawUpdateTime = WorldTime;
+	if (DeltaSeconds > 0.0f && ControlYaw != ControlYawTarget)
+	{
+		ControlYaw = FMath::RInterpTo(FRotator(0.0f, ControlYaw, 0.0f), FRotator(0.0f, ControlYawTarget, 0.0f), DeltaSeconds, ControlYawInterpSpeed).Yaw;
+	}
 }
 
 void USKGCharacterComponent::SetupPawnComponents()
@@ -188,40 +268,24 @@ void USKGCharacterComponent::SetupPawnComponents()
 	}
 }
 
-void USKGCharacterComponent::HandleInfraredMaterialCollection()
+void USKGCharacterComponent::UpdateInfraredStrobe()
 {
-	if (InfraredMaterialSettings.bUseInfraredMaterialSettings)
+	if (USKGInfraredWorldSubsystem* InfraredSubsystem = GetWorld() ? GetWorld()->GetSubsystem<USKGInfraredWorldSubsystem>() : nullptr)
 	{
-		if (bNightVisionOn)
-		{
-			const float ElapsedTime = GetWorld()->GetTimeSeconds() - InfraredMaterialSettings.TimeElapsed;
-			if (ElapsedTime > InfraredMaterialSettings.InfraredStrobeIntervalSeconds)
-			{
-				InfraredMaterialSettings.TimeElapsed = GetWorld()->GetTimeSeconds();
-				if (InfraredMaterialSettings.InfraredMPC)
-				{
-					float InfraredStrobeOnValue;
-					InfraredMaterialSettings.InfraredMPC->GetScalarParameterValue(FName("InfraredStrobeOn"), InfraredStrobeOnValue);
-				
-					if (InfraredStrobeOnValue)
-					{
-						InfraredMaterialSettings.bInfraredOn = false;
-						InfraredMaterialSettings.InfraredMPC->SetScalarParameterValue(FName("InfraredStrobeOn"), 0.0f);
-					}
-					else
-					{
-						InfraredMaterialSettings.bInfraredOn = true;
-						InfraredMaterialSettings.InfraredMPC->SetScalarParameterValue(FName("InfraredStrobeOn"), 1.0f);
-					}
-				}
-			}
-		}
-		else if (InfraredMaterialSettings.bInfraredOn)
+		InfraredSubsystem->UpdateStrobeViewer(this);
+	}
+}
+
+bool USKGCharacterComponent::HasInfraredDevices() const
+{
+	for (const AActor* InfraredDevice : InfraredInfraredDevices)
+	{
+		if (IsValid(InfraredDevice))
 		{
-			InfraredMaterialSettings.bInfraredOn = false;
-			InfraredMaterialSettings.InfraredMPC->SetScalarParameterValue(FName("InfraredStrobeOn"), 0.0f);
+			return true;
 		}
 	}
+	return false;
 }
 
 void USKGCharacterComponent::AddInfraredDevice(AActor* InfraredDevice)
@@ -229,6 +293,10 @@ void USKGCharacterComponent::AddInfraredDevice(AActor* InfraredDevice)
 	if (IsValid(InfraredDevice) && InfraredDevice->Implements<USKGInfraredInterface>())
 	{
 		InfraredInfraredDevices.Add(InfraredDevice);
+		if (bNightVisionOn)
+		{
+			UpdateInfraredStrobe();
+		}
 	}
 }
 
@@ -254,6 +322,7 @@ void USKGCharacterComponent::SetNightVisionOn(bool bOn)
 	}
 	
 	InfraredInfraredDevices.Shrink();
+	UpdateInfraredStrobe();
 }
 
 void USKGCharacterComponent::Init(UCameraComponent* CameraComponent, USkeletalMeshComponent* FirstPersonMesh, USkeletalMeshComponent* ThirdPersonMesh)
@@ -603,7 +672,6 @@ void USKGCharacterComponent::OnRep_HeldActor(AActor* OldActor)
 	if (HasAuthority())
 	{
 		MARK_PROPERTY_DIRTY_FROM_NAME(USKGCharacterComponent, HeldActor, this);
-		MARK_PROPERTY_DIRTY_FROM_NAME(USKGCharacterComponent, LeanSettings, this);
 	}
 
 	OnHeldActorChanged.Broadcast(OldActor, HeldActor);
@@ -647,7 +715,8 @@ FRotator USKGCharacterComponent::GetBaseAimRotation() const
 	if (OwningPawn)
 	{
 		FRotator Rotation = OwningPawn->GetBaseAimRotation();
-		Rotation.Yaw = ControlYaw;
+		// ControlYaw is only refreshed when replicating, the authority has the live value
+		Rotation.Yaw = HasAuthority() ? GetControlRotation().Yaw : ControlYaw;
 		return Rotation;
 	}
 	return FRotator::ZeroRotator;
@@ -757,14 +826,94 @@ void USKGCharacterComponent::SetThirdPersonView(bool bThirdPerson)
 	OnRep_FirearmPose();
 }
 
-void USKGCharacterComponent::OnRep_LeanSettings()
+void USKGCharacterComponent::OnRep_ReplicatedLean()
 {
+	LeanSettings.ReplicatedLeanCurveTime = DequantizeLean(ReplicatedLean);
+	LeanSettings.bIncrementalLeaning = ReplicatedLean.bIncremental;
 	if (AnimationInstance)
 	{
 		AnimationInstance->SetLeaning(LeanSettings.ReplicatedLeanCurveTime);
 	}
 }
 
+FSKGReplicatedLean USKGCharacterComponent::QuantizeLean(float CurveTime, bool bIncremental) const
+{
+	FSKGReplicatedLean Lean;
+	Lean.bIncremental = bIncremental;
+	const float Range = FMath::Max(CurveTime < 0.0f ? LeanSettings.LeanCurveTimeLeft : LeanSettings.LeanCurveTimeRight, KINDA_SMALL_NUMBER);
+	Lean.Amount = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt32(FMath::Abs(CurveTime) / Range * 255.0f), 0, 255));
+	if (Lean.Amount > 0)
+	{
+		Lean.Direction = CurveTime < 0.0f ? ESKGLeaning::Left : ESKGLeaning::Right;
+	}
+	return Lean;
+}
+
+float USKGCharacterComponent::DequantizeLean(const FSKGReplicatedLean& Lean) const
+{
+	switch (Lean.Direction)
+	{
+	case ESKGLeaning::Left : return -LeanSettings.LeanCurveTimeLeft * Lean.Amount / 255.0f;
+	case ESKGLeaning::Right : return LeanSettings.LeanCurveTimeRight * Lean.Amount / 255.0f;
+	default : return 0.0f;
+	}
+}
+
+void USKGCharacterComponent::SendLean()
+{
+	const FSKGReplicatedLean Lean = QuantizeLean(LeanSettings.ReplicatedLeanCurveTime, LeanSettings.bIncrementalLeaning);
+	if (Lean == LastSentLean)
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if (TimerManager.IsTimerActive(LeanSendTimerHandle))
+	{
+		INC_DWORD_STAT(STAT_SKGLeanSendsCoalesced);
+		return;
+	}
+	
+	const double TimeUntilSend = LastLeanSendTime + LeanSendMinInterval - GetWorld()->GetTimeSeconds();
+	if (TimeUntilSend <= 0.0 || LastLeanSendTime < 0.0)
+	{
+		SendLeanNow(Lean);
+	}
+	else
+	{
+		// The timer sends whatever the lean is by then, so every change until it fires collapses into one RPC
+		TimerManager.SetTimer(LeanSendTimerHandle, this, &USKGCharacterComponent::SendPendingLean, static_cast<float>(TimeUntilSend), false);
+	}
+}
+
+void USKGCharacterComponent::SendPendingLean()
+{
+	// No interval check here, the timer already waited it out and rounding could otherwise leave the final lean unsent
+	const FSKGReplicatedLean Lean = QuantizeLean(LeanSettings.ReplicatedLeanCurveTime, LeanSettings.bIncrementalLeaning);
+	if (Lean != LastSentLean)
+	{
+		SendLeanNow(Lean);
+	}
+}
+
+void USKGCharacterComponent::SendLeanNow(const FSKGReplicatedLean& Lean)
+{
+	GetWorld()->GetTimerManager().ClearTimer(LeanSendTimerHandle);
+	LastLeanSendTime = GetWorld()->GetTimeSeconds();
+	LastSentLean = Lean;
+	INC_DWORD_STAT(STAT_SKGLeanSends);
+	Server_SetLean(Lean);
+}
+
+void USKGCharacterComponent::SetReplicatedLean(const FSKGReplicatedLean& Lean)
+{
+	if (Lean != ReplicatedLean)
+	{
+		ReplicatedLean = Lean;
+		MARK_PROPERTY_DIRTY_FROM_NAME(USKGCharacterComponent, ReplicatedLean, this);
+	}
+}
+
 void USKGCharacterComponent::SetLeaning(bool bIncremental)
 {
 	if (GetAnimationInstance())
@@ -787,11 +936,11 @@ void USKGCharacterComponent::SetLeaning(bool bIncremental)
 		AnimationInstance->SetLeaning(LeanSettings.ReplicatedLeanCurveTime);
 		if (!HasAuthority())
 		{
-			Server_SetLean(LeanSettings.ReplicatedLeanCurveTime, bIncremental);
+			SendLean();
 		}
 		else
 		{
-			MARK_PROPERTY_DIRTY_FROM_NAME(USKGCharacterComponent, LeanSettings, this);
+			SetReplicatedLean(QuantizeLean(LeanSettings.ReplicatedLeanCurveTime, bIncremental));
 		}
 	}
 }
@@ -941,7 +1090,6 @@ void USKGCharacterComponent::IncrementalLean(ESKGLeaning LeanDirection)
 			LeanSettings.CurrentIncrementalLean = 0.0f;
 		}
 	}
-	UE_LOG(LogTemp, Warning, TEXT("LeanSettings.CurrentIncrementalLean: %f"), LeanSettings.CurrentIncrementalLean);
 	
 	if (LeanSettings.CurrentIncrementalLean > LeanSettings.CurrentLeanCurveTime && LeanSettings.CurrentLeanCurveTime != 0.0f)
 	{
@@ -966,11 +1114,11 @@ void USKGCharacterComponent::ResetLeanAngle()
 		AnimationInstance->SetLeaning(LeanSettings.CurrentIncrementalLean);
 		if (!HasAuthority())
 		{
-			Server_SetLean(LeanSettings.CurrentIncrementalLean, false);
+			SendLean();
 		}
 		else
 		{
-			MARK_PROPERTY_DIRTY_FROM_NAME(USKGCharacterComponent, LeanSettings, this);
+			SetReplicatedLean(QuantizeLean(LeanSettings.CurrentIncrementalLean, false));
 		}
 	}
 }
@@ -1013,17 +1161,15 @@ void USKGCharacterComponent::SetMaxLookDownAngle(const float Angle)
 	}
 }
 
-bool USKGCharacterComponent::Server_SetLean_Validate(float CurveTime, bool bIncremental)
+bool USKGCharacterComponent::Server_SetLean_Validate(FSKGReplicatedLean Lean)
 {
 	return true;
 }
 
-void USKGCharacterComponent::Server_SetLean_Implementation(float CurveTime, bool bIncremental)
+void USKGCharacterComponent::Server_SetLean_Implementation(FSKGReplicatedLean Lean)
 {
-	LeanSettings.ReplicatedLeanCurveTime = CurveTime;
-	LeanSettings.bIncrementalLeaning = bIncremental;
-	MARK_PROPERTY_DIRTY_FROM_NAME(USKGCharacterComponent, LeanSettings, this);
-	OnRep_LeanSettings();
+	SetReplicatedLean(Lean);
+	OnRep_ReplicatedLean();
 }
 
 bool USKGCharacterComponent::Server_SetUseLeftHandIK_Validate(bool bUse)
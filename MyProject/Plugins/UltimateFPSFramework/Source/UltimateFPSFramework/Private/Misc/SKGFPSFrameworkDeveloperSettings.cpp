@@ -6,3 +6,12 @@
 USKGFPSFrameworkDeveloperSettings::USKGFPSFrameworkDeveloperSettings(const FObjectInitializer& ObjectInitializer)
 {
 }
+
+const FSKGAnimSignificanceSettings& USKGFPSFrameworkDeveloperSettings::GetAnimSignificanceSettings() const
+{
+	if (const FSKGAnimSignificanceSettings* PlatformSettings = PlatformAnimSignificanceSettings.Find(FPlatformProperties::IniPlatformName()))
+	{
+		return *PlatformSettings;
+	}
+	return AnimSignificanceSettings;
+}
@@ -0,0 +1,112 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/SKGCharacterComponent.h"
+
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+struct FSKGCharacterComponentTestAccess
+{
+	static void SetControlYawPrecision(USKGCharacterComponent* CharacterComponent, float Precision) { CharacterComponent->ControlYawReplicationPrecision = Precision; }
+	static float GetControlYawPrecision(const USKGCharacterComponent* CharacterComponent) { return CharacterComponent->GetControlYawPrecision(); }
+	static uint16 QuantizeControlYaw(const USKGCharacterComponent* CharacterComponent, float Yaw) { return CharacterComponent->QuantizeControlYaw(Yaw); }
+	static float DequantizeControlYaw(const USKGCharacterComponent* CharacterComponent, uint16 QuantizedYaw) { return CharacterComponent->DequantizeControlYaw(QuantizedYaw); }
+
+	static void SetLeanRange(USKGCharacterComponent* CharacterComponent, float Left, float Right)
+	{
+		CharacterComponent->LeanSettings.LeanCurveTimeLeft = Left;
+		CharacterComponent->LeanSettings.LeanCurveTimeRight = Right;
+	}
+	static FSKGReplicatedLean QuantizeLean(const USKGCharacterComponent* CharacterComponent, float CurveTime, bool bIncremental) { return CharacterComponent->QuantizeLean(CurveTime, bIncremental); }
+	static float DequantizeLean(const USKGCharacterComponent* CharacterComponent, const FSKGReplicatedLean& Lean) { return CharacterComponent->DequantizeLean(Lean); }
+};
+
+namespace SKGCharacterReplicationQuantizeTests
+{
+	// What the receiving end reads back after the lean went through its net serializer
+	static FSKGReplicatedLean NetRoundTrip(FSKGReplicatedLean Lean)
+	{
+		bool bSuccess = false;
+		FBitWriter Writer(64, true);
+		Lean.NetSerialize(Writer, nullptr, bSuccess);
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		FSKGReplicatedLean ReadLean;
+		ReadLean.NetSerialize(Reader, nullptr, bSuccess);
+		return ReadLean;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGControlYawQuantizeTest, "UltimateFPSFramework.CharacterComponent.ControlYawQuantizeRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGControlYawQuantizeTest::RunTest(const FString& Parameters)
+{
+	USKGCharacterComponent* CharacterComponent = NewObject<USKGCharacterComponent>();
+	// 0 falls back to the finest precision, 0.7 does not divide a full turn
+	for (const float Precision : { 0.0f, 0.1f, 0.5f, 0.7f, 2.0f })
+	{
+		FSKGCharacterComponentTestAccess::SetControlYawPrecision(CharacterComponent, Precision);
+		const float UsedPrecision = FSKGCharacterComponentTestAccess::GetControlYawPrecision(CharacterComponent);
+		TArray<float> Yaws = { -UsedPrecision * 0.25f, 360.0f - UsedPrecision * 0.25f, 359.999f, 360.0f };
+		for (float Yaw = -720.0f; Yaw <= 720.0f; Yaw += 0.37f)
+		{
+			Yaws.Add(Yaw);
+		}
+
+		float MaxError = 0.0f;
+		for (const float Yaw : Yaws)
+		{
+			const float ReadYaw = FSKGCharacterComponentTestAccess::DequantizeControlYaw(CharacterComponent, FSKGCharacterComponentTestAccess::QuantizeControlYaw(CharacterComponent, Yaw));
+			// Compared on the circle, the last step below a full turn may round up to 0
+			MaxError = FMath::Max(MaxError, FMath::Abs(FMath::FindDeltaAngleDegrees(Yaw, ReadYaw)));
+			if (ReadYaw < 0.0f || ReadYaw > 360.0f)
+			{
+				AddError(FString::Printf(TEXT("Precision %.2f: yaw %.3f read back as %.3f, outside a full turn"), Precision, Yaw, ReadYaw));
+			}
+		}
+		TestTrue(FString::Printf(TEXT("Precision %.2f: round trip error %.4f is within half a step"), Precision, MaxError), MaxError <= UsedPrecision * 0.5f + KINDA_SMALL_NUMBER);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGLeanQuantizeTest, "UltimateFPSFramework.CharacterComponent.LeanQuantizeRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGLeanQuantizeTest::RunTest(const FString& Parameters)
+{
+	using namespace SKGCharacterReplicationQuantizeTests;
+	USKGCharacterComponent* CharacterComponent = NewObject<USKGCharacterComponent>();
+	// Different ranges per side so a lean read back with the other sides range shows up
+	constexpr float LeanLeft = 35.0f;
+	constexpr float LeanRight = 20.0f;
+	FSKGCharacterComponentTestAccess::SetLeanRange(CharacterComponent, LeanLeft, LeanRight);
+
+	for (const bool bIncremental : { false, true })
+	{
+		for (float CurveTime = -LeanLeft; CurveTime <= LeanRight; CurveTime += 0.13f)
+		{
+			const FSKGReplicatedLean Lean = FSKGCharacterComponentTestAccess::QuantizeLean(CharacterComponent, CurveTime, bIncremental);
+			const FSKGReplicatedLean ReadLean = NetRoundTrip(Lean);
+			if (ReadLean != Lean)
+			{
+				AddError(FString::Printf(TEXT("Lean %.2f (incremental %d) changed going through NetSerialize"), CurveTime, bIncremental));
+			}
+
+			const float Step = (CurveTime < 0.0f ? LeanLeft : LeanRight) / 255.0f;
+			const float ReadCurveTime = FSKGCharacterComponentTestAccess::DequantizeLean(CharacterComponent, ReadLean);
+			if (FMath::Abs(ReadCurveTime - CurveTime) > Step * 0.5f + KINDA_SMALL_NUMBER)
+			{
+				AddError(FString::Printf(TEXT("Lean %.2f read back as %.4f, more than half a step off"), CurveTime, ReadCurveTime));
+			}
+		}
+	}
+
+	TestTrue(TEXT("No lean reads back as no direction"), FSKGCharacterComponentTestAccess::QuantizeLean(CharacterComponent, 0.0f, false).Direction == ESKGLeaning::None);
+	TestEqual(TEXT("Full left reads back exactly"), FSKGCharacterComponentTestAccess::DequantizeLean(CharacterComponent, NetRoundTrip(FSKGCharacterComponentTestAccess::QuantizeLean(CharacterComponent, -LeanLeft, false))), -LeanLeft);
+	TestEqual(TEXT("Full right reads back exactly"), FSKGCharacterComponentTestAccess::DequantizeLean(CharacterComponent, NetRoundTrip(FSKGCharacterComponentTestAccess::QuantizeLean(CharacterComponent, LeanRight, false))), LeanRight);
+	return true;
+}
+
+#endif
@@ -0,0 +1,61 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/SKGCharacterAnimInstanceTestUtils.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGFirearmCollisionProbeTest, "UltimateFPSFramework.AnimInstance.FirearmCollisionProbe", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGFirearmCollisionProbeTest::RunTest(const FString& Parameters)
+{
+	using namespace SKGCharacterAnimInstanceTests;
+	using FAccess = FSKGCharacterAnimInstanceTestAccess;
+	FScopedTestWorld TestWorld;
+	USKGCharacterAnimInstance* AnimInstance = CreateAnimInstance(TestWorld.World);
+
+	FAccess::ResetFirearmCollisionProbe(AnimInstance);
+	const FCollisionQueryParams& QueryParams = FAccess::GetFirearmCollisionQueryParams(AnimInstance);
+	const int32 NumIgnoredActors = QueryParams.GetIgnoredActors().Num();
+	const void* IgnoredActorsData = QueryParams.GetIgnoredActors().GetData();
+	TestEqual(TEXT("The character is ignored by the probe"), NumIgnoredActors, 1);
+
+	const FTraceHandle& TraceHandle = FAccess::GetFirearmCollisionTraceHandle(AnimInstance);
+	const FVector Start(0.0f, 0.0f, 100.0f);
+	const FVector End(60.0f, 0.0f, 100.0f);
+	const FVector Moved(0.0f, 10.0f, 0.0f);
+
+	FAccess::SetWorldTime(AnimInstance, 1.0f);
+	FAccess::UpdateFirearmCollisionProbe(AnimInstance, Start, End);
+	TestTrue(TEXT("The first update issues a probe"), TraceHandle.IsValid());
+
+	const FTraceHandle InFlightHandle = TraceHandle;
+	FAccess::UpdateFirearmCollisionProbe(AnimInstance, Start + Moved, End + Moved);
+	TestTrue(TEXT("A probe still in flight is kept"), TraceHandle == InFlightHandle);
+
+	// A handle from a frame the world no longer tracks, what an instance that skipped updates is left holding
+	FAccess::GetFirearmCollisionTraceHandle(AnimInstance) = FTraceHandle(TNumericLimits<uint32>::Max(), 0);
+	FAccess::SetWorldTime(AnimInstance, 1.01f);
+	FAccess::UpdateFirearmCollisionProbe(AnimInstance, Start, End);
+	TestTrue(TEXT("An expired probe is issued again"), TraceHandle.IsValid() && TestWorld.World->IsTraceHandleValid(TraceHandle, false));
+
+	FAccess::CompleteFirearmCollisionProbe(AnimInstance, End);
+	FAccess::SetWorldTime(AnimInstance, 1.05f);
+	FAccess::UpdateFirearmCollisionProbe(AnimInstance, Start, End);
+	TestFalse(TEXT("A still weapon is not probed again before the max interval"), TraceHandle.IsValid());
+	FAccess::UpdateFirearmCollisionProbe(AnimInstance, Start + Moved, End + Moved);
+	TestTrue(TEXT("A moved weapon is probed"), TraceHandle.IsValid());
+
+	FAccess::CompleteFirearmCollisionProbe(AnimInstance, End + Moved);
+	FAccess::SetWorldTime(AnimInstance, 1.05f + 2.0f * FAccess::GetFirearmCollisionProbeMaxInterval(AnimInstance));
+	FAccess::UpdateFirearmCollisionProbe(AnimInstance, Start + Moved, End + Moved);
+	TestTrue(TEXT("A still weapon is probed again after the max interval"), TraceHandle.IsValid());
+
+	// The ignore list is built when the held actor changes, probing must not rebuild or grow it
+	TestEqual(TEXT("Probing keeps the ignore list"), QueryParams.GetIgnoredActors().Num(), NumIgnoredActors);
+	TestTrue(TEXT("Probing does not reallocate the ignore list"), QueryParams.GetIgnoredActors().GetData() == IgnoredActorsData);
+	return true;
+}
+
+#endif
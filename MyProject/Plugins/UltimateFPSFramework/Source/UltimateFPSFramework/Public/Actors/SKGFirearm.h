@@ -209,6 +209,8 @@ protected:
 	
 	UPROPERTY(ReplicatedUsing = OnRep_CurrentSightComponent)
 	int32 PointAimIndex;
+	// Bumped whenever something moves the aim sockets relative to the firearm (sight, point aim, attachments, pose, magnifier)
+	uint32 AimSocketVersion;
 	
 	TObjectPtr<USKGFirearmStabilizerComponent> StabilizerComponent;
 	
@@ -267,6 +269,9 @@ public:
 	void DisableSightCycling() { bCanCycleSights = false; }
 	UFUNCTION(BlueprintCallable, Category = "SKGFPSFramework|Animation")
 	void RefreshCurrentSight();
+	// Lets the character anim instance skip gathering the aim sockets again while nothing changed
+	void MarkAimSocketsDirty() { ++AimSocketVersion; }
+	uint32 GetAimSocketVersion() const { return AimSocketVersion; }
 	UFUNCTION(BlueprintCallable, Category = "SKGFPSFramework|Animation")
 	void SetSwayMultiplier(float NewMultiplier) { NewMultiplier >= 0.0f ? SwayMultiplier = NewMultiplier : SwayMultiplier = DefaultSwayMultiplier; }
 	UFUNCTION(BlueprintCallable, Category = "SKGFPSFramework|Animation")
@@ -353,7 +358,7 @@ public:
 	virtual FSKGFirearmPoseCurveSettings GetOppositeShoulderCurveSettings_Implementation() override { return OppositeShoulderCurveSettings; }
 	virtual FSKGFirearmPoseCurveSettings GetBlindFireLeftCurveSettings_Implementation() override { return BlindFireLeftCurveSettings; }
 	virtual FSKGFirearmPoseCurveSettings GetBlindFireUpCurveSettings_Implementation() override { return BlindFireUpCurveSettings; }
-	virtual void StoreCurrentPose_Implementation(ESKGFirearmPose CurrentPose) override { CurrentFirearmPose = CurrentPose; }
+	virtual void StoreCurrentPose_Implementation(ESKGFirearmPose CurrentPose) override { CurrentFirearmPose = CurrentPose; MarkAimSocketsDirty(); }
 
 	virtual FSKGFirearmPoseCurveSettings GetAimCurveSettings_Implementation() override { return CurrentFirearmPose == ESKGFirearmPose::OppositeShoulder ? OppositeShoulderAimCurveSettings : AimCurveSettings; }
 	
@@ -25,6 +25,10 @@ UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class ULTIMATEFPSFRAMEWORK_API USKGCharacterComponent : public UActorComponent
 {
 	GENERATED_BODY()
+#if WITH_DEV_AUTOMATION_TESTS
+	// Lets the automation tests reach the control yaw and lean quantization
+	friend struct FSKGCharacterComponentTestAccess;
+#endif
 
 public:
 	// Sets default values for this component's properties
@@ -84,6 +88,18 @@ protected:
 	uint8 AttachmentAttempt;
 	UPROPERTY(EditDefaultsOnly, Category = "SKGFPSFramework|Infrared")
 	FSKGInfraredMaterialSettings InfraredMaterialSettings;
+	// Control yaw is replicated in steps of this many degrees and only sent when the step changes
+	UPROPERTY(EditDefaultsOnly, Category = "SKGFPSFramework|Replication", meta = (ClampMin = "0.01"))
+	float ControlYawReplicationPrecision;
+	// Minimum time between control yaw sends, on top of the owners (adaptive) net update frequency
+	UPROPERTY(EditDefaultsOnly, Category = "SKGFPSFramework|Replication", meta = (ClampMin = "0.0"))
+	float ControlYawMinSendInterval;
+	// How fast remote clients interpolate to the received control yaw, 0 = snap
+	UPROPERTY(EditDefaultsOnly, Category = "SKGFPSFramework|Replication", meta = (ClampMin = "0.0"))
+	float ControlYawInterpSpeed;
+	// Minimum time between lean updates sent to the server, lean changes in between are coalesced
+	UPROPERTY(EditDefaultsOnly, Category = "SKGFPSFramework|Replication", meta = (ClampMin = "0.0"))
+	float LeanSendMinInterval;
 	// Set this to the max speed your character component allows for movement
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGFPSFramework|Animation")
 	float MovementComponentSprintSpeed;
@@ -137,12 +153,26 @@ protected:
 	UFUNCTION()
 	virtual void OnRep_HeldActor(AActor* OldActor = nullptr);
 
-	UPROPERTY(ReplicatedUsing = OnRep_LeanSettings)
+	UPROPERTY()
 	FSKGLeanSettings LeanSettings;
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedLean)
+	FSKGReplicatedLean ReplicatedLean;
 	UFUNCTION()
-	void OnRep_LeanSettings();
+	void OnRep_ReplicatedLean();
 	bool bLeanLeftDown;
 	bool bLeanRightDown;
+	FSKGReplicatedLean LastSentLean;
+	double LastLeanSendTime;
+	FTimerHandle LeanSendTimerHandle;
+
+	FSKGReplicatedLean QuantizeLean(float CurveTime, bool bIncremental) const;
+	float DequantizeLean(const FSKGReplicatedLean& Lean) const;
+	// Sends the current lean to the server at most once per LeanSendMinInterval, changes in between are coalesced into one send
+	void SendLean();
+	// Timer callback for a coalesced send, always sends the lean as it is by then
+	void SendPendingLean();
+	void SendLeanNow(const FSKGReplicatedLean& Lean);
+	void SetReplicatedLean(const FSKGReplicatedLean& Lean);
 
 	UPROPERTY(ReplicatedUsing = OnRep_Flags)
 	uint8 Flags;
@@ -166,23 +196,36 @@ protected:
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void PostInitProperties() override;
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 	void SetupPawnComponents();
 
-	void HandleInfraredMaterialCollection();
+	void UpdateInfraredStrobe();
 	
 	UFUNCTION(Server, Unreliable, WithValidation)
 	void Server_SetAiming(bool IsAiming);
-	UFUNCTION(Server, Unreliable, WithValidation)
-	void Server_SetLean(float CurveTime, bool bIncremental);
+	UFUNCTION(Server, Reliable, WithValidation)
+	void Server_SetLean(FSKGReplicatedLean Lean);
 	UFUNCTION(Server, Unreliable, WithValidation)
 	void Server_SetUseLeftHandIK(bool bUse);
 	UFUNCTION(Server, Unreliable, WithValidation)
 	void Server_SetUseLeftHandTwoBoneIK(bool bUse);
 
-	UPROPERTY(Replicated)
+	UPROPERTY(ReplicatedUsing = OnRep_QuantizedControlYaw)
+	uint16 QuantizedControlYaw;
+	UFUNCTION()
+	void OnRep_QuantizedControlYaw();
+	// Live on the authority, interpolated towards ControlYawTarget on remote clients
 	float ControlYaw;
+	float ControlYawTarget;
+	double ControlYawUpdateTime;
+	double LastControlYawSendTime;
+	bool bHasReceivedControlYaw;
+
+	float GetControlYawPrecision() const;
+	uint16 QuantizeControlYaw(float Yaw) const;
+	float DequantizeControlYaw(uint16 QuantizedYaw) const { return QuantizedYaw * GetControlYawPrecision(); }
 
 	UFUNCTION(Server, Unreliable, WithValidation)
 	void Server_ClearCurrentHeldActor();
@@ -224,6 +267,8 @@ public:
 	void SetNightVisionOn(bool bOn);
 	UFUNCTION(BlueprintPure, Category = "SKGFPSFramework|CharacterComponent")
 	bool NightVisionOn() const { return bNightVisionOn; }
+	bool HasInfraredDevices() const;
+	const FSKGInfraredMaterialSettings& GetInfraredMaterialSettings() const { return InfraredMaterialSettings; }
 	
 	bool HasAuthority() const { return GetOwner() ? GetOwner()->HasAuthority() : false; }
 	/**
@@ -254,6 +299,8 @@ public:
 	T* GetMovementComponent() const;
 	UFUNCTION(BlueprintCallable, Category = "SKGFPSFramework|Character", meta = (ExpandBoolAsExecs = "ReturnValue"))
 	bool IsLocallyControlled() { return bLocallyControlled; }
+	// Called once per frame (from the anim instance) on remote clients to move the control yaw towards the last received value
+	void UpdateRemoteControlYaw();
 	UFUNCTION(BlueprintPure, Category = "SKGFPSFramework|Character")
 	virtual FRotator GetBaseAimRotation() const;
 	UFUNCTION(BlueprintPure, Category = "SKGFPSFramework|Character")
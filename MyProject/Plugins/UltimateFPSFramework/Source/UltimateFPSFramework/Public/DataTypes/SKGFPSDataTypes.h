@@ -109,6 +109,14 @@ enum class ESKGSprintType : uint8
 	SuperSprint	UMETA(DisplayName = "SuperSprint")
 };
 
+UENUM(BlueprintType)
+enum class ESKGAnimSignificance : uint8
+{
+	Full		UMETA(DisplayName = "Full"),
+	Reduced		UMETA(DisplayName = "Reduced"),
+	Minimal		UMETA(DisplayName = "Minimal")
+};
+
 // Forward Declarations
 class UMaterialInstance;
 class UMaterialInstanceDynamic;
@@ -196,6 +204,79 @@ struct FSKGFirearmCachedParts
 		}
 	}
 
+	// Same result as calling AddAttachment for every component in Order, without walking it. Order is the attachment managers cache
+	void InsertAttachment(USKGAttachmentComponent* AttachmentComponent, ESKGPartType PartType, bool bIsAimable, bool bHasRenderTarget, const TArray<USKGAttachmentComponent*>& Order)
+	{
+		if (!AttachmentComponent)
+		{
+			return;
+		}
+		
+		const int32 OrderIndex = Order.IndexOfByKey(AttachmentComponent);
+		auto InsertInOrder = [&](TArray<USKGAttachmentComponent*>& Components)
+		{
+			int32 InsertIndex = Components.Num();
+			for (int32 i = 0; i < Components.Num(); ++i)
+			{
+				if (Order.IndexOfByKey(Components[i]) > OrderIndex)
+				{
+					InsertIndex = i;
+					break;
+				}
+			}
+			Components.Insert(AttachmentComponent, InsertIndex);
+		};
+		// AddAttachment lets the last component in order win the single slots
+		auto SetIfLater = [&](USKGAttachmentComponent*& Slot)
+		{
+			if (!Slot || Order.IndexOfByKey(Slot) < OrderIndex)
+			{
+				Slot = AttachmentComponent;
+			}
+		};
+		
+		if (bIsAimable && PartType != ESKGPartType::Sight)
+		{
+			InsertInOrder(Sights);
+		}
+		if (bHasRenderTarget)
+		{
+			InsertInOrder(RenderTargets);
+		}
+		switch (PartType)
+		{
+		case ESKGPartType::Sight : InsertInOrder(Sights); break;
+		case ESKGPartType::LightLaser : InsertInOrder(LightLasers); break;
+		case ESKGPartType::Magnifier : InsertInOrder(Magnifiers); break;
+		case ESKGPartType::Barrel : SetIfLater(Barrel); break;
+		case ESKGPartType::MuzzleDevice : SetIfLater(Muzzle); break;
+		case ESKGPartType::ForwardGrip : SetIfLater(ForwardGrip); break;
+		case ESKGPartType::Handguard : SetIfLater(Handguard); break;
+		case ESKGPartType::Stock : SetIfLater(Stock); break;
+		case ESKGPartType::Magazine : SetIfLater(Magazine); break;
+		case ESKGPartType::Bipod : SetIfLater(Bipod); break;
+		}
+	}
+
+	// Returns true if the component held a single slot (barrel, stock...) that is now empty
+	bool RemoveAttachment(USKGAttachmentComponent* AttachmentComponent)
+	{
+		Sights.Remove(AttachmentComponent);
+		RenderTargets.Remove(AttachmentComponent);
+		LightLasers.Remove(AttachmentComponent);
+		Magnifiers.Remove(AttachmentComponent);
+		bool bClearedSlot = false;
+		for (USKGAttachmentComponent** Slot : { &Barrel, &Muzzle, &ForwardGrip, &Handguard, &Stock, &Magazine, &Bipod })
+		{
+			if (*Slot == AttachmentComponent)
+			{
+				*Slot = nullptr;
+				bClearedSlot = true;
+			}
+		}
+		return bClearedSlot;
+	}
+
 	TArray<AActor*> GetAllActors()
 	{
 		TArray<AActor*> Actors;
@@ -367,6 +448,81 @@ struct FSKGFirearmStats
 	}
 };
 
+// Running totals of part stats on top of the default stats. Unlike chaining UpdateStats the result does not depend on
+// part order, so one part can be added or removed without walking the others. Matches UpdateStats for cycle rates up to 10
+struct FSKGFirearmPartStatsTotals
+{
+	double Weight = 0.0;
+	double ErgonomicsMultiplier = 1.0;
+	// Parts with -100% ergonomics zero the product and cannot be divided back out
+	int32 ZeroErgonomicsParts = 0;
+	double VerticalRecoilMultiplier = 1.0;
+	double HorizontalRecoilMultiplier = 1.0;
+	double AccuracyMultiplier = 1.0;
+	double MuzzleVelocityMultiplier = 1.0;
+	double CycleRateDecrease = 0.0;
+	int32 NumParts = 0;
+
+	void Reset() { *this = FSKGFirearmPartStatsTotals(); }
+	void Add(const FSKGFirearmPartStats& PartStats) { Accumulate(PartStats, true); }
+	void Remove(const FSKGFirearmPartStats& PartStats) { Accumulate(PartStats, false); }
+
+	void Apply(FSKGFirearmStats& FirearmStats, const FSKGFirearmStats& DefaultFirearmStats) const
+	{
+		FirearmStats = DefaultFirearmStats;
+		if (NumParts > 0)
+		{
+			FirearmStats.Weight += static_cast<float>(Weight);
+			FirearmStats.Ergonomics = ZeroErgonomicsParts > 0 ? 0.0f : static_cast<float>(DefaultFirearmStats.Ergonomics * ErgonomicsMultiplier);
+			FirearmStats.VerticalRecoilMultiplier = static_cast<float>(DefaultFirearmStats.VerticalRecoilMultiplier * VerticalRecoilMultiplier);
+			FirearmStats.HorizontalRecoilMultiplier = static_cast<float>(DefaultFirearmStats.HorizontalRecoilMultiplier * HorizontalRecoilMultiplier);
+			FirearmStats.AccuracyMultiplier = static_cast<float>(DefaultFirearmStats.AccuracyMultiplier * AccuracyMultiplier);
+			FirearmStats.MuzzleVelocityMultiplier = static_cast<float>(DefaultFirearmStats.MuzzleVelocityMultiplier * MuzzleVelocityMultiplier);
+			FirearmStats.CycleRateMultiplier = static_cast<float>(FMath::Clamp(DefaultFirearmStats.CycleRateMultiplier - CycleRateDecrease, 0.1, 10.0));
+		}
+	}
+
+private:
+	void Accumulate(const FSKGFirearmPartStats& PartStats, bool bAdd)
+	{
+		auto Scale = [bAdd](double& Total, double Multiplier) { Total = bAdd ? Total * Multiplier : Total / Multiplier; };
+		const double Sign = bAdd ? 1.0 : -1.0;
+		
+		Weight += Sign * PartStats.Weight;
+		const double Ergonomics = 1.0 + PartStats.ErgonomicsChangePercentage / 100.0;
+		if (Ergonomics == 0.0)
+		{
+			ZeroErgonomicsParts += bAdd ? 1 : -1;
+		}
+		else
+		{
+			Scale(ErgonomicsMultiplier, Ergonomics);
+		}
+		Scale(VerticalRecoilMultiplier, FMath::Clamp(1.0f + PartStats.VerticalRecoilChangePercentage / 100.0f, 0.1f, 100.0f));
+		Scale(HorizontalRecoilMultiplier, FMath::Clamp(1.0f + PartStats.HorizontalRecoilChangePercentage / 100.0f, 0.1f, 100.0f));
+		Scale(AccuracyMultiplier, FMath::Clamp(1.0f + PartStats.AccuracyChangePercentage, 0.1f, 10000.0f));
+		Scale(MuzzleVelocityMultiplier, FMath::Clamp(1.0f + PartStats.MuzzleVelocityChangePercentage / 100.0f, 0.1f, 100.0f));
+		CycleRateDecrease += Sign * FMath::Clamp(PartStats.CycleRateIncreasePercentage / 100.0f, 0.0f, 100.0f);
+		NumParts += bAdd ? 1 : -1;
+	}
+};
+
+// What a firearm needs to know about an attached part, cached so unchanged parts are not queried again when another part changes
+USTRUCT()
+struct FSKGFirearmCachedPartInfo
+{
+	GENERATED_BODY()
+	UPROPERTY()
+	AActor* Part = nullptr;
+	// False if the part does not implement the firearm attachments interface, it is then only added to the cached parts
+	bool bIsFirearmPart = false;
+	ESKGPartType PartType = ESKGPartType::Other;
+	bool bIsAimable = false;
+	bool bHasRenderTarget = false;
+	UPROPERTY()
+	FSKGFirearmPartStats PartStats;
+};
+
 USTRUCT(BlueprintType)
 struct FSKGFirearmPartData
 {
@@ -418,8 +574,6 @@ struct FSKGInfraredMaterialSettings
 	float InfraredStrobeIntervalSeconds = 1.0f;
 	
 	TObjectPtr<UMaterialParameterCollectionInstance> InfraredMPC = nullptr;
-	float TimeElapsed = 0.0f;
-	bool bInfraredOn = false;
 };
 
 USTRUCT(BlueprintType)
@@ -603,6 +757,50 @@ struct FSKGLeanSettings
 	}
 };
 
+// Lean state as sent over the network, the lean settings themselves stay local. Amount is the lean curve time
+// quantized to 8 bits of the Direction sides LeanCurveTime, the whole struct serializes to 11 bits
+USTRUCT()
+struct FSKGReplicatedLean
+{
+	GENERATED_BODY()
+	UPROPERTY()
+	ESKGLeaning Direction = ESKGLeaning::None;
+	UPROPERTY()
+	uint8 Amount = 0;
+	UPROPERTY()
+	bool bIncremental = false;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		uint8 DirectionAndIncremental = Ar.IsLoading() ? 0 : static_cast<uint8>(static_cast<uint8>(Direction) | (bIncremental ? 1 << 2 : 0));
+		Ar.SerializeBits(&DirectionAndIncremental, 3);
+		Ar << Amount;
+		if (Ar.IsLoading())
+		{
+			Direction = static_cast<ESKGLeaning>(FMath::Min(DirectionAndIncremental & 3, static_cast<int32>(ESKGLeaning::Right)));
+			bIncremental = (DirectionAndIncremental & (1 << 2)) != 0;
+		}
+		bOutSuccess = true;
+		return true;
+	}
+
+	bool operator==(const FSKGReplicatedLean& Other) const
+	{
+		return Direction == Other.Direction && Amount == Other.Amount && bIncremental == Other.bIncremental;
+	}
+	bool operator!=(const FSKGReplicatedLean& Other) const { return !(*this == Other); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FSKGReplicatedLean> : public TStructOpsTypeTraitsBase2<FSKGReplicatedLean>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
 USTRUCT(BlueprintType)
 struct FSKGFirearmPoseCurveSetting
 {
@@ -826,6 +1024,9 @@ struct FSKGRecoilData
 	FSKGMinMax RecoilRollRandomness = FSKGMinMax(-3.0f, 3.0f);
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "SKGFPSFramework")
 	FSKGMinMax RecoilYawRandomness = FSKGMinMax(-8.0f, 8.0f);
+	// Seed of the per shot recoil randomness. 0 derives the seed from the firearm class so server and clients agree
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "SKGFPSFramework")
+	int32 RecoilSeed = 0;
 
 	bool bUseControlRotation = false;
 	
@@ -846,4 +1047,278 @@ struct FSKGRecoilData
 		}
 		return FVector::ZeroVector;
 	}
+};
+
+// FSKGRecoilData compiled into fixed rate tables. The tables hold the running integral of each curve so the offset
+// applied between two times does not depend on frame rate, and the randomness is drawn per shot from a seeded stream
+// so the same shot produces the same kick on every machine
+struct FSKGRecoilPattern
+{
+	static constexpr float SampleRate = 120.0f;
+	static constexpr int32 NumShots = 32;
+	// The old per frame integration scaled curve values by 100 * DeltaSeconds
+	static constexpr float CurveScale = 100.0f;
+
+	struct FShotRandomness
+	{
+		float Location = 1.0f;
+		FVector Rotation = FVector::OneVector;
+		FVector2D ControlRotation = FVector2D::UnitVector;
+	};
+
+	TArray<FVector> LocationIntegral;
+	TArray<FVector> RotationIntegral;
+	TArray<FVector> ControlRotationIntegral;
+	TArray<FShotRandomness> Shots;
+	float ControlRotationScale = 0.0f;
+	
+	bool HasLocation() const { return LocationIntegral.Num() > 0; }
+	bool HasRotation() const { return RotationIntegral.Num() > 0; }
+	bool HasControlRotation() const { return ControlRotationIntegral.Num() > 0; }
+	bool IsValid() const { return Shots.Num() > 0; }
+
+	void Reset()
+	{
+		LocationIntegral.Reset();
+		RotationIntegral.Reset();
+		ControlRotationIntegral.Reset();
+		Shots.Reset();
+	}
+
+	void Build(const FSKGRecoilData& RecoilData, int32 Seed)
+	{
+		Reset();
+		BuildIntegral(RecoilData.RecoilLocationCurve, LocationIntegral);
+		BuildIntegral(RecoilData.RecoilRotationCurve, RotationIntegral);
+		if (RecoilData.bUseControlRotation)
+		{
+			BuildIntegral(RecoilData.ControlRotationCurve, ControlRotationIntegral);
+		}
+		ControlRotationScale = RecoilData.ControlRotationScale;
+
+		FRandomStream Stream(Seed);
+		Shots.SetNumUninitialized(NumShots);
+		for (FShotRandomness& Shot : Shots)
+		{
+			Shot.Location = Stream.FRandRange(RecoilData.RecoilLocationRandomness.Min, RecoilData.RecoilLocationRandomness.Max);
+			Shot.Rotation.X = Stream.FRandRange(RecoilData.RecoilPitchRandomness.Min, RecoilData.RecoilPitchRandomness.Max);
+			Shot.Rotation.Y = Stream.FRandRange(RecoilData.RecoilYawRandomness.Min, RecoilData.RecoilYawRandomness.Max);
+			Shot.Rotation.Z = Stream.FRandRange(RecoilData.RecoilRollRandomness.Min, RecoilData.RecoilRollRandomness.Max);
+			Shot.ControlRotation.X = Stream.FRandRange(RecoilData.ControlRotationPitchRandomness.Min, RecoilData.ControlRotationPitchRandomness.Max);
+			Shot.ControlRotation.Y = Stream.FRandRange(RecoilData.ControlRotationYawRandomness.Min, RecoilData.ControlRotationYawRandomness.Max);
+		}
+	}
+
+	const FShotRandomness& GetShot(int32 ShotIndex) const { return Shots[ShotIndex % NumShots]; }
+
+	// Location offset added by ShotIndex between FromTime and ToTime seconds after the shot
+	FVector GetLocationDelta(int32 ShotIndex, float FromTime, float ToTime) const
+	{
+		return (SampleIntegral(LocationIntegral, ToTime) - SampleIntegral(LocationIntegral, FromTime)) * GetShot(ShotIndex).Location;
+	}
+
+	// Pitch (X), yaw (Y) and roll (Z) curve offsets with the shot randomness applied, before stat multipliers
+	FVector GetRotationDelta(int32 ShotIndex, float FromTime, float ToTime) const
+	{
+		return (SampleIntegral(RotationIntegral, ToTime) - SampleIntegral(RotationIntegral, FromTime)) * GetShot(ShotIndex).Rotation;
+	}
+
+	// Control rotation pitch and yaw kick with the shot randomness and control rotation scale applied, before stat multipliers
+	FVector2D GetControlRotationDelta(int32 ShotIndex, float FromTime, float ToTime) const
+	{
+		const FVector Delta = SampleIntegral(ControlRotationIntegral, ToTime) - SampleIntegral(ControlRotationIntegral, FromTime);
+		return FVector2D(Delta.X, Delta.Y) * GetShot(ShotIndex).ControlRotation * ControlRotationScale;
+	}
+
+	// Full control rotation kick of a shot, lets the server validate the kick a client applied
+	FVector2D GetControlRotationKick(int32 ShotIndex) const
+	{
+		return HasControlRotation() ? GetControlRotationDelta(ShotIndex, 0.0f, GetDuration(ControlRotationIntegral)) : FVector2D::ZeroVector;
+	}
+
+private:
+	static float GetDuration(const TArray<FVector>& Integral)
+	{
+		return (Integral.Num() - 1) / SampleRate;
+	}
+	
+	static FVector SampleIntegral(const TArray<FVector>& Integral, float Time)
+	{
+		if (Integral.Num() == 0)
+		{
+			return FVector::ZeroVector;
+		}
+		const float SamplePosition = FMath::Clamp(Time * SampleRate, 0.0f, static_cast<float>(Integral.Num() - 1));
+		const int32 Index = FMath::Min(FMath::FloorToInt32(SamplePosition), Integral.Num() - 2);
+		if (Index < 0)
+		{
+			return Integral[0];
+		}
+		return FMath::Lerp(Integral[Index], Integral[Index + 1], SamplePosition - Index);
+	}
+
+	// Trapezoid integral of the curve from its first key to its last key, past the last key the curve adds nothing
+	static void BuildIntegral(const UCurveVector* Curve, TArray<FVector>& OutIntegral)
+	{
+		if (!Curve)
+		{
+			return;
+		}
+		float MinTime = 0.0f;
+		float MaxTime = 0.0f;
+		Curve->GetTimeRange(MinTime, MaxTime);
+		const int32 NumSamples = FMath::Max(FMath::CeilToInt32(FMath::Max(MaxTime, 0.0f) * SampleRate), 1) + 1;
+		const float Step = 1.0f / SampleRate;
+		OutIntegral.SetNumUninitialized(NumSamples);
+		OutIntegral[0] = FVector::ZeroVector;
+		FVector PreviousValue = Curve->GetVectorValue(0.0f);
+		for (int32 i = 1; i < NumSamples; ++i)
+		{
+			const FVector Value = Curve->GetVectorValue(i * Step);
+			OutIntegral[i] = OutIntegral[i - 1] + (PreviousValue + Value) * (0.5f * Step * CurveScale);
+			PreviousValue = Value;
+		}
+	}
+};
+
+// UCurveVector resampled at a fixed step so evaluation is a single lerp. Looping curves (cycle/cycle with offset)
+// are wrapped, clamped curves are held. Curves using other extrapolation modes are evaluated directly.
+// Hold it in a UPROPERTY so the source curve stays referenced while the table uses it
+USTRUCT()
+struct FSKGSampledCurveVector
+{
+	GENERATED_BODY()
+	static constexpr float DefaultSampleRate = 120.0f;
+	static constexpr int32 MaxSamples = 2048;
+
+	const UCurveVector* GetSourceCurve() const { return SourceCurve; }
+	bool IsSampled() const { return Samples.Num() > 0; }
+
+	void Reset()
+	{
+		SourceCurve = nullptr;
+		Samples.Reset();
+	}
+
+	void Bake(UCurveVector* Curve)
+	{
+		Reset();
+		SourceCurve = Curve;
+		if (!Curve)
+		{
+			return;
+		}
+
+		ERichCurveExtrapolation Extrapolation = RCCE_None;
+		float MinTime = 0.0f;
+		float MaxTime = 0.0f;
+		bool bHasKeys = false;
+		for (const FRichCurve& Channel : Curve->FloatCurves)
+		{
+			if (!Channel.GetNumKeys())
+			{
+				continue;
+			}
+			float ChannelMinTime, ChannelMaxTime;
+			Channel.GetTimeRange(ChannelMinTime, ChannelMaxTime);
+			if (!bHasKeys)
+			{
+				bHasKeys = true;
+				Extrapolation = Channel.PostInfinityExtrap;
+				MinTime = ChannelMinTime;
+				MaxTime = ChannelMaxTime;
+			}
+			// Channels have to agree on how they extrapolate and loop over the same range to share one table
+			else if (Channel.PostInfinityExtrap != Extrapolation || (IsLooping(Extrapolation) && (ChannelMinTime != MinTime || ChannelMaxTime != MaxTime)))
+			{
+				return;
+			}
+			if (Channel.PreInfinityExtrap != Channel.PostInfinityExtrap && !(IsHolding(Channel.PreInfinityExtrap) && IsHolding(Channel.PostInfinityExtrap)))
+			{
+				return;
+			}
+			MinTime = FMath::Min(MinTime, ChannelMinTime);
+			MaxTime = FMath::Max(MaxTime, ChannelMaxTime);
+		}
+		if (bHasKeys && !IsLooping(Extrapolation) && !IsHolding(Extrapolation))
+		{
+			return;
+		}
+
+		StartTime = MinTime;
+		Duration = MaxTime - MinTime;
+		bLoop = IsLooping(Extrapolation) && Duration > UE_KINDA_SMALL_NUMBER;
+		// Whole number of steps over the curve so the last sample lands on the last key
+		const int32 NumSteps = FMath::Clamp(FMath::CeilToInt32(Duration * DefaultSampleRate), 0, MaxSamples - 1);
+		SampleRate = NumSteps ? NumSteps / Duration : DefaultSampleRate;
+		Samples.SetNumUninitialized(NumSteps + 1);
+		for (int32 i = 0; i <= NumSteps; ++i)
+		{
+			Samples[i] = Curve->GetVectorValue(StartTime + i / SampleRate);
+		}
+		LoopOffset = Extrapolation == RCCE_CycleWithOffset ? Samples.Last() - Samples[0] : FVector::ZeroVector;
+	}
+
+	FVector Evaluate(float Time) const
+	{
+		if (!IsSampled())
+		{
+			return SourceCurve ? SourceCurve->GetVectorValue(Time) : FVector::ZeroVector;
+		}
+		if (Samples.Num() == 1)
+		{
+			return Samples[0];
+		}
+
+		float LocalTime = Time - StartTime;
+		FVector Offset = FVector::ZeroVector;
+		if (bLoop)
+		{
+			const float Cycles = FMath::FloorToFloat(LocalTime / Duration);
+			LocalTime -= Cycles * Duration;
+			Offset = LoopOffset * Cycles;
+		}
+		const float SamplePosition = FMath::Clamp(LocalTime * SampleRate, 0.0f, static_cast<float>(Samples.Num() - 1));
+		const int32 Index = FMath::Min(FMath::FloorToInt32(SamplePosition), Samples.Num() - 2);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], SamplePosition - Index) + Offset;
+	}
+
+private:
+	static bool IsLooping(ERichCurveExtrapolation Extrapolation) { return Extrapolation == RCCE_Cycle || Extrapolation == RCCE_CycleWithOffset; }
+	static bool IsHolding(ERichCurveExtrapolation Extrapolation) { return Extrapolation == RCCE_Constant || Extrapolation == RCCE_None; }
+
+	UPROPERTY()
+	UCurveVector* SourceCurve = nullptr;
+	TArray<FVector> Samples;
+	FVector LoopOffset = FVector::ZeroVector;
+	float StartTime = 0.0f;
+	float Duration = 0.0f;
+	float SampleRate = DefaultSampleRate;
+	bool bLoop = false;
+};
+
+USTRUCT(BlueprintType)
+struct FSKGAnimSignificanceSettings
+{
+	GENERATED_BODY()
+	// If false every character runs the full procedural animation update
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SKGFPSFramework")
+	bool bEnabled = true;
+	// Characters within this distance (cm) of a local camera get full updates
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SKGFPSFramework", meta = (ClampMin = "0.0"))
+	float FullMaxDistance = 1500.0f;
+	// Characters covering at least this much of the screen (bounds radius / view half width) get full updates, keeps scoped in targets at full rate
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SKGFPSFramework", meta = (ClampMin = "0.0"))
+	float FullMinScreenSize = 0.15f;
+	// Characters within this distance (cm) of a local camera get reduced rate updates, beyond it they are minimal
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SKGFPSFramework", meta = (ClampMin = "0.0"))
+	float ReducedMaxDistance = 5000.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SKGFPSFramework", meta = (ClampMin = "0.0"))
+	float ReducedMinScreenSize = 0.03f;
+	// Run the procedural update once every this many frames for reduced and minimal characters
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SKGFPSFramework", meta = (ClampMin = "1"))
+	int32 ReducedUpdateInterval = 3;
+	// Characters not rendered for this long (seconds) are treated as minimal
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SKGFPSFramework", meta = (ClampMin = "0.0"))
+	float NotRenderedGracePeriod = 0.25f;
 };
\ No newline at end of file
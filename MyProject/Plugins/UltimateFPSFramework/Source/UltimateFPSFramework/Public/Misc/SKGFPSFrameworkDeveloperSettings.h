@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
+#include "DataTypes/SKGFPSDataTypes.h"
 #include "SKGFPSFrameworkDeveloperSettings.generated.h"
 
 /**
@@ -19,4 +20,14 @@ public:
 	
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "ComponentTags")
 	FName FirearmMeshTag = "SKGFirearm";
+
+	// Update rate tiers for remote character animation
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "AnimationSignificance")
+	FSKGAnimSignificanceSettings AnimSignificanceSettings;
+	// Overrides of AnimSignificanceSettings keyed by ini platform name (Windows, Android, IOS...)
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "AnimationSignificance")
+	TMap<FString, FSKGAnimSignificanceSettings> PlatformAnimSignificanceSettings;
+
+	// Returns the significance settings for the platform currently running
+	const FSKGAnimSignificanceSettings& GetAnimSignificanceSettings() const;
 };
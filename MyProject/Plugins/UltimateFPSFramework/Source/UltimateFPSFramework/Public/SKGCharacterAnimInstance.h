@@ -5,25 +5,146 @@
 #include "Animation/AnimInstance.h"
 #include "DataTypes/SKGFPSDataTypes.h"
 #include "GameplayTagContainer.h"
+#include "WorldCollision.h"
 #include "SKGCharacterAnimInstance.generated.h"
 
 
 DECLARE_STATS_GROUP(TEXT("SKGAnimInstanceStatGroup"), STATGROUP_SKGAnimInstance, STATCAT_Advanced);
 
 class ASKGFirearm;
+class ASKGFirearmBase;
 class USKGCharacterComponent;
 class UAnimSequence;
 
+// Held actor interface data gathered once per animation update so the procedural functions
+// never call back into the interfaces. The equip section is only refreshed when the held actor
+// changes or its attachments/sights change, the frame section is refreshed every update
+struct FSKGHeldActorAnimSnapshot
+{
+	// Equip data
+	bool bIsProcedural = false;
+	bool bIsFirearm = false;
+	bool bHasFirearmParts = false;
+	bool bHasFirearmCollision = false;
+	FSKGFirearmStats FirearmStats;
+	// Derived from FirearmStats once per stats change
+	float VerticalRecoilMultiplier = 1.0f;
+	float HorizontalRecoilMultiplier = 1.0f;
+	float RotationLagWeightMultiplier = 1.0f;
+	float MovementSwayStatsMultiplier = 1.1f;
+	FSKGRecoilData RecoilData;
+	FSKGCurveAndShakeSettings CurveAndShakeSettings;
+	FSKGSwayMultipliers SwayMultipliers;
+	FSKGAimCameraSettings CameraSettings;
+	float AimInterpolationMultiplier = 1.0f;
+	float UnAimInterpolationMultiplier = 1.0f;
+	float RotationLagInterpolationMultiplier = 1.0f;
+	float LeaningSpeedMultiplier = 1.0f;
+	float HighLowPortPoseInterpolationSpeed = 1.0f;
+	float MaxSightDistanceOffset = 0.0f;
+	float StockLengthOfPull = 0.0f;
+	FName FirearmGripSocket;
+	FTransform CollisionRelativeMuzzle;
+	const AActor* CurrentSightActor = nullptr;
+
+	// Aim socket data, only gathered again when the held firearms aim socket version or attachment to the hand changes
+	FTransform HeadAimTransform;
+	FTransform NeckAimTransform;
+	FTransform DefaultAimSocketRelativeToHand;
+	FTransform AimSocketRelativeToHand;
+
+	// Frame data
+	FTransform BasePoseOffset;
+	FSKGLeftHandIKData LeftHandIKData;
+	FSKGCollisionSettings CollisionSettings;
+	FTransform SprintPose;
+	FTransform SuperSprintPose;
+	FVector AimStockOffset = FVector::ZeroVector;
+	float SwayMultiplier = 1.0f;
+	int32 AnimationIndex = 0;
+	FGameplayTag AnimationGameplayTag;
+	bool bUseBasePoseCorrection = false;
+};
+
+// Character and world state gathered on the game thread for NativeThreadSafeUpdateAnimation
+struct FSKGCharacterAnimFrameData
+{
+	float WorldTimeSeconds = 0.0f;
+	bool bIsLocallyControlled = false;
+	bool bIsInThirdPerson = false;
+	FRotator ControlRotation = FRotator::ZeroRotator;
+	FRotator BaseAimRotation = FRotator::ZeroRotator;
+	FRotator ActorRotation = FRotator::ZeroRotator;
+	FVector ActorRightVector = FVector::RightVector;
+	FVector MovementVelocity = FVector::ZeroVector;
+	float MovementComponentSprintSpeed = 0.0f;
+	FTransform CameraSocketTransform;
+	EAxis::Type RightHandAxis = EAxis::None;
+	FSKGLeanSettings LeanSettings;
+	float LeanSpeed = 0.0f;
+	float EndLeanSpeed = 0.0f;
+};
+
+// Procedural outputs read by the anim graph, kept for the last two procedural updates so reduced
+// rate characters can blend between them on the frames that skip the update
+struct FSKGProceduralAnimOutput
+{
+	FVector AdditiveLocation = FVector::ZeroVector;
+	FRotator AdditiveRotation = FRotator::ZeroRotator;
+	FVector RecoilLocation = FVector::ZeroVector;
+	FRotator RecoilRotation = FRotator::ZeroRotator;
+	FVector SightLocation = FVector::ZeroVector;
+	FRotator SightRotation = FRotator::ZeroRotator;
+	float AimingAlpha = 0.0f;
+	FVector AimCurveLocation = FVector::ZeroVector;
+	FRotator AimCurveRotation = FRotator::ZeroRotator;
+	float AimCurveAlpha = 0.0f;
+	FVector RelativeToHandLocation = FVector::ZeroVector;
+	FRotator RelativeToHandRotation = FRotator::ZeroRotator;
+};
+
+// A setter call from gameplay code. The setters only queue these, NativeUpdateAnimation applies them in call order
+// before the thread safe update runs so it never sees the state they write change under it
+struct FSKGPendingAnimInput
+{
+	enum class EType : uint8
+	{
+		Aiming,
+		HeadAiming,
+		CycledSights,
+		ShakeCurve,
+		CustomCurve,
+		Leaning,
+		FirearmPose,
+		Reloading,
+		Recoil,
+		FreeLook
+	};
+
+	EType Type = EType::Aiming;
+	bool bValue = false;
+	float Value = 0.0f;
+	// Shots fired since the last update, recoil is the only input that accumulates instead of replacing
+	int32 Count = 0;
+	ESKGFirearmPose Pose = ESKGFirearmPose::None;
+	FSKGCurveData CurveData;
+};
+
 UCLASS()
 class ULTIMATEFPSFRAMEWORK_API USKGCharacterAnimInstance : public UAnimInstance
 {
 	GENERATED_BODY()
+#if WITH_DEV_AUTOMATION_TESTS
+	// Lets the automation tests drive the gather and probe steps without a skeletal mesh
+	friend struct FSKGCharacterAnimInstanceTestAccess;
+#endif
 		
 public:
 	USKGCharacterAnimInstance();
 	
 	virtual void NativeBeginPlay() override;
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 
 protected:
 	// Default gameplay tags to be used for blending between state machines (similar to index in example)
@@ -32,6 +153,10 @@ protected:
 	// If false, the tick logic will not run on a dedicated server
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGFPSFramework|Settings")
 	bool bRunOnDedicatedServer;
+	// On a dedicated server only run what moves the firearm and its muzzle/aim sockets (aim, poses, sprint, lean, spine, recoil).
+	// Sway, lag, shake, custom and aim curves, left hand IK, camera zoom and firearm collision probes are skipped
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGFPSFramework|Settings", meta = (EditCondition = "bRunOnDedicatedServer"))
+	bool bMinimalDedicatedServerUpdate;
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGFPSFramework|Settings")
 	bool bUseProceduralSpine;
 	// The right hand bone name of your character
@@ -49,6 +174,15 @@ protected:
 	// Amount to blend spine bones by (lower spine bones can bend less than upper spine bones). Make sure total value equals 1
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGFPSFramework|Settings", meta = (EditCondition = "bUseProceduralSpine", EditConditionHides))
 	TArray<float> SpineBlendPercents;
+	// Spine roll changes smaller than this (degrees) leave the spine bones untouched
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGFPSFramework|Settings", meta = (EditCondition = "bUseProceduralSpine", EditConditionHides, ClampMin = "0.0"))
+	float SpineRollTolerance;
+	// Distance the firearm collision probe start or end has to move before a new probe is issued
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGFPSFramework|Settings", meta = (ClampMin = "0.0"))
+	float FirearmCollisionProbeTolerance;
+	// Max time in seconds a firearm collision probe result is reused while the firearm is not moving
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGFPSFramework|Settings", meta = (ClampMin = "0.0"))
+	float FirearmCollisionProbeMaxInterval;
 	// Default interpolation speed for aiming
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGFPSFramework|Aiming")
 	float AimInterpolationSpeed;
@@ -190,6 +324,9 @@ protected:
 	FRotator Spine3Rotation;
 	UPROPERTY(Transient, BlueprintReadOnly, Category = "SKGFPSFramework|Default")
 	FRotator Spine4Rotation;
+	// Spine0Rotation to Spine4Rotation packed in one array, one entry per SpineBlendPercents entry
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "SKGFPSFramework|Default")
+	TArray<FRotator> SpineRotations;
 	
 	UPROPERTY(Transient, BlueprintReadOnly, Category = "SKGFPSFramework|Recoil")
 	FVector RecoilLocation;
@@ -211,7 +348,12 @@ protected:
 	float RecoilStartTime;
 	float RecoilMultiplier;
 	float ShotCounterStartTime;
+	// Index of the current shot in the burst, picks the shot randomness from RecoilPattern
 	uint8 ShotCounter;
+	// Time since the last shot that the recoil pattern has been applied up to
+	float RecoilSampleTime;
+	// Built from the held firearms recoil data on equip, kept outside the snapshot so it survives snapshot resets
+	FSKGRecoilPattern RecoilPattern;
 
 	void RecoilInterpToZero(float DeltaSeconds);
 	void RecoilInterpTo(float DeltaSeconds);
@@ -234,7 +376,8 @@ protected:
 	UPROPERTY(Transient, BlueprintReadOnly, Category = "SKGFPSFramework|Default")
 	FRotator AdditiveRotation;
 	bool bLerpingNewGraph;
-	TObjectPtr<UCurveVector> CachedMovementCurve;
+	UPROPERTY(Transient)
+	FSKGSampledCurveVector MovementSwayCurveTable;
 	
 	UPROPERTY(Transient, BlueprintReadOnly, Category = "SKGFPSFramework|Default")
 	FVector SwayLocation;
@@ -304,11 +447,20 @@ protected:
 	bool bInterpShakeCurve;
 	void InterpShakeCurve(float DeltaSeconds);
 	float ShakeCurveStartTime;
+	UPROPERTY(Transient)
+	FSKGSampledCurveVector ShakeCurveTable;
 	UPROPERTY(Transient, BlueprintReadOnly, Category = "SKGFPSFramework|Default")
 	float ShakeCurveAlpha;
 	bool bCanPlayShakeCurve;
 	
 	FRotator SpineToInterpTo;
+	static constexpr int32 MaxSpineBones = 5;
+	// SpineBlendPercents clamped to the supported spine bones, baked on begin play
+	TArray<float> SpineBoneWeights;
+	// Every spine bone only rolls, so the whole spine is driven by one interpolated roll scaled per bone
+	float SpineRoll;
+	void BakeSpineBoneWeights();
+	void ApplySpineRoll();
 
 	UPROPERTY(Transient, BlueprintReadOnly, Category = "SKGFPSFramework|Poses")
 	FVector CustomPoseLocation;
@@ -333,6 +485,17 @@ protected:
 	bool IsLocallyControlled();
 
 	FSKGCollisionSettings CurrentCollisionSettings;
+	// Async sweep used for firearm collision, results are read the frame after it is issued
+	FTraceHandle FirearmCollisionTraceHandle;
+	FTraceDatum FirearmCollisionTraceDatum;
+	FCollisionQueryParams FirearmCollisionQueryParams;
+	FHitResult FirearmCollisionProbeHitResult;
+	FVector FirearmCollisionProbeStart;
+	FVector FirearmCollisionProbeEnd;
+	float FirearmCollisionProbeTime;
+	bool bFirearmCollisionProbeHit;
+	void UpdateFirearmCollisionProbe(const FVector& Start, const FVector& End);
+	void ResetFirearmCollisionProbe();
 	/*FTransform FirearmGripOffset;
 	FTransform RelativeMuzzle;
 	float MuzzleDistanceToRoot;
@@ -349,6 +512,83 @@ protected:
 
 	void SetEssentials(float DeltaSeconds);
 	void HandleLeftHandIK();
+
+	FSKGHeldActorAnimSnapshot HeldActorSnapshot;
+	TWeakObjectPtr<AActor> SnapshotHeldActor;
+	bool bHeldActorSnapshotStale;
+	// Whether the held actor invalidates the equip data itself, other implementers have their equip getters gathered every update
+	bool bHeldActorReportsEquipChanges;
+	// Calls each held actor interface once and fills HeldActorSnapshot for this update
+	void GatherHeldActorSnapshot();
+	void GatherHeldActorEquipData();
+	// The equip data read from interface getters, without the recoil pattern and collision probe setup done on equip
+	void GatherHeldActorEquipGetters();
+	void CacheFirearmStatsMultipliers();
+	// Resamples the sway and shake curves when the held actor hands out different ones
+	void BakeCurveTables();
+	// Held firearm whose stats change notification the equip data listens to
+	TWeakObjectPtr<ASKGFirearmBase> StatsFirearm;
+	FDelegateHandle FirearmStatsChangedHandle;
+	void BindFirearmStatsChanged(AActor* NewHeldActor);
+	void OnFirearmStatsChanged(ASKGFirearmBase* Firearm);
+	// What the aim socket data was gathered against. Held actors that are not SKG firearms have no version and gather every update,
+	// as do held actors attached to anything but the right hand bone since the hand moves relative to them
+	TWeakObjectPtr<ASKGFirearm> AimSocketFirearm;
+	uint32 AimSocketVersion;
+	bool bAimSocketDataStale;
+	bool bAimSocketThirdPerson;
+	bool bAimSocketFollowsHand;
+	TWeakObjectPtr<const USceneComponent> AimSocketAttachParent;
+	FName AimSocketAttachSocket;
+	FTransform AimSocketHeldActorRelative;
+	bool IsAimSocketDataStale() const;
+	void GatherAimSocketData();
+
+	// Everything the thread safe update reads from the character, gathered on the game thread
+	FSKGCharacterAnimFrameData FrameData;
+	void GatherCharacterFrameData();
+	// Set once the game thread gather ran this frame, the thread safe update is skipped otherwise
+	bool bRunThreadSafeUpdate;
+	// Results of the thread safe update that need the game thread, applied at the start of the next update
+	bool bPendingHeldActorPoseFinished;
+	FRotator PendingRecoilControlRotation;
+	void ApplyThreadSafeResults();
+	// Setter calls made since the last update, at most one entry per input type so it stays bounded while the mesh is not updating
+	TArray<FSKGPendingAnimInput, TInlineAllocator<4>> PendingInputs;
+	FSKGPendingAnimInput& QueueInput(FSKGPendingAnimInput::EType Type);
+	void ApplyPendingInputs();
+	// The setter bodies, only called from the game thread part of the update
+	void ApplyIsAiming(bool IsAiming);
+	void ApplyHeadAiming(bool IsAiming);
+	void ApplyCycledSights();
+	void ApplyFirearmShakeCurve(bool ManuallyPlay);
+	void ApplyCustomCurve(const FSKGCurveData& INCurveData);
+	void ApplyLeaning(float TargetGraphTime);
+	void ApplyFirearmPose(ESKGFirearmPose Pose);
+	void ApplyIsReloading(bool IsReloading, float BlendAlpha);
+	void ApplyRecoil(float Multiplier, int32 NumShots);
+	void ApplyFreeLook(bool FreeLook);
+	void HandleHeldActorThreadSafe(float DeltaSeconds);
+	// Set on begin play from bMinimalDedicatedServerUpdate when running as a dedicated server
+	bool bServerMinimalUpdate;
+	void HandleHeldActorServer(float DeltaSeconds);
+
+	// Update rate tier of this character, remote characters drop tiers with distance, screen size and visibility
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "SKGFPSFramework|Significance")
+	ESKGAnimSignificance AnimSignificance;
+	FSKGAnimSignificanceSettings SignificanceSettings;
+	int32 FramesSinceProceduralUpdate;
+	// Time accumulated since the last procedural update, reduced tiers catch up with it when they run
+	float ProceduralDeltaSeconds;
+	bool bRunProceduralUpdate;
+	void UpdateAnimSignificance();
+	FSKGProceduralAnimOutput PreviousProceduralOutput;
+	FSKGProceduralAnimOutput CurrentProceduralOutput;
+	// The graph outputs hold a blend rather than the procedural state, CurrentProceduralOutput is put back before the next update
+	bool bProceduralOutputBlended;
+	void CaptureProceduralOutput(FSKGProceduralAnimOutput& Output) const;
+	void ApplyProceduralOutput(const FSKGProceduralAnimOutput& Output);
+	void BlendProceduralOutput(float Alpha);
 	
 public:
 	UFUNCTION(BlueprintCallable, Category = "SKGFPSFramework|Aiming")
@@ -401,6 +641,12 @@ public:
 	void EnableLeftHandTwoBoneIK(bool Enable) { Enable ? LeftHandTwoBoneIKAlpha = 1.0f : LeftHandTwoBoneIKAlpha = 0.0f; }
 
 	void SetCharacterComponent(USKGCharacterComponent* INCharacterComponent) { CharacterComponent = INCharacterComponent;}
+	// Forces the equip data of the held actor (stats, sights, stock, sway/shake curves, recoil) to be gathered again next update. Call when attachments, curves or recoil data change
+	UFUNCTION(BlueprintCallable, Category = "SKGFPSFramework|Animation")
+	void InvalidateHeldActorCache() { bHeldActorSnapshotStale = true; }
+	const FSKGHeldActorAnimSnapshot& GetHeldActorSnapshot() const { return HeldActorSnapshot; }
+	UFUNCTION(BlueprintPure, Category = "SKGFPSFramework|Significance")
+	ESKGAnimSignificance GetAnimSignificance() const { return AnimSignificance; }
 
 	void SetFreeLook(bool FreeLook);
 };
@@ -6,15 +6,16 @@
 #include "Components/SKGAttachmentPreviewStatic.h"
 #include "Components/SKGAttachmentPreviewSkeletal.h"
 #include "Misc/PDA_AttachmentCompatibility.h"
+#include "Misc/PDA_AttachmentMetadata.h"
 #include "Misc/SKGAttachmentFunctionLibrary.h"
 #include "Misc/SKGAttachmentDefaultFunctions.h"
+#include "SKGAttachmentActor.h"
+#include "SKGAttachmentPoolWorldSubsystem.h"
 
 #include "Components/StaticMeshComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/SKGAttachmentManager.h"
 #include "Engine/AssetManager.h"
-#include "Engine/SimpleConstructionScript.h"
-#include "Engine/SCS_Node.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Misc/SKGAttachmentDeveloperSettings.h"
 #include "Net/UnrealNetwork.h"
@@ -42,6 +43,9 @@ USKGAttachmentComponent::USKGAttachmentComponent()
 	bSetAttachmentInitialOffsetAtDisplayMinMax = false;
 	bSetInitialOffset = false;
 	OffsetSnapDistance = 0.0f;
+	CachedRailStart = FVector::ZeroVector;
+	CachedRailEnd = FVector::ZeroVector;
+	bRailDataCached = false;
 
 	PreviewStatic = CreateDefaultSubobject<USKGAttachmentPreviewStatic>(TEXT("PreviewStaticMesh"));
 	
@@ -171,6 +175,8 @@ void USKGAttachmentComponent::OnAssetsLoaded(TSoftClassPtr<AActor> AttachmentSof
 
 void USKGAttachmentComponent::OnRep_Attachment()
 {
+	// Snap direction depends on whether the new attachment moves inverted
+	bRailDataCached = false;
 	if (IsValid(Attachment) && Attachment->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
 	{
 		ISKGAttachmentInterface::Execute_SetMinMaxOffset(Attachment, Minimum, Maximum);
@@ -210,6 +216,15 @@ USKGAttachmentManager* USKGAttachmentComponent::GetAttachmentManager()
 	return AttachmentManager.Get();
 }
 
+void USKGAttachmentComponent::InvalidateAttachmentManager()
+{
+	AttachmentManager.Reset();
+	if (ASKGAttachmentActor* AttachmentActor = Cast<ASKGAttachmentActor>(Attachment))
+	{
+		AttachmentActor->InvalidateOwningAttachmentManager();
+	}
+}
+
 void USKGAttachmentComponent::SetPreviewPositions()
 {
 	if (PreviewSkeletal && PreviewStatic)
@@ -278,27 +293,13 @@ void USKGAttachmentComponent::PostEditChangeProperty(FPropertyChangedEvent& Prop
 	{
 		if (PreviewStatic && PreviewSkeletal)
 		{
-			if (UActorComponent* ActorComponent = GetMeshComponentFromAttachment())
-			{
-				UE_LOG(LogTemp, Warning, TEXT("FOUND VALID MESH: %s"), *GetName());
-				if (const UStaticMeshComponent* AttachmentStaticMesh = Cast<UStaticMeshComponent>(ActorComponent))
-				{
-					PreviewStatic->SetStaticMesh(AttachmentStaticMesh->GetStaticMesh());
-					PreviewStatic->SetHiddenInGame(true);
-					PreviewSkeletal->SetSkeletalMesh(nullptr);
-				}
-				else if (const USkeletalMeshComponent* AttachmentSkeletalMesh = Cast<USkeletalMeshComponent>(ActorComponent))
-				{
-					PreviewSkeletal->SetSkeletalMeshAsset(AttachmentSkeletalMesh->GetSkeletalMeshAsset());
-					PreviewSkeletal->SetHiddenInGame(true);
-					PreviewStatic->SetStaticMesh(nullptr);
-				}
-			}
-			else
-			{
-				PreviewStatic->SetStaticMesh(nullptr);
-				PreviewStatic->SetStaticMesh(nullptr);
-			}
+			UStaticMesh* AttachmentStaticMesh = nullptr;
+			USkeletalMesh* AttachmentSkeletalMesh = nullptr;
+			GetPreviewMeshFromAttachment(AttachmentStaticMesh, AttachmentSkeletalMesh);
+			PreviewStatic->SetStaticMesh(AttachmentStaticMesh);
+			PreviewSkeletal->SetSkeletalMeshAsset(AttachmentSkeletalMesh);
+			PreviewStatic->SetHiddenInGame(true);
+			PreviewSkeletal->SetHiddenInGame(true);
 		}
 	}
 	else if (PropertyName.Contains(TEXT("Preview")))
@@ -340,66 +341,48 @@ void USKGAttachmentComponent::PostInitProperties()
 	Super::PostInitProperties();
 }
 
-UActorComponent* USKGAttachmentComponent::GetMeshComponentFromAttachment() const
+TSoftClassPtr<AActor> USKGAttachmentComponent::GetDisplayAttachmentClass() const
 {
 	if (DisplayAttachmentIndex > -1)
 	{
-		int32 SelectedDisplayIndex = -1;
-		const int32 DataAssetCount = AllPossibleAttachments.Num();
-		UPDA_AttachmentCompatibility* SelectedDataAsset = nullptr;
-		if (DataAssetCount)
+		int32 AttachmentCount = 0;
+		for (const UPDA_AttachmentCompatibility* DataAsset : AllPossibleAttachments)
 		{
-			int32 AttachmentCount = 0;
-			int32 SubtractCount = 0;
-			for (UPDA_AttachmentCompatibility* DataAsset : AllPossibleAttachments)
+			if (DataAsset)
 			{
-				if (DataAsset)
+				if (DisplayAttachmentIndex < AttachmentCount + DataAsset->Attachments.Num())
 				{
-					AttachmentCount += DataAsset->Attachments.Num();
-					if (DisplayAttachmentIndex + 1 > AttachmentCount)
-					{
-					}
-					else
-					{
-						SelectedDataAsset = DataAsset;
-						SelectedDisplayIndex = (DisplayAttachmentIndex) - SubtractCount;
-
-						break;
-					}
-					SubtractCount = AttachmentCount;
-				}
-			}
-		}
-		
-		if (SelectedDataAsset && SelectedDisplayIndex > -1)
-		{
-			if (const UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(SelectedDataAsset->Attachments[SelectedDisplayIndex].ActorClass.LoadSynchronous()))
-			{
-				const TArray<USCS_Node*>& ActorBlueprintNodes = BPClass->SimpleConstructionScript->GetAllNodes();
-				UE_LOG(LogTemp, Warning, TEXT("NodeCount: %d     %s"), ActorBlueprintNodes.Num(), *GetName());
-	
-				for (const USCS_Node* Node : ActorBlueprintNodes)
-				{
-					if (Node && Node->ComponentTemplate)
-					{
-						if (Node->ComponentClass == UStaticMeshComponent::StaticClass() || Node->ComponentClass == USkeletalMeshComponent::StaticClass())
-						{
-							if (const USKGAttachmentDeveloperSettings* Settings = GetDefault<USKGAttachmentDeveloperSettings>())
-							{
-								if (Node->ComponentTemplate->ComponentHasTag(Settings->AttachmentMeshTag))
-								{
-									return Node->ComponentTemplate;
-								}
-							}
-						}
-					}
+					return DataAsset->Attachments[DisplayAttachmentIndex - AttachmentCount].ActorClass;
 				}
+				AttachmentCount += DataAsset->Attachments.Num();
 			}
 		}
 	}
 	return nullptr;
 }
 
+bool USKGAttachmentComponent::GetPreviewMeshFromAttachment(UStaticMesh*& OutStaticMesh, USkeletalMesh*& OutSkeletalMesh) const
+{
+	OutStaticMesh = nullptr;
+	OutSkeletalMesh = nullptr;
+	
+	const TSoftClassPtr<AActor> AttachmentClass = GetDisplayAttachmentClass();
+	if (AttachmentClass.IsNull())
+	{
+		return false;
+	}
+
+	// Only the mesh gets loaded when the class has metadata, otherwise fall back to loading the class and reading it directly
+	FSKGAttachmentMetadata Metadata;
+	if (!USKGAttachmentFunctionLibrary::GetAttachmentMetadata(AttachmentClass, Metadata))
+	{
+		UPDA_AttachmentMetadata::BuildMetadata(AttachmentClass.LoadSynchronous(), Metadata);
+	}
+	OutStaticMesh = Metadata.StaticMesh.LoadSynchronous();
+	OutSkeletalMesh = OutStaticMesh ? nullptr : Metadata.SkeletalMesh.LoadSynchronous();
+	return OutStaticMesh || OutSkeletalMesh;
+}
+
 int32 USKGAttachmentComponent::GetEditorAttachmentCurrentSnapPointIndex() const
 {
 	const float Clamped = FMath::Clamp(DisplayAttachmentMinMax, Minimum, Maximum);
@@ -617,6 +600,10 @@ void USKGAttachmentComponent::ClearCurrentAttachment()
 	{
 		if (IsValid(Attachment))
 		{
+			if (ASKGAttachmentActor* AttachmentActor = Cast<ASKGAttachmentActor>(Attachment))
+			{
+				AttachmentActor->InvalidateOwningAttachmentManager();
+			}
 			ISKGAttachmentInterface::Execute_OnAttachmentRemoved(Attachment);
 			Attachment = nullptr;
 			MARK_PROPERTY_DIRTY_FROM_NAME(USKGAttachmentComponent, Attachment, this);
@@ -674,49 +661,71 @@ FVector USKGAttachmentComponent::GetMaxOffsetLocation() const
 	return EndLocation;
 }
 
-TArray<float> USKGAttachmentComponent::GetSnapPoints()
+void USKGAttachmentComponent::CacheRailData()
 {
-	if (CachedSnapPointOffsets.Num() == 0 && OffsetSnapDistance > 0.0f)
+	const FVector DirectionalVector = bUseRightVector ? FVector::RightVector : FVector::ForwardVector;
+	CachedRailStart = DirectionalVector * Minimum;
+	CachedRailEnd = DirectionalVector * Maximum;
+
+	CachedSnapPointOffsets.Reset();
+	CachedSnapPointLocations.Reset();
+	if (OffsetSnapDistance > 0.0f)
 	{
-		if (IsValid(Attachment))
-		{
-			const uint8 ElementCount = (IsMovementInverted() ? -Minimum : Maximum) / OffsetSnapDistance;
+		const uint8 ElementCount = (IsMovementInverted() ? -Minimum : Maximum) / OffsetSnapDistance;
 
-			CachedSnapPointOffsets.Reserve(ElementCount);
-			CachedSnapPointOffsets.Add(0.0f);
+		CachedSnapPointOffsets.Reserve(ElementCount + 1);
+		CachedSnapPointLocations.Reserve(ElementCount + 1);
+		CachedSnapPointOffsets.Add(0.0f);
+		CachedSnapPointLocations.Add(FVector::ZeroVector);
 			
-			float Offset = 0.0f;
-			for (uint8 i = 0; i < ElementCount; ++i)
-			{
-				Offset += IsMovementInverted() ? -OffsetSnapDistance : OffsetSnapDistance;
-				CachedSnapPointOffsets.Add(Offset);
-			}
+		float Offset = 0.0f;
+		for (uint8 i = 0; i < ElementCount; ++i)
+		{
+			Offset += IsMovementInverted() ? -OffsetSnapDistance : OffsetSnapDistance;
+			CachedSnapPointOffsets.Add(Offset);
+			CachedSnapPointLocations.Add(DirectionalVector * Offset);
 		}
 	}
+	bRailDataCached = true;
+}
 
+const TArray<float>& USKGAttachmentComponent::GetCachedSnapPoints()
+{
+	if (!bRailDataCached)
+	{
+		CacheRailData();
+	}
 	return CachedSnapPointOffsets;
 }
 
+TArray<float> USKGAttachmentComponent::GetSnapPoints()
+{
+	return GetCachedSnapPoints();
+}
+
 TArray<FVector> USKGAttachmentComponent::GetWorldSnapPoints()
 {
-	TArray<FVector> WorldSnapPointOffsets;
+	GetCachedSnapPoints();
 	
-	if (OffsetSnapDistance > 0.0f)
+	TArray<FVector> WorldSnapPointOffsets;
+	WorldSnapPointOffsets.Reserve(CachedSnapPointLocations.Num());
+	const FTransform& ComponentTransform = GetComponentTransform();
+	for (const FVector& PointLocation : CachedSnapPointLocations)
 	{
-		GetSnapPoints();
-		WorldSnapPointOffsets.Reserve(CachedSnapPointOffsets.Num());
-		const FVector DirectionalVector = bUseRightVector ? GetRightVector() : GetForwardVector();
-
-		for (const float Offset : CachedSnapPointOffsets)
-		{
-			const FVector PointLocation = GetComponentLocation() + DirectionalVector * Offset;
-			WorldSnapPointOffsets.Add(PointLocation);
-		}
+		WorldSnapPointOffsets.Add(ComponentTransform.TransformPosition(PointLocation));
 	}
-	
 	return WorldSnapPointOffsets;
 }
 
+void USKGAttachmentComponent::GetWorldRailExtents(FVector& Start, FVector& End)
+{
+	GetCachedSnapPoints();
+	
+	const FTransform& ComponentTransform = GetComponentTransform();
+	Start = ComponentTransform.TransformPosition(CachedRailStart);
+	End = ComponentTransform.TransformPosition(CachedRailEnd);
+}
+
 int32 USKGAttachmentComponent::GetAttachmentCurrentSnapPointIndex() const
 {
 	const bool bValidAttachment = IsValid(Attachment);
@@ -936,35 +945,56 @@ bool USKGAttachmentComponent::HasAttachment() const
 	return IsValid(Attachment);
 }
 
-void USKGAttachmentComponent::SetPreviewAttachment(TSubclassOf<AActor> AttachmentClass)
+void USKGAttachmentComponent::ReleasePreviewAttachment()
 {
 	if (IsValid(PreviewAttachment))
 	{
-		if (PreviewAttachment->Implements<USKGAttachmentInterface>())
+		// Preview candidates are cycled through rapidly, keep them around for reuse
+		if (USKGAttachmentPoolWorldSubsystem* AttachmentPool = GetWorld()->GetSubsystem<USKGAttachmentPoolWorldSubsystem>())
+		{
+			AttachmentPool->ReleaseAttachment(PreviewAttachment);
+		}
+		else
 		{
-			TArray<USKGAttachmentComponent*> Components = ISKGAttachmentInterface::Execute_GetAllAttachmentComponents(PreviewAttachment, true);
-			for (USKGAttachmentComponent* Component : Components)
+			// No pool in editor preview worlds
+			if (PreviewAttachment->Implements<USKGAttachmentInterface>())
 			{
-				if (Component && Component->GetAttachment())
+				for (const USKGAttachmentComponent* AttachmentComponent : ISKGAttachmentInterface::Execute_GetAllAttachmentComponents(PreviewAttachment, true))
 				{
-					Component->GetAttachment()->Destroy();
+					if (AttachmentComponent && IsValid(AttachmentComponent->GetAttachment()))
+					{
+						AttachmentComponent->GetAttachment()->Destroy();
+					}
 				}
 			}
+			PreviewAttachment->Destroy();
 		}
-		
-		PreviewAttachment->Destroy();
 	}
+	PreviewAttachment = nullptr;
+}
+
+void USKGAttachmentComponent::SetPreviewAttachment(TSubclassOf<AActor> AttachmentClass)
+{
+	ReleasePreviewAttachment();
 
 	if (AttachmentClass)
 	{
-		PreviewAttachment = GetWorld()->SpawnActorDeferred<AActor>(AttachmentClass, FTransform(), GetOwner());
+		if (USKGAttachmentPoolWorldSubsystem* AttachmentPool = GetWorld()->GetSubsystem<USKGAttachmentPoolWorldSubsystem>())
+		{
+			PreviewAttachment = AttachmentPool->AcquireAttachment(AttachmentClass, GetOwner(), GetComponentTransform());
+		}
+		else
+		{
+			PreviewAttachment = GetWorld()->SpawnActorDeferred<AActor>(AttachmentClass, FTransform(), GetOwner());
+			if (PreviewAttachment)
+			{
+				PreviewAttachment->SetReplicates(false);
+				UGameplayStatics::FinishSpawningActor(PreviewAttachment, GetComponentTransform());
+			}
+		}
 		
 		if (PreviewAttachment)
 		{
-			PreviewAttachment->SetReplicates(false);
-			const FTransform SpawnTransform = GetComponentTransform();
-			UGameplayStatics::FinishSpawningActor(PreviewAttachment, SpawnTransform);
-		
 			FAttachmentTransformRules TransformRules(FAttachmentTransformRules::KeepWorldTransform);
 			TransformRules.bWeldSimulatedBodies = bWeldAttachment;
 			PreviewAttachment->AttachToComponent(this, TransformRules);
@@ -987,22 +1017,7 @@ void USKGAttachmentComponent::SetPreviewAttachment(TSubclassOf<AActor> Attachmen
 
 void USKGAttachmentComponent::ClearPreviewAttachment()
 {
-	if (IsValid(PreviewAttachment))
-	{
-		if (PreviewAttachment->Implements<USKGAttachmentInterface>())
-		{
-			TArray<USKGAttachmentComponent*> Components = ISKGAttachmentInterface::Execute_GetAllAttachmentComponents(PreviewAttachment, true);
-			for (USKGAttachmentComponent* Component : Components)
-			{
-				if (Component && Component->GetAttachment())
-				{
-					Component->GetAttachment()->Destroy();
-				}
-			}
-		}
-		
-		PreviewAttachment->Destroy();
-	}
+	ReleasePreviewAttachment();
 
 	if (Attachment && Attachment->IsHidden())
 	{
@@ -0,0 +1,199 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+
+#include "Misc/PDA_AttachmentMetadata.h"
+
+const FPrimaryAssetType UPDA_AttachmentMetadata::PrimaryAssetType = TEXT("SKGAttachmentMetadata");
+
+#if WITH_EDITOR
+#include "Components/SKGAttachmentComponent.h"
+#include "Misc/SKGAttachmentDeveloperSettings.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshSocket.h"
+#include "Misc/DataValidation.h"
+
+#define LOCTEXT_NAMESPACE "PDA_AttachmentMetadata"
+
+namespace SKGAttachmentMetadata
+{
+	struct FComponentTemplate
+	{
+		const UActorComponent* Component;
+		FTransform ActorSpaceTransform;
+	};
+
+	FTransform GetNodeTransform(const USimpleConstructionScript* SCS, const USCS_Node* Node)
+	{
+		FTransform Transform = FTransform::Identity;
+		for (int32 i = 0; i < 32 && Node; ++i)
+		{
+			if (const USceneComponent* SceneComponent = Cast<USceneComponent>(Node->ComponentTemplate))
+			{
+				Transform = Transform * SceneComponent->GetRelativeTransform();
+			}
+			Node = SCS->FindParentNode(Node);
+		}
+		return Transform;
+	}
+
+	void GatherComponentTemplates(const UClass* AttachmentClass, TArray<FComponentTemplate>& OutTemplates)
+	{
+		TInlineComponentArray<UActorComponent*> NativeComponents;
+		AttachmentClass->GetDefaultObject<AActor>()->GetComponents(NativeComponents);
+		for (const UActorComponent* Component : NativeComponents)
+		{
+			// Defaults are not registered so build the transform from the attach chain set up in the constructor
+			FTransform Transform = FTransform::Identity;
+			const USceneComponent* SceneComponent = Cast<USceneComponent>(Component);
+			for (int32 i = 0; i < 32 && SceneComponent; ++i)
+			{
+				Transform = Transform * SceneComponent->GetRelativeTransform();
+				SceneComponent = SceneComponent->GetAttachParent();
+			}
+			OutTemplates.Add({ Component, Transform });
+		}
+
+		for (const UBlueprintGeneratedClass* BPClass = Cast<UBlueprintGeneratedClass>(AttachmentClass); BPClass; BPClass = Cast<UBlueprintGeneratedClass>(BPClass->GetSuperClass()))
+		{
+			if (const USimpleConstructionScript* SCS = BPClass->SimpleConstructionScript)
+			{
+				for (const USCS_Node* Node : SCS->GetAllNodes())
+				{
+					if (Node && Node->ComponentTemplate)
+					{
+						OutTemplates.Add({ Node->ComponentTemplate, GetNodeTransform(SCS, Node) });
+					}
+				}
+			}
+		}
+	}
+}
+
+bool UPDA_AttachmentMetadata::BuildMetadata(const UClass* AttachmentClass, FSKGAttachmentMetadata& OutMetadata)
+{
+	OutMetadata = FSKGAttachmentMetadata();
+	if (!AttachmentClass || !AttachmentClass->IsChildOf(AActor::StaticClass()) || AttachmentClass->HasAnyClassFlags(CLASS_Abstract | CLASS_NewerVersionExists))
+	{
+		return false;
+	}
+
+	TArray<SKGAttachmentMetadata::FComponentTemplate> Templates;
+	SKGAttachmentMetadata::GatherComponentTemplates(AttachmentClass, Templates);
+	
+	const FName AttachmentMeshTag = GetDefault<USKGAttachmentDeveloperSettings>()->AttachmentMeshTag;
+	bool bFoundMesh = false;
+	for (const SKGAttachmentMetadata::FComponentTemplate& Template : Templates)
+	{
+		if (!bFoundMesh && Template.Component->ComponentHasTag(AttachmentMeshTag))
+		{
+			if (const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Template.Component))
+			{
+				if (UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh())
+				{
+					bFoundMesh = true;
+					OutMetadata.StaticMesh = StaticMesh;
+					OutMetadata.Bounds = StaticMesh->GetBounds().GetBox().TransformBy(Template.ActorSpaceTransform);
+					for (const UStaticMeshSocket* Socket : StaticMesh->Sockets)
+					{
+						if (Socket)
+						{
+							OutMetadata.SocketNames.Add(Socket->SocketName);
+						}
+					}
+				}
+			}
+			else if (const USkeletalMeshComponent* SkeletalMeshComponent = Cast<USkeletalMeshComponent>(Template.Component))
+			{
+				if (USkeletalMesh* SkeletalMesh = SkeletalMeshComponent->GetSkeletalMeshAsset())
+				{
+					bFoundMesh = true;
+					OutMetadata.SkeletalMesh = SkeletalMesh;
+					OutMetadata.Bounds = SkeletalMesh->GetBounds().GetBox().TransformBy(Template.ActorSpaceTransform);
+					for (const USkeletalMeshSocket* Socket : SkeletalMesh->GetActiveSocketList())
+					{
+						if (Socket)
+						{
+							OutMetadata.SocketNames.Add(Socket->SocketName);
+						}
+					}
+				}
+			}
+		}
+		
+		if (const USKGAttachmentComponent* AttachmentComponent = Cast<USKGAttachmentComponent>(Template.Component))
+		{
+			FSKGAttachmentComponentMetadata& ComponentMetadata = OutMetadata.AttachmentComponents.AddDefaulted_GetRef();
+			ComponentMetadata.ComponentName = AttachmentComponent->GetComponentName();
+			ComponentMetadata.MinMaxOffset = AttachmentComponent->GetMinMaxOffset();
+			ComponentMetadata.OffsetSnapDistance = AttachmentComponent->GetOffsetSnapDistance();
+			ComponentMetadata.SnapPoints = AttachmentComponent->GetEditorSnapDistancePoints();
+		}
+	}
+	
+	return bFoundMesh || OutMetadata.AttachmentComponents.Num() > 0;
+}
+
+bool UPDA_AttachmentMetadata::UpdateMetadata(const UClass* AttachmentClass)
+{
+	const TSoftClassPtr<AActor> SoftAttachmentClass = TSoftClassPtr<AActor>(FSoftObjectPath(AttachmentClass));
+	FSKGAttachmentMetadata NewMetadata;
+	if (!BuildMetadata(AttachmentClass, NewMetadata))
+	{
+		if (Metadata.Contains(SoftAttachmentClass))
+		{
+			Modify();
+			Metadata.Remove(SoftAttachmentClass);
+			return true;
+		}
+		return false;
+	}
+
+	const FSKGAttachmentMetadata* ExistingMetadata = Metadata.Find(SoftAttachmentClass);
+	if (ExistingMetadata && *ExistingMetadata == NewMetadata)
+	{
+		return false;
+	}
+	Modify();
+	Metadata.Add(SoftAttachmentClass, MoveTemp(NewMetadata));
+	return true;
+}
+
+EDataValidationResult UPDA_AttachmentMetadata::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+	for (const TPair<TSoftClassPtr<AActor>, FSKGAttachmentMetadata>& Entry : Metadata)
+	{
+		const FSKGAttachmentMetadata& AttachmentMetadata = Entry.Value;
+		if (Entry.Key.IsNull() || !Entry.Key.LoadSynchronous())
+		{
+			Context.AddError(FText::Format(LOCTEXT("MissingClass", "Attachment class {0} no longer exists, recompile or remove it"), FText::FromString(Entry.Key.ToString())));
+			Result = EDataValidationResult::Invalid;
+			continue;
+		}
+		
+		FSKGAttachmentMetadata CurrentMetadata;
+		BuildMetadata(Entry.Key.Get(), CurrentMetadata);
+		if (!(CurrentMetadata == AttachmentMetadata))
+		{
+			Context.AddError(FText::Format(LOCTEXT("StaleMetadata", "Metadata for {0} is out of date, recompile the blueprint"), FText::FromString(Entry.Key.ToString())));
+			Result = EDataValidationResult::Invalid;
+		}
+	}
+	
+	if (Result == EDataValidationResult::NotValidated)
+	{
+		Result = EDataValidationResult::Valid;
+	}
+	return Result;
+}
+
+#undef LOCTEXT_NAMESPACE
+#endif
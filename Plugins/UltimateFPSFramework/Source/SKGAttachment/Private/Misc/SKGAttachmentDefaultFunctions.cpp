@@ -9,7 +9,7 @@ void USKGAttachmentDefaultFunctions::OnAttachmentUpdated(USKGAttachmentComponent
 {
 	if (OwningAttachmentComponent && OwningAttachmentComponent->GetAttachmentManager())
 	{
-		OwningAttachmentComponent->GetAttachmentManager()->HandleCachingAttachmentComponents();
+		OwningAttachmentComponent->GetAttachmentManager()->UpdateAttachmentCache(OwningAttachmentComponent);
 	}
 }
 
@@ -5,6 +5,8 @@
 #include "Components/SKGAttachmentManager.h"
 #include "Interfaces/SKGAttachmentInterface.h"
 #include "Components/SKGAttachmentComponent.h"
+#include "SKGAttachmentActor.h"
+#include "SKGAttachmentMeshMergeWorldSubsystem.h"
 
 #include "JsonObjectConverter.h"
 #include "HAL/FileManagerGeneric.h"
@@ -12,39 +14,303 @@
 #include "Misc/Paths.h"
 #include "Kismet/GameplayStatics.h"
 #include "Misc/SKGAttachmentDeveloperSettings.h"
+#include "Misc/PDA_AttachmentMetadata.h"
+#include "Misc/Compression.h"
+#include "Engine/AssetManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/StrongObjectPtr.h"
+
+DECLARE_CYCLE_STAT(TEXT("DeserializeAttachmentJson"), STAT_SKGDeserializeAttachmentJson, STATGROUP_SKGAttachment);
+DECLARE_CYCLE_STAT(TEXT("DeserializeAttachmentBinary"), STAT_SKGDeserializeAttachmentBinary, STATGROUP_SKGAttachment);
+DECLARE_CYCLE_STAT(TEXT("ConstructAttachmentParent"), STAT_SKGConstructAttachmentParent, STATGROUP_SKGAttachment);
+DECLARE_DWORD_COUNTER_STAT(TEXT("OwningAttachmentManagerWalks"), STAT_SKGOwningAttachmentManagerWalks, STATGROUP_SKGAttachment);
 
 int32 USKGAttachmentFunctionLibrary::MaxAttachmentStack = 10;
 
-USKGAttachmentManager* USKGAttachmentFunctionLibrary::GetOwningAttachmentManager(AActor* Actor)
+namespace SKGAttachmentPreset
 {
-	USKGAttachmentManager* AttachmentManager = nullptr;
-	if (IsValid(Actor))
+	// Reads "SGKP" in file order (little endian), kept as is so existing presets still load
+	constexpr uint32 MagicNumber = 0x504B4753;
+	// zlib cannot expand data by more than about 1032:1, anything claiming more is corrupt
+	constexpr int64 MaxCompressionRatio = 1032;
+	// Far above any real preset, stops a corrupt or hostile size from allocating gigabytes
+	constexpr int32 MaxUncompressedSize = 16 * 1024 * 1024;
+	enum EVersion : uint16
 	{
-		TArray<USKGAttachmentManager*> AttachmentManagers;
-		Actor->GetComponents<USKGAttachmentManager>(AttachmentManagers);
-		if (AttachmentManagers.Num() && IsValid(AttachmentManagers[0]))
+		Initial = 1,
+		// Add new versions above this line
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+	enum EFlags : uint16
+	{
+		None = 0,
+		Compressed = 1 << 0
+	};
+
+	int32 AddToStringTable(TArray<FString>& StringTable, const FString& String)
+	{
+		if (String.IsEmpty())
 		{
-			AttachmentManager = AttachmentManagers[0];
+			return INDEX_NONE;
 		}
-		else
+		return StringTable.AddUnique(String);
+	}
+
+	int32 AddClassToStringTable(TArray<FString>& StringTable, const UClass* Class)
+	{
+		return Class ? AddToStringTable(StringTable, Class->GetPathName()) : INDEX_NONE;
+	}
+
+	// Fails the archive when the bytes left cannot hold Num elements, so a corrupt count is rejected before it is allocated
+	bool CanReadCount(FArchive& Ar, int32 Num, int64 MinElementSize)
+	{
+		if (Ar.IsError() || Num < 0 || Num * MinElementSize > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return false;
+		}
+		return true;
+	}
+
+	// Construction matches components by ComponentNameHash. The name is kept next to it so a binary preset converts
+	// back to json without loss and the hash can be checked against it when read
+	struct FEntry
+	{
+		uint32 ComponentNameHash = 0;
+		int32 ComponentNameIndex = INDEX_NONE;
+		int32 ParentRootActorIndex = INDEX_NONE;
+		int32 ParentAttachmentIndex = INDEX_NONE;
+		int32 AttachmentIndex = INDEX_NONE;
+		float AttachmentOffset = 0.0f;
+
+		friend FArchive& operator<<(FArchive& Ar, FEntry& Entry)
+		{
+			Ar << Entry.ComponentNameHash;
+			Ar << Entry.ComponentNameIndex;
+			Ar << Entry.ParentRootActorIndex;
+			Ar << Entry.ParentAttachmentIndex;
+			Ar << Entry.AttachmentIndex;
+			Ar << Entry.AttachmentOffset;
+			return Ar;
+		}
+	};
+	constexpr int64 EntrySerializedSize = sizeof(uint32) + sizeof(int32) * 4 + sizeof(float);
+
+	// Header is never compressed, everything after it is optionally zlib compressed
+	struct FBody
+	{
+		TArray<FString> StringTable;
+		int32 AttachmentClassIndex = INDEX_NONE;
+		TArray<FEntry> Entries;
+
+		friend FArchive& operator<<(FArchive& Ar, FBody& Body)
 		{
-			AActor* CurrentOwner = Actor;
-			for (uint8 i = 0; i < MaxAttachmentStack; ++i)
+			if (!Ar.IsLoading())
 			{
-				if (IsValid(CurrentOwner))
+				Ar << Body.StringTable;
+				Ar << Body.AttachmentClassIndex;
+				Ar << Body.Entries;
+				return Ar;
+			}
+
+			// Same layout as the TArray operators, with every count checked before anything is allocated
+			int32 NumStrings = 0;
+			Ar << NumStrings;
+			if (!CanReadCount(Ar, NumStrings, sizeof(int32)))
+			{
+				return Ar;
+			}
+			Body.StringTable.SetNum(NumStrings);
+			for (FString& String : Body.StringTable)
+			{
+				// Negative lengths are wide strings, both are checked here so a bad length fails quietly instead of through the FString operator
+				const int64 LengthOffset = Ar.Tell();
+				int32 Length = 0;
+				Ar << Length;
+				if (Length == MIN_int32 || !CanReadCount(Ar, FMath::Abs(Length), Length < 0 ? sizeof(UTF16CHAR) : sizeof(ANSICHAR)))
 				{
-					CurrentOwner = CurrentOwner->GetOwner();
-					if (IsValid(CurrentOwner))
-					{
-						CurrentOwner->GetComponents<USKGAttachmentManager>(AttachmentManagers);
-						if (AttachmentManagers.Num() && IsValid(AttachmentManagers[0]))
-						{
-							AttachmentManager = AttachmentManagers[0];
-							break;
-						}
-					}
+					Ar.SetError();
+					return Ar;
 				}
-			}	
+				Ar.Seek(LengthOffset);
+				Ar << String;
+				if (Ar.IsError())
+				{
+					return Ar;
+				}
+			}
+			Ar << Body.AttachmentClassIndex;
+
+			int32 NumEntries = 0;
+			Ar << NumEntries;
+			if (!CanReadCount(Ar, NumEntries, EntrySerializedSize))
+			{
+				return Ar;
+			}
+			Body.Entries.SetNum(NumEntries);
+			for (FEntry& Entry : Body.Entries)
+			{
+				Ar << Entry;
+			}
+			return Ar;
+		}
+	};
+
+	bool ReadBody(const TArray<uint8>& BinaryPreset, FBody& OutBody, FString& Error)
+	{
+		FMemoryReader Reader(BinaryPreset);
+		uint32 PresetMagic = 0;
+		uint16 Version = 0;
+		uint16 Flags = EFlags::None;
+		int32 UncompressedSize = 0;
+		Reader << PresetMagic;
+		Reader << Version;
+		Reader << Flags;
+		Reader << UncompressedSize;
+		if (Reader.IsError() || PresetMagic != MagicNumber)
+		{
+			Error = "Data is NOT a binary attachment preset";
+			return false;
+		}
+		if (Version == 0)
+		{
+			Error = "Binary attachment preset has an invalid version";
+			return false;
+		}
+		if (Version > EVersion::Latest)
+		{
+			Error = FString::Printf(TEXT("Binary attachment preset version %d is newer than supported version %d"), Version, static_cast<int32>(EVersion::Latest));
+			return false;
+		}
+
+		const int32 PayloadOffset = Reader.Tell();
+		const int32 PayloadSize = BinaryPreset.Num() - PayloadOffset;
+		TArray<uint8> BodyBytes;
+		if (Flags & EFlags::Compressed)
+		{
+			if (UncompressedSize <= 0 || UncompressedSize > MaxUncompressedSize || PayloadSize <= 0 || UncompressedSize > PayloadSize * MaxCompressionRatio)
+			{
+				Error = "Binary attachment preset has an invalid size";
+				return false;
+			}
+			BodyBytes.SetNumUninitialized(UncompressedSize);
+			if (!FCompression::UncompressMemory(NAME_Zlib, BodyBytes.GetData(), UncompressedSize, BinaryPreset.GetData() + PayloadOffset, PayloadSize))
+			{
+				Error = "Could NOT decompress binary attachment preset";
+				return false;
+			}
+		}
+		else
+		{
+			if (PayloadSize <= 0 || PayloadSize > MaxUncompressedSize)
+			{
+				Error = "Binary attachment preset has an invalid size";
+				return false;
+			}
+			BodyBytes.Append(BinaryPreset.GetData() + PayloadOffset, PayloadSize);
+		}
+
+		FMemoryReader BodyReader(BodyBytes);
+		// FString lengths are checked against this, no string can be longer than the body holding it
+		BodyReader.ArMaxSerializeSize = BodyBytes.Num();
+		BodyReader << OutBody;
+		if (BodyReader.IsError() || !BodyReader.AtEnd())
+		{
+			Error = "Binary attachment preset is corrupt";
+			return false;
+		}
+		for (const FEntry& Entry : OutBody.Entries)
+		{
+			if (OutBody.StringTable.IsValidIndex(Entry.ComponentNameIndex) && Entry.ComponentNameHash != USKGAttachmentFunctionLibrary::HashComponentName(OutBody.StringTable[Entry.ComponentNameIndex]))
+			{
+				Error = "Binary attachment preset is corrupt";
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// String table indices that hold class paths (the rest are component names)
+	TSet<int32> GetClassIndices(const FBody& Body)
+	{
+		TSet<int32> ClassIndices;
+		ClassIndices.Reserve(Body.Entries.Num() + 1);
+		auto AddIndex = [&](int32 Index)
+		{
+			if (Body.StringTable.IsValidIndex(Index))
+			{
+				ClassIndices.Add(Index);
+			}
+		};
+		AddIndex(Body.AttachmentClassIndex);
+		for (const FEntry& Entry : Body.Entries)
+		{
+			AddIndex(Entry.ParentRootActorIndex);
+			AddIndex(Entry.ParentAttachmentIndex);
+			AddIndex(Entry.AttachmentIndex);
+		}
+		return ClassIndices;
+	}
+
+	const FString& GetString(const TArray<FString>& StringTable, int32 Index)
+	{
+		static const FString Empty;
+		return StringTable.IsValidIndex(Index) ? StringTable[Index] : Empty;
+	}
+
+	UClass* GetResolvedClass(const TArray<UClass*>& ResolvedClasses, int32 Index)
+	{
+		return ResolvedClasses.IsValidIndex(Index) ? ResolvedClasses[Index] : nullptr;
+	}
+
+	// Null means the entry can go on a component of any owner
+	const UClass* GetAttachListOwnerClass(const FSKGAttachmentAttachList& AttachmentList)
+	{
+		return AttachmentList.ParentRootActor ? AttachmentList.ParentRootActor.Get() : AttachmentList.ParentAttachment.Get();
+	}
+
+	uint32 GetAttachListEntryKey(uint32 ComponentHash, const UClass* OwnerClass)
+	{
+		return HashCombine(ComponentHash, GetTypeHash(OwnerClass));
+	}
+}
+
+USKGAttachmentManager* USKGAttachmentFunctionLibrary::GetOwningAttachmentManager(AActor* Actor)
+{
+	if (ASKGAttachmentActor* AttachmentActor = Cast<ASKGAttachmentActor>(Actor))
+	{
+		return AttachmentActor->GetOwningAttachmentManager();
+	}
+	return WalkOwningAttachmentManager(Actor);
+}
+
+USKGAttachmentManager* USKGAttachmentFunctionLibrary::WalkOwningAttachmentManager(AActor* Actor)
+{
+	USKGAttachmentManager* AttachmentManager = nullptr;
+	if (IsValid(Actor))
+	{
+		INC_DWORD_STAT(STAT_SKGOwningAttachmentManagerWalks);
+		AActor* CurrentOwner = Actor;
+		for (int32 i = 0; i <= MaxAttachmentStack && IsValid(CurrentOwner); ++i)
+		{
+			AttachmentManager = CurrentOwner->FindComponentByClass<USKGAttachmentManager>();
+			if (IsValid(AttachmentManager))
+			{
+				break;
+			}
+			AttachmentManager = nullptr;
+			CurrentOwner = CurrentOwner->GetOwner();
 		}
 	}
 	
@@ -131,6 +397,148 @@ void USKGAttachmentFunctionLibrary::PrintError(const UObject* WorldObject, const
 #endif
 }
 
+uint32 USKGAttachmentFunctionLibrary::HashComponentName(const FString& ComponentName)
+{
+	return FCrc::StrCrc32(*ComponentName);
+}
+
+uint32 USKGAttachmentFunctionLibrary::GetAttachListComponentHash(const FSKGAttachmentAttachList& AttachmentList)
+{
+	return AttachmentList.ComponentNameHash != 0 ? AttachmentList.ComponentNameHash : HashComponentName(AttachmentList.ComponentName);
+}
+
+TMap<uint32, TArray<int32>> USKGAttachmentFunctionLibrary::CreateAttachListEntryMap(const TArray<FSKGAttachmentAttachList>& AttachmentList)
+{
+	TMap<uint32, TArray<int32>> EntryMap;
+	EntryMap.Reserve(AttachmentList.Num());
+	for (int32 i = 0; i < AttachmentList.Num(); ++i)
+	{
+		const uint32 Key = SKGAttachmentPreset::GetAttachListEntryKey(GetAttachListComponentHash(AttachmentList[i]), SKGAttachmentPreset::GetAttachListOwnerClass(AttachmentList[i]));
+		EntryMap.FindOrAdd(Key).Add(i);
+	}
+	return EntryMap;
+}
+
+int32 USKGAttachmentFunctionLibrary::TakeAttachListEntry(TMap<uint32, TArray<int32>>& EntryMap, const TArray<FSKGAttachmentAttachList>& AttachmentList, const USKGAttachmentComponent* AttachmentComponent)
+{
+	const uint32 ComponentHash = HashComponentName(AttachmentComponent->GetName());
+	const UClass* OwnerClass = AttachmentComponent->GetOwner()->GetClass();
+	
+	// Entries for this exact owner class compete with entries that accept any owner, the earlier one in the preset wins
+	uint32 BestKey = 0;
+	int32 BestBucketIndex = INDEX_NONE;
+	int32 BestEntry = INDEX_NONE;
+	for (const UClass* KeyClass : { OwnerClass, static_cast<const UClass*>(nullptr) })
+	{
+		const uint32 Key = SKGAttachmentPreset::GetAttachListEntryKey(ComponentHash, KeyClass);
+		if (const TArray<int32>* Bucket = EntryMap.Find(Key))
+		{
+			// Keys are hashes, verify the entry in case of a collision
+			for (int32 i = 0; i < Bucket->Num(); ++i)
+			{
+				const int32 EntryIndex = (*Bucket)[i];
+				const FSKGAttachmentAttachList& Entry = AttachmentList[EntryIndex];
+				if (GetAttachListComponentHash(Entry) == ComponentHash && SKGAttachmentPreset::GetAttachListOwnerClass(Entry) == KeyClass)
+				{
+					if (BestEntry == INDEX_NONE || EntryIndex < BestEntry)
+					{
+						BestKey = Key;
+						BestBucketIndex = i;
+						BestEntry = EntryIndex;
+					}
+					break;
+				}
+			}
+		}
+	}
+
+	if (BestEntry != INDEX_NONE)
+	{
+		TArray<int32>& Bucket = EntryMap.FindChecked(BestKey);
+		Bucket.RemoveAt(BestBucketIndex);
+		if (Bucket.Num() == 0)
+		{
+			EntryMap.Remove(BestKey);
+		}
+	}
+	return BestEntry;
+}
+
+namespace SKGAttachmentMetadataTable
+{
+	// Loaded once per settings path, a failed load is not retried until the path changes
+	static const UPDA_AttachmentMetadata* Get()
+	{
+		const USKGAttachmentDeveloperSettings* Settings = GetDefault<USKGAttachmentDeveloperSettings>();
+		if (!Settings)
+		{
+			return nullptr;
+		}
+		
+		// Function statics so nothing is constructed before the object system is up
+		static TStrongObjectPtr<UPDA_AttachmentMetadata> Table;
+		static FSoftObjectPath LoadedPath;
+		static bool bLoadAttempted = false;
+		if (!bLoadAttempted || LoadedPath != Settings->AttachmentMetadata.ToSoftObjectPath())
+		{
+			if (!bLoadAttempted)
+			{
+				// The strong reference has to go before the object system shuts down
+				FCoreDelegates::OnPreExit.AddLambda([]() { Table.Reset(); });
+			}
+			bLoadAttempted = true;
+			LoadedPath = Settings->AttachmentMetadata.ToSoftObjectPath();
+			Table.Reset(Settings->AttachmentMetadata.LoadSynchronous());
+			if (!Table)
+			{
+				// Callers fall back to loading the attachment class which is what the table exists to avoid
+				UE_LOG(LogTemp, Warning, TEXT("Attachment metadata table '%s' could not be loaded, set it in the SKG Attachment settings and make sure it is cooked. Falling back to loading attachment classes"),
+					*LoadedPath.ToString());
+			}
+		}
+		return Table.Get();
+	}
+}
+
+bool USKGAttachmentFunctionLibrary::GetAttachmentMetadata(TSoftClassPtr<AActor> AttachmentClass, FSKGAttachmentMetadata& Metadata)
+{
+	const UPDA_AttachmentMetadata* MetadataTable = SKGAttachmentMetadataTable::Get();
+	if (!MetadataTable)
+	{
+		return false;
+	}
+	
+	if (const FSKGAttachmentMetadata* AttachmentMetadata = MetadataTable->FindMetadata(AttachmentClass))
+	{
+		Metadata = *AttachmentMetadata;
+		return true;
+	}
+	return false;
+}
+
+bool USKGAttachmentFunctionLibrary::CanMergeStaticMeshComponent(const UStaticMeshComponent* StaticMeshComponent)
+{
+	if (!IsValid(StaticMeshComponent) || !StaticMeshComponent->IsVisible() || StaticMeshComponent->IsA<UInstancedStaticMeshComponent>())
+	{
+		return false;
+	}
+	
+	const UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
+	return StaticMesh && StaticMesh->bAllowCPUAccess && StaticMesh->GetRenderData() && StaticMesh->GetRenderData()->LODResources.Num();
+}
+
+void USKGAttachmentFunctionLibrary::CreateMergedStaticMeshAsync(const FTransform& RelativeTo, const TArray<UStaticMeshComponent*>& StaticMeshComponents, FSKGOnMergedStaticMeshCreated OnCreated)
+{
+	const UWorld* World = StaticMeshComponents.Num() && IsValid(StaticMeshComponents[0]) ? StaticMeshComponents[0]->GetWorld() : nullptr;
+	USKGAttachmentMeshMergeWorldSubsystem* MeshMergeSubsystem = World ? World->GetSubsystem<USKGAttachmentMeshMergeWorldSubsystem>() : nullptr;
+	if (!MeshMergeSubsystem)
+	{
+		OnCreated.ExecuteIfBound(nullptr);
+		return;
+	}
+	MeshMergeSubsystem->CreateMergedStaticMeshAsync(RelativeTo, StaticMeshComponents, MoveTemp(OnCreated));
+}
+
 FSKGAttachmentParent USKGAttachmentFunctionLibrary::CreateAttachmentParentStruct(AActor* AttachmentParent, FString& Error)
 {
 	if (IsValid(AttachmentParent))
@@ -151,6 +559,7 @@ FSKGAttachmentParent USKGAttachmentFunctionLibrary::CreateAttachmentParentStruct
 						{
 							FSKGAttachmentAttachList AttachmentList;
 							AttachmentList.ComponentName = AttachmentComponent->GetName();
+							AttachmentList.ComponentNameHash = HashComponentName(AttachmentList.ComponentName);
 							AttachmentList.Attachment = Attachment->GetClass();
 							AttachmentList.AttachmentOffset = ISKGAttachmentInterface::Execute_GetAttachmentOffset(Attachment);
 							if (Attachment->GetOwner() == AttachmentParent)
@@ -208,6 +617,7 @@ FString USKGAttachmentFunctionLibrary::SerializeAttachmentParent(AActor* Attachm
 
 FSKGAttachmentParent USKGAttachmentFunctionLibrary::DeserializeAttachmentString(const FString& JsonString, FString& Error)
 {
+	SCOPE_CYCLE_COUNTER(STAT_SKGDeserializeAttachmentJson);
 	FSKGAttachmentParent AttachmentStruct;
 	if (FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &AttachmentStruct, 0, 0))
 	{
@@ -221,8 +631,366 @@ FSKGAttachmentParent USKGAttachmentFunctionLibrary::DeserializeAttachmentString(
 	return AttachmentStruct;
 }
 
+TArray<uint8> USKGAttachmentFunctionLibrary::SerializeAttachmentParentBinary(AActor* AttachmentParent, bool bCompress, FString& Error)
+{
+	if (!IsValid(AttachmentParent))
+	{
+		Error = "AttachmentParent INVALID";
+		return TArray<uint8>();
+	}
+	
+	const FSKGAttachmentParent AttachmentStruct = CreateAttachmentParentStruct(AttachmentParent, Error);
+	if (!Error.IsEmpty())
+	{
+		return TArray<uint8>();
+	}
+	return SerializeAttachmentStructBinary(AttachmentStruct, bCompress);
+}
+
+TArray<uint8> USKGAttachmentFunctionLibrary::SerializeAttachmentStructBinary(const FSKGAttachmentParent& AttachmentStruct, bool bCompress)
+{
+	using namespace SKGAttachmentPreset;
+	
+	FBody Body;
+	Body.AttachmentClassIndex = AddClassToStringTable(Body.StringTable, AttachmentStruct.AttachmentClass);
+	Body.Entries.Reserve(AttachmentStruct.AttachmentList.Num());
+	for (const FSKGAttachmentAttachList& AttachmentList : AttachmentStruct.AttachmentList)
+	{
+		FEntry& Entry = Body.Entries.AddDefaulted_GetRef();
+		// Written from the name when there is one so the pair always passes the check on read
+		Entry.ComponentNameHash = AttachmentList.ComponentName.IsEmpty() ? AttachmentList.ComponentNameHash : HashComponentName(AttachmentList.ComponentName);
+		Entry.ComponentNameIndex = AddToStringTable(Body.StringTable, AttachmentList.ComponentName);
+		Entry.ParentRootActorIndex = AddClassToStringTable(Body.StringTable, AttachmentList.ParentRootActor);
+		Entry.ParentAttachmentIndex = AddClassToStringTable(Body.StringTable, AttachmentList.ParentAttachment);
+		Entry.AttachmentIndex = AddClassToStringTable(Body.StringTable, AttachmentList.Attachment);
+		Entry.AttachmentOffset = AttachmentList.AttachmentOffset;
+	}
+
+	TArray<uint8> BodyBytes;
+	FMemoryWriter BodyWriter(BodyBytes);
+	BodyWriter << Body;
+
+	uint32 PresetMagic = MagicNumber;
+	uint16 Version = EVersion::Latest;
+	uint16 Flags = EFlags::None;
+	int32 UncompressedSize = BodyBytes.Num();
+	TArray<uint8> CompressedBytes;
+	if (bCompress)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+		CompressedBytes.SetNumUninitialized(CompressedSize);
+		if (FCompression::CompressMemory(NAME_Zlib, CompressedBytes.GetData(), CompressedSize, BodyBytes.GetData(), UncompressedSize) && CompressedSize < UncompressedSize)
+		{
+			CompressedBytes.SetNum(CompressedSize);
+			Flags = static_cast<uint16>(Flags | EFlags::Compressed);
+		}
+	}
+
+	TArray<uint8> BinaryPreset;
+	FMemoryWriter Writer(BinaryPreset);
+	Writer << PresetMagic;
+	Writer << Version;
+	Writer << Flags;
+	Writer << UncompressedSize;
+	if (Flags & EFlags::Compressed)
+	{
+		Writer.Serialize(CompressedBytes.GetData(), CompressedBytes.Num());
+	}
+	else
+	{
+		Writer.Serialize(BodyBytes.GetData(), BodyBytes.Num());
+	}
+	return BinaryPreset;
+}
+
+FSKGAttachmentParent USKGAttachmentFunctionLibrary::DeserializeAttachmentBinary(const TArray<uint8>& BinaryPreset, FString& Error)
+{
+	TArray<FSoftObjectPath> UnresolvedClassPaths;
+	FSKGAttachmentParent AttachmentStruct = DeserializeAttachmentBinaryWithoutLoading(BinaryPreset, UnresolvedClassPaths, Error);
+	if (Error.IsEmpty() && UnresolvedClassPaths.Num())
+	{
+		Error = FString::Printf(TEXT("Binary attachment preset references %d classes that are not loaded, preload them with PreloadBinaryPresets or use ConstructAttachmentParentBinaryAsync"), UnresolvedClassPaths.Num());
+	}
+	return AttachmentStruct;
+}
+
+FSKGAttachmentParent USKGAttachmentFunctionLibrary::DeserializeAttachmentBinaryWithoutLoading(const TArray<uint8>& BinaryPreset, TArray<FSoftObjectPath>& OutUnresolvedClassPaths, FString& Error)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SKGDeserializeAttachmentBinary);
+	using namespace SKGAttachmentPreset;
+	
+	OutUnresolvedClassPaths.Reset();
+	FBody Body;
+	if (!ReadBody(BinaryPreset, Body, Error))
+	{
+		return FSKGAttachmentParent();
+	}
+
+	// Each unique class path is resolved once no matter how many entries reference it, only classes already in memory are found
+	TArray<UClass*> ResolvedClasses;
+	ResolvedClasses.SetNumZeroed(Body.StringTable.Num());
+	for (const int32 ClassIndex : GetClassIndices(Body))
+	{
+		const FSoftClassPath ClassPath(Body.StringTable[ClassIndex]);
+		ResolvedClasses[ClassIndex] = ClassPath.ResolveClass();
+		if (!ResolvedClasses[ClassIndex])
+		{
+			OutUnresolvedClassPaths.Add(ClassPath);
+		}
+	}
+
+	FSKGAttachmentParent AttachmentStruct;
+	AttachmentStruct.AttachmentClass = GetResolvedClass(ResolvedClasses, Body.AttachmentClassIndex);
+	AttachmentStruct.AttachmentList.Reserve(Body.Entries.Num());
+	for (const FEntry& Entry : Body.Entries)
+	{
+		FSKGAttachmentAttachList& AttachmentList = AttachmentStruct.AttachmentList.AddDefaulted_GetRef();
+		AttachmentList.ComponentNameHash = Entry.ComponentNameHash;
+		AttachmentList.ComponentName = GetString(Body.StringTable, Entry.ComponentNameIndex);
+		AttachmentList.ParentRootActor = GetResolvedClass(ResolvedClasses, Entry.ParentRootActorIndex);
+		AttachmentList.ParentAttachment = GetResolvedClass(ResolvedClasses, Entry.ParentAttachmentIndex);
+		AttachmentList.Attachment = GetResolvedClass(ResolvedClasses, Entry.AttachmentIndex);
+		AttachmentList.AttachmentOffset = Entry.AttachmentOffset;
+	}
+
+	if (!AttachmentStruct.AttachmentClass && OutUnresolvedClassPaths.Num() == 0)
+	{
+		Error = "Could NOT resolve AttachmentClass of binary attachment preset";
+	}
+	return AttachmentStruct;
+}
+
+TArray<uint8> USKGAttachmentFunctionLibrary::ConvertJsonPresetToBinary(const FString& JsonString, bool bCompress, FString& Error)
+{
+	FSKGAttachmentParent AttachmentStruct = DeserializeAttachmentString(JsonString, Error);
+	if (!Error.IsEmpty())
+	{
+		return TArray<uint8>();
+	}
+	return SerializeAttachmentStructBinary(AttachmentStruct, bCompress);
+}
+
+FString USKGAttachmentFunctionLibrary::ConvertBinaryPresetToJson(const TArray<uint8>& BinaryPreset, FString& Error)
+{
+	using namespace SKGAttachmentPreset;
+
+	TArray<FSoftObjectPath> UnresolvedClassPaths;
+	const FSKGAttachmentParent AttachmentStruct = DeserializeAttachmentBinaryWithoutLoading(BinaryPreset, UnresolvedClassPaths, Error);
+	if (!Error.IsEmpty())
+	{
+		return "";
+	}
+
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	if (!FJsonObjectConverter::UStructToJsonObject(FSKGAttachmentParent::StaticStruct(), &AttachmentStruct, JsonObject))
+	{
+		Error = "Could Not Serialize String";
+		return "";
+	}
+	
+	// Classes that are not loaded are written from their paths, converting never loads them
+	if (UnresolvedClassPaths.Num())
+	{
+		FBody Body;
+		ReadBody(BinaryPreset, Body, Error);
+		auto SetClassPath = [&Body](const TSharedPtr<FJsonObject>& Object, const TCHAR* FieldName, int32 Index)
+		{
+			if (Object.IsValid() && Body.StringTable.IsValidIndex(Index))
+			{
+				Object->SetStringField(FieldName, Body.StringTable[Index]);
+			}
+		};
+		SetClassPath(JsonObject, TEXT("AttachmentClass"), Body.AttachmentClassIndex);
+		const TArray<TSharedPtr<FJsonValue>>* AttachmentList = nullptr;
+		if (JsonObject->TryGetArrayField(TEXT("AttachmentList"), AttachmentList) && AttachmentList->Num() == Body.Entries.Num())
+		{
+			for (int32 i = 0; i < Body.Entries.Num(); ++i)
+			{
+				const TSharedPtr<FJsonObject> Entry = (*AttachmentList)[i].IsValid() ? (*AttachmentList)[i]->AsObject() : nullptr;
+				SetClassPath(Entry, TEXT("ParentRootActor"), Body.Entries[i].ParentRootActorIndex);
+				SetClassPath(Entry, TEXT("ParentAttachment"), Body.Entries[i].ParentAttachmentIndex);
+				SetClassPath(Entry, TEXT("Attachment"), Body.Entries[i].AttachmentIndex);
+			}
+		}
+	}
+
+	FString SerializedString;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&SerializedString);
+	if (!FJsonSerializer::Serialize(JsonObject, JsonWriter))
+	{
+		Error = "Could Not Serialize String";
+		return "";
+	}
+	return SerializedString;
+}
+
+TArray<FSoftObjectPath> USKGAttachmentFunctionLibrary::GetBinaryPresetClassPaths(const TArray<uint8>& BinaryPreset, FString& Error)
+{
+	using namespace SKGAttachmentPreset;
+	
+	TArray<FSoftObjectPath> ClassPaths;
+	FBody Body;
+	if (ReadBody(BinaryPreset, Body, Error))
+	{
+		const TSet<int32> ClassIndices = GetClassIndices(Body);
+		ClassPaths.Reserve(ClassIndices.Num());
+		for (const int32 ClassIndex : ClassIndices)
+		{
+			ClassPaths.Add(FSoftObjectPath(Body.StringTable[ClassIndex]));
+		}
+	}
+	return ClassPaths;
+}
+
+TArray<FSoftObjectPath> USKGAttachmentFunctionLibrary::GetJsonPresetClassPaths(const FString& JsonString, FString& Error)
+{
+	TArray<FSoftObjectPath> ClassPaths;
+	TSharedPtr<FJsonObject> JsonObject;
+	const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
+	{
+		Error = "Could NOT Deserialize Json String";
+		return ClassPaths;
+	}
+
+	// Read the paths straight from the json so nothing gets loaded by the struct converter
+	auto AddClassPath = [&ClassPaths](const TSharedPtr<FJsonObject>& Object, const TCHAR* FieldName)
+	{
+		FString ClassPath;
+		if (Object.IsValid() && Object->TryGetStringField(FieldName, ClassPath) && !ClassPath.IsEmpty() && ClassPath != TEXT("None"))
+		{
+			ClassPaths.AddUnique(FSoftObjectPath(ClassPath));
+		}
+	};
+	AddClassPath(JsonObject, TEXT("AttachmentClass"));
+	const TArray<TSharedPtr<FJsonValue>>* AttachmentList = nullptr;
+	if (JsonObject->TryGetArrayField(TEXT("AttachmentList"), AttachmentList))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *AttachmentList)
+		{
+			const TSharedPtr<FJsonObject> Entry = Value.IsValid() ? Value->AsObject() : nullptr;
+			AddClassPath(Entry, TEXT("ParentRootActor"));
+			AddClassPath(Entry, TEXT("ParentAttachment"));
+			AddClassPath(Entry, TEXT("Attachment"));
+		}
+	}
+	return ClassPaths;
+}
+
+TSharedPtr<FStreamableHandle> USKGAttachmentFunctionLibrary::RequestPresetClassesAsyncLoad(TArray<FSoftObjectPath> ClassPaths, FStreamableDelegate OnLoaded, TAsyncLoadPriority Priority)
+{
+	if (ClassPaths.Num() == 0)
+	{
+		OnLoaded.ExecuteIfBound();
+		return nullptr;
+	}
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	return StreamableManager.RequestAsyncLoad(MoveTemp(ClassPaths), OnLoaded, Priority, false, false, TEXT("SKGAttachmentPreset"));
+}
+
+TSharedPtr<FStreamableHandle> USKGAttachmentFunctionLibrary::PreloadBinaryPresets(const TArray<TArray<uint8>>& BinaryPresets, FStreamableDelegate OnLoaded, TAsyncLoadPriority Priority)
+{
+	TArray<FSoftObjectPath> ClassPaths;
+	for (const TArray<uint8>& BinaryPreset : BinaryPresets)
+	{
+		FString Error;
+		for (const FSoftObjectPath& ClassPath : GetBinaryPresetClassPaths(BinaryPreset, Error))
+		{
+			ClassPaths.AddUnique(ClassPath);
+		}
+	}
+	return RequestPresetClassesAsyncLoad(MoveTemp(ClassPaths), OnLoaded, Priority);
+}
+
+TSharedPtr<FStreamableHandle> USKGAttachmentFunctionLibrary::PreloadJsonPresets(const TArray<FString>& JsonPresets, FStreamableDelegate OnLoaded, TAsyncLoadPriority Priority)
+{
+	TArray<FSoftObjectPath> ClassPaths;
+	for (const FString& JsonPreset : JsonPresets)
+	{
+		FString Error;
+		for (const FSoftObjectPath& ClassPath : GetJsonPresetClassPaths(JsonPreset, Error))
+		{
+			ClassPaths.AddUnique(ClassPath);
+		}
+	}
+	return RequestPresetClassesAsyncLoad(MoveTemp(ClassPaths), OnLoaded, Priority);
+}
+
+void USKGAttachmentFunctionLibrary::ConstructAttachmentParentBinaryAsync(UObject* WorldContextObject, const TArray<uint8>& BinaryPreset, AActor* Owner, APawn* Instigator, FOnAttachmentParentConstructed OnConstructed, int32 Priority)
+{
+	FString Error;
+	TArray<FSoftObjectPath> ClassPaths = GetBinaryPresetClassPaths(BinaryPreset, Error);
+	if (!Error.IsEmpty())
+	{
+		OnConstructed.ExecuteIfBound(nullptr, Error);
+		return;
+	}
+
+	TWeakObjectPtr<UObject> WeakWorldContext = WorldContextObject;
+	TWeakObjectPtr<AActor> WeakOwner = Owner;
+	TWeakObjectPtr<APawn> WeakInstigator = Instigator;
+	RequestPresetClassesAsyncLoad(MoveTemp(ClassPaths), FStreamableDelegate::CreateLambda([BinaryPreset, WeakWorldContext, WeakOwner, WeakInstigator, OnConstructed]()
+	{
+		FString ConstructError;
+		AActor* AttachmentParent = nullptr;
+		if (WeakWorldContext.IsValid())
+		{
+			// Everything the preset references was just loaded, a class that is still missing failed to load and its entries are skipped
+			TArray<FSoftObjectPath> UnresolvedClassPaths;
+			const FSKGAttachmentParent AttachmentStruct = DeserializeAttachmentBinaryWithoutLoading(BinaryPreset, UnresolvedClassPaths, ConstructError);
+			if (ConstructError.IsEmpty() && !AttachmentStruct.AttachmentClass)
+			{
+				ConstructError = "Could NOT load AttachmentClass of binary attachment preset";
+			}
+			if (ConstructError.IsEmpty())
+			{
+				AttachmentParent = ConstructAttachmentParent(WeakWorldContext.Get(), AttachmentStruct, WeakOwner.Get(), WeakInstigator.Get(), ConstructError);
+			}
+		}
+		else
+		{
+			ConstructError = "WorldActor INVALID";
+		}
+		OnConstructed.ExecuteIfBound(AttachmentParent, ConstructError);
+	}), Priority);
+}
+
+void USKGAttachmentFunctionLibrary::ConstructAttachmentParentJsonAsync(UObject* WorldContextObject, const FString& JsonString, AActor* Owner, APawn* Instigator, FOnAttachmentParentConstructed OnConstructed, int32 Priority)
+{
+	FString Error;
+	TArray<FSoftObjectPath> ClassPaths = GetJsonPresetClassPaths(JsonString, Error);
+	if (!Error.IsEmpty())
+	{
+		OnConstructed.ExecuteIfBound(nullptr, Error);
+		return;
+	}
+
+	TWeakObjectPtr<UObject> WeakWorldContext = WorldContextObject;
+	TWeakObjectPtr<AActor> WeakOwner = Owner;
+	TWeakObjectPtr<APawn> WeakInstigator = Instigator;
+	RequestPresetClassesAsyncLoad(MoveTemp(ClassPaths), FStreamableDelegate::CreateLambda([JsonString, WeakWorldContext, WeakOwner, WeakInstigator, OnConstructed]()
+	{
+		FString ConstructError;
+		AActor* AttachmentParent = nullptr;
+		if (WeakWorldContext.IsValid())
+		{
+			const FSKGAttachmentParent AttachmentStruct = DeserializeAttachmentString(JsonString, ConstructError);
+			if (ConstructError.IsEmpty())
+			{
+				AttachmentParent = ConstructAttachmentParent(WeakWorldContext.Get(), AttachmentStruct, WeakOwner.Get(), WeakInstigator.Get(), ConstructError);
+			}
+		}
+		else
+		{
+			ConstructError = "WorldActor INVALID";
+		}
+		OnConstructed.ExecuteIfBound(AttachmentParent, ConstructError);
+	}), Priority);
+}
+
 AActor* USKGAttachmentFunctionLibrary::ConstructAttachmentParent(UObject* WorldContextObject, FSKGAttachmentParent AttachmentStruct, AActor* Owner, APawn* Instigator, FString& Error)
 {
+	SCOPE_CYCLE_COUNTER(STAT_SKGConstructAttachmentParent);
 	if (!IsValid(WorldContextObject))
 	{
 		Error = "WorldActor INVALID";
@@ -236,6 +1004,12 @@ AActor* USKGAttachmentFunctionLibrary::ConstructAttachmentParent(UObject* WorldC
 		return nullptr;
 	}
 
+	if (!AttachmentStruct.AttachmentClass)
+	{
+		Error = "AttachmentClass INVALID";
+		return nullptr;
+	}
+
 	if (AttachmentStruct.AttachmentClass->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
 	{
 		if (AActor* AttachmentParent = World->SpawnActorDeferred<AActor>(AttachmentStruct.AttachmentClass, FTransform(), Owner, Instigator, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn))
@@ -245,53 +1019,93 @@ AActor* USKGAttachmentFunctionLibrary::ConstructAttachmentParent(UObject* WorldC
 			USKGAttachmentManager* AttachmentManager = ISKGAttachmentInterface::Execute_GetAttachmentManager(AttachmentParent);
 			if (AttachmentManager)
 			{
-				for (FSKGAttachmentAttachList& AttachmentList : AttachmentStruct.AttachmentList)
+				// Entries are looked up by the component they target and consumed as they are used, so each is visited once
+				TMap<uint32, TArray<int32>> EntryMap = CreateAttachListEntryMap(AttachmentStruct.AttachmentList);
+
+				TArray<USKGAttachmentComponent*> Frontier;
+				TArray<USKGAttachmentComponent*> NextFrontier;
 				{
-					TArray<USKGAttachmentComponent*> AttachmentComponentsComponents = AttachmentManager->GetAllAttachmentComponents(true);
-					AttachmentList.bHasBeenCreated = true;
-					if (AttachmentList.ParentRootActor)
+					TInlineComponentArray<USKGAttachmentComponent*> AttachmentComponents(AttachmentParent);
+					Frontier.Append(AttachmentComponents);
+				}
+
+				// Breadth first, each wave spawns the entries for the newest components (deferred), then finishes and attaches them together
+				TArray<TPair<USKGAttachmentComponent*, AActor*>> Wave;
+				TArray<int32> WaveEntries;
+				while (Frontier.Num() && EntryMap.Num())
+				{
+					Wave.Reset();
+					WaveEntries.Reset();
+					NextFrontier.Reset();
+					for (USKGAttachmentComponent* PartComponent : Frontier)
 					{
-						for (USKGAttachmentComponent* PartComponent : AttachmentComponentsComponents)
+						if (!IsValid(PartComponent))
 						{
-							//UE_LOG(LogTemp, Warning, TEXT("PartComp: %s"), *PartComponent->GetName());
-							if (PartComponent && PartComponent->GetName().Equals(AttachmentList.ComponentName))
-							{
-								if (PartComponent->AddAttachment(AttachmentList.Attachment, true))
-								{
-									AActor* Attachment = PartComponent->GetAttachment();
-									if (Attachment->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
-									{
-										if (ISKGAttachmentInterface::Execute_IsMovementInverted(Attachment))
-										{
-											AttachmentList.AttachmentOffset *= -1.0f;
-										}
-										ISKGAttachmentInterface::Execute_SetOffset(Attachment, AttachmentList.AttachmentOffset);
-									}
-								}
-							}
+							continue;
 						}
+						
+						const int32 EntryIndex = TakeAttachListEntry(EntryMap, AttachmentStruct.AttachmentList, PartComponent);
+						if (EntryIndex == INDEX_NONE)
+						{
+							continue;
+						}
+						
+						const FSKGAttachmentAttachList& AttachmentList = AttachmentStruct.AttachmentList[EntryIndex];
+						if (!PartComponent->IsAttachmentCompatible(AttachmentList.Attachment))
+						{
+							continue;
+						}
+
+						// The preset replaces whatever the component already holds (e.g. a default attachment of a part spawned in an earlier wave)
+						if (PartComponent->HasAttachment())
+						{
+							PartComponent->DestroyCurrentAttachment();
+						}
+						
+						AActor* Attachment = World->SpawnActorDeferred<AActor>(AttachmentList.Attachment, PartComponent->GetComponentTransform(), PartComponent->GetOwner(), Instigator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+						if (Attachment)
+						{
+							Wave.Emplace(PartComponent, Attachment);
+							WaveEntries.Add(EntryIndex);
+						}
+					}
+					
+					// Whatever is left in the map has no component to attach to (part removed from the attachment since the preset was saved)
+					if (Wave.Num() == 0)
+					{
+						break;
+					}
+
+					for (const TPair<USKGAttachmentComponent*, AActor*>& Spawned : Wave)
+					{
+						Spawned.Value->FinishSpawning(Spawned.Key->GetComponentTransform());
 					}
-					else
+
+					for (int32 i = 0; i < Wave.Num(); ++i)
 					{
-						for (USKGAttachmentComponent* PartComponent : AttachmentComponentsComponents)
+						USKGAttachmentComponent* PartComponent = Wave[i].Key;
+						AActor* SpawnedAttachment = Wave[i].Value;
+						FSKGAttachmentAttachList& AttachmentList = AttachmentStruct.AttachmentList[WaveEntries[i]];
+						if (PartComponent->AddExistingAttachment(SpawnedAttachment, true) != SpawnedAttachment)
 						{
-							if (PartComponent && PartComponent->GetName().Equals(AttachmentList.ComponentName))
+							SpawnedAttachment->Destroy();
+							continue;
+						}
+						
+						AttachmentList.bHasBeenCreated = true;
+						if (SpawnedAttachment->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
+						{
+							if (ISKGAttachmentInterface::Execute_IsMovementInverted(SpawnedAttachment))
 							{
-								if (PartComponent->AddAttachment(AttachmentList.Attachment, true))
-								{
-									AActor* Attachment = PartComponent->GetAttachment();
-									if (Attachment && Attachment->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()))
-									{
-										if (ISKGAttachmentInterface::Execute_IsMovementInverted(Attachment))
-										{
-											AttachmentList.AttachmentOffset *= -1.0f;
-										}
-										ISKGAttachmentInterface::Execute_SetOffset(Attachment, AttachmentList.AttachmentOffset);
-									}
-								}
+								AttachmentList.AttachmentOffset *= -1.0f;
 							}
+							ISKGAttachmentInterface::Execute_SetOffset(SpawnedAttachment, AttachmentList.AttachmentOffset);
 						}
+						TInlineComponentArray<USKGAttachmentComponent*> AttachmentComponents(SpawnedAttachment);
+						NextFrontier.Append(AttachmentComponents);
 					}
+					
+					Swap(Frontier, NextFrontier);
 				}
 			}
 			return AttachmentParent;
@@ -317,6 +1131,16 @@ bool USKGAttachmentFunctionLibrary::LoadFileToString(const FString& Path, const
 	return FFileHelper::LoadFileToString(OutString, *(Path + FileName));
 }
 
+bool USKGAttachmentFunctionLibrary::SaveBytesToFile(const FString& Path, const FString& FileName, const TArray<uint8>& FileContent)
+{
+	return FFileHelper::SaveArrayToFile(FileContent, *(Path + FileName));
+}
+
+bool USKGAttachmentFunctionLibrary::LoadFileToBytes(const FString& Path, const FString& FileName, TArray<uint8>& OutBytes)
+{
+	return FFileHelper::LoadFileToArray(OutBytes, *(Path + FileName));
+}
+
 bool USKGAttachmentFunctionLibrary::GetAllFiles(FString Path, TArray<FString>& OutFiles)
 {
 	bool ValidFiles = false;
@@ -23,11 +23,23 @@ ASKGAttachmentActor::ASKGAttachmentActor()
 	NetUpdateFrequency = 0.1f;
 	MinNetUpdateFrequency = 0.1f;
 	bReplicates = true;
+	bAttachmentCacheDirty = true;
+	bResolveOverlaps = false;
 }
 
 void ASKGAttachmentActor::OnRep_CurrentOffset()
 {
 	ApplyAttachmentAttachOffset();
+	InvalidateMergedAttachmentMesh();
+}
+
+void ASKGAttachmentActor::InvalidateMergedAttachmentMesh()
+{
+	USKGAttachmentManager* AttachmentManager = GetOwningAttachmentManager();
+	if (AttachmentManager && AttachmentManager->IsAttachmentMeshMerged())
+	{
+		AttachmentManager->InvalidateAttachmentMeshMerge();
+	}
 }
 
 void ASKGAttachmentActor::ApplyAttachmentAttachOffset()
@@ -39,9 +51,20 @@ void ASKGAttachmentActor::ApplyAttachmentAttachOffset()
 
 void ASKGAttachmentActor::OnRep_OwningAttachmentComponent()
 {
+	InvalidateOwningAttachmentManager();
 	if (IsValid(OwningAttachmentComponent))
 	{
 		OffsetSnapDistance = OwningAttachmentComponent->GetOffsetSnapDistance();
+		CachedOwningAttachmentManager = OwningAttachmentComponent->GetAttachmentManager();
+		// Attachments below this may have replicated before the manager could be found, catch the managers cache up
+		if (USKGAttachmentManager* AttachmentManager = CachedOwningAttachmentManager.Get())
+		{
+			AttachmentManager->AttachmentChanged(OwningAttachmentComponent);
+			for (USKGAttachmentComponent* AttachmentComponent : AttachmentComponents)
+			{
+				AttachmentManager->AttachmentChanged(AttachmentComponent);
+			}
+		}
 	}
 }
 
@@ -83,26 +106,35 @@ void ASKGAttachmentActor::PostInitializeComponents()
 
 void ASKGAttachmentActor::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
                                          UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& HitResult)
+{
+	HandleAttachmentOverlap(OtherActor, true);
+}
+
+void ASKGAttachmentActor::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	HandleAttachmentOverlap(OtherActor, false);
+}
+
+void ASKGAttachmentActor::HandleAttachmentOverlap(AActor* OtherActor, bool bOverlapped)
 {
 	if (IsValid(OtherActor) && OtherActor != this && OtherActor->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()) && IsValid(Execute_GetOwningAttachmentComponent(this)))
 	{
 		if (Execute_ShouldBeCheckedForOverlap(OtherActor) && !IsAttachmentAttached(OtherActor))
 		{
-			const FSKGAttachmentOverlap AttachmentOverlap = FSKGAttachmentOverlap(OtherActor, true);
+			const FSKGAttachmentOverlap AttachmentOverlap = FSKGAttachmentOverlap(OtherActor, bOverlapped);
 			OwningAttachmentComponent->OverlappedWithAttachment(AttachmentOverlap);
 		}
 	}
 }
 
-void ASKGAttachmentActor::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+void ASKGAttachmentActor::HandleAttachmentMoved()
 {
-	if (IsValid(OtherActor) && OtherActor != this && OtherActor->GetClass()->ImplementsInterface(USKGAttachmentInterface::StaticClass()) && IsValid(Execute_GetOwningAttachmentComponent(this)))
+	if (bResolveOverlaps)
 	{
-		if (Execute_ShouldBeCheckedForOverlap(OtherActor) && !IsAttachmentAttached(OtherActor))
+		if (USKGAttachmentManager* AttachmentManager = GetOwningAttachmentManager())
 		{
-			const FSKGAttachmentOverlap AttachmentOverlap = FSKGAttachmentOverlap(OtherActor, false);
-			OwningAttachmentComponent->OverlappedWithAttachment(AttachmentOverlap);
+			AttachmentManager->ResolveAttachmentOverlaps(this);
 		}
 	}
 }
@@ -149,7 +181,7 @@ void ASKGAttachmentActor::MarkComponentsAsPendingKill()
 	
 	if (OwningAttachmentComponent && OwningAttachmentComponent->GetAttachmentManager())
 	{
-		OwningAttachmentComponent->GetAttachmentManager()->HandleCachingAttachmentComponents();
+		OwningAttachmentComponent->GetAttachmentManager()->UpdateAttachmentCache(OwningAttachmentComponent);
 	}
 }
 
@@ -160,9 +192,45 @@ void ASKGAttachmentActor::OnRep_AttachmentReplication()
 	ApplyAttachmentAttachOffset();
 }
 
+void ASKGAttachmentActor::OnRep_Owner()
+{
+	Super::OnRep_Owner();
+	InvalidateOwningAttachmentManager();
+}
+
+void ASKGAttachmentActor::SetOwner(AActor* NewOwner)
+{
+	if (NewOwner != GetOwner())
+	{
+		InvalidateOwningAttachmentManager();
+	}
+	Super::SetOwner(NewOwner);
+}
+
+USKGAttachmentManager* ASKGAttachmentActor::GetOwningAttachmentManager()
+{
+	if (!CachedOwningAttachmentManager.IsValid())
+	{
+		CachedOwningAttachmentManager = USKGAttachmentFunctionLibrary::WalkOwningAttachmentManager(this);
+	}
+	return CachedOwningAttachmentManager.Get();
+}
+
+void ASKGAttachmentActor::InvalidateOwningAttachmentManager()
+{
+	CachedOwningAttachmentManager.Reset();
+	for (USKGAttachmentComponent* AttachmentComponent : AttachmentComponents)
+	{
+		if (IsValid(AttachmentComponent))
+		{
+			AttachmentComponent->InvalidateAttachmentManager();
+		}
+	}
+}
+
 TArray<USKGAttachmentComponent*> ASKGAttachmentActor::GetAllAttachmentComponents_Implementation(bool bReCache)
 {
-	if (bReCache)
+	if (bReCache || bAttachmentCacheDirty)
 	{
 		CacheAttachments();
 	}
@@ -173,11 +241,13 @@ TArray<USKGAttachmentComponent*> ASKGAttachmentActor::GetAllAttachmentComponents
 void ASKGAttachmentActor::CacheAttachments()
 {
 	CachedAttachmentComponents = USKGAttachmentFunctionLibrary::CreateCacheFromAttachmentComponents(AttachmentComponents);
+	bAttachmentCacheDirty = false;
 }
 
 void ASKGAttachmentActor::SetOwningAttachmentComponent_Implementation(USKGAttachmentComponent* AttachmentComponent)
 {
 	OwningAttachmentComponent = AttachmentComponent;
+	CachedOwningAttachmentManager = IsValid(AttachmentComponent) ? AttachmentComponent->GetAttachmentManager() : nullptr;
 	if (HasAuthority())
 	{
 		MARK_PROPERTY_DIRTY_FROM_NAME(ASKGAttachmentActor, OwningAttachmentComponent, this);
@@ -192,6 +262,10 @@ void ASKGAttachmentActor::OnAttachmentUpdated_Implementation()
 
 void ASKGAttachmentActor::OnAttachmentRemoved_Implementation()
 {
+	if (bAttachmentCacheDirty)
+	{
+		CacheAttachments();
+	}
 	USKGAttachmentDefaultFunctions::OnAttachmentRemoved(CachedAttachmentComponents);
 	Destroy();
 }
@@ -252,6 +326,7 @@ bool ASKGAttachmentActor::AddOffset_Implementation(float Offset)
 	}
 
 	SetActorRelativeLocation(FVector(AttachmentAttachOffset.GetLocation().X, CurrentOffset + AttachmentAttachOffset.GetLocation().Y, AttachmentAttachOffset.GetLocation().Z));
+	HandleAttachmentMoved();
 	return true;
 }
 
@@ -272,6 +347,7 @@ bool ASKGAttachmentActor::SetOffset_Implementation(float Offset)
 	}
 	
 	SetActorRelativeLocation(FVector(AttachmentAttachOffset.GetLocation().X, CurrentOffset + AttachmentAttachOffset.GetLocation().Y, AttachmentAttachOffset.GetLocation().Z));
+	HandleAttachmentMoved();
 	return MaxedOffset;
 }
 
@@ -280,7 +356,7 @@ void ASKGAttachmentActor::MoveForwardPosition_Implementation(uint8 Amount)
 	if (USKGAttachmentComponent* AttachmentComponent = GetOwningAttachmentComponent_Implementation())
 	{
 		const int32 CurrentIndex = AttachmentComponent->GetAttachmentCurrentSnapPointIndex();
-		const TArray<float> SnapPoints = AttachmentComponent->GetSnapPoints();
+		const TArray<float>& SnapPoints = AttachmentComponent->GetCachedSnapPoints();
 		if (SnapPoints.Num())
 		{
 			uint8 NewIndex = static_cast<uint8>(CurrentIndex);
@@ -295,6 +371,7 @@ void ASKGAttachmentActor::MoveForwardPosition_Implementation(uint8 Amount)
 
 			CurrentOffset = SnapPoints[NewIndex];
 			SetActorRelativeLocation(FVector(AttachmentAttachOffset.GetLocation().X, CurrentOffset + AttachmentAttachOffset.GetLocation().Y, AttachmentAttachOffset.GetLocation().Z));
+			HandleAttachmentMoved();
 		}
 	}
 }
@@ -304,7 +381,7 @@ void ASKGAttachmentActor::MoveBackwardPosition_Implementation(uint8 Amount)
 	if (USKGAttachmentComponent* AttachmentComponent = GetOwningAttachmentComponent_Implementation())
 	{
 		const int32 CurrentIndex = AttachmentComponent->GetAttachmentCurrentSnapPointIndex();
-		const TArray<float> SnapPoints = AttachmentComponent->GetSnapPoints();
+		const TArray<float>& SnapPoints = AttachmentComponent->GetCachedSnapPoints();
 		if (SnapPoints.Num())
 		{
 			uint8 NewIndex = static_cast<uint8>(CurrentIndex);
@@ -319,6 +396,7 @@ void ASKGAttachmentActor::MoveBackwardPosition_Implementation(uint8 Amount)
 		
 			CurrentOffset = SnapPoints[NewIndex];
 			SetActorRelativeLocation(FVector(AttachmentAttachOffset.GetLocation().X, CurrentOffset + AttachmentAttachOffset.GetLocation().Y, AttachmentAttachOffset.GetLocation().Z));
+			HandleAttachmentMoved();
 		}
 	}
 }
@@ -364,6 +442,7 @@ void ASKGAttachmentActor::FinishedMovingAttachment_Implementation()
 	{
 		MARK_PROPERTY_DIRTY_FROM_NAME(ASKGAttachmentActor, CurrentOffset, this);
 		ForceNetUpdate();
+		InvalidateMergedAttachmentMesh();
 	}
 	OnRep_CurrentOffset();
 }
@@ -388,16 +467,43 @@ void ASKGAttachmentActor::EnableGenerateOverlapEvents_Implementation(bool bEnabl
 {
 	if (OverlapCheckComponent.IsValid())
 	{
-		OverlapCheckComponent->SetGenerateOverlapEvents(bEnable);
+		// The manager broadphase only tests neighbours of the moved attachment instead of every overlap shape on the physics scene
+		USKGAttachmentManager* AttachmentManager = GetOwningAttachmentManager();
+		if (AttachmentManager && AttachmentManager->UsesAttachmentBroadphase())
+		{
+			OverlapCheckComponent->SetGenerateOverlapEvents(false);
+			bResolveOverlaps = bEnable;
+			if (bEnable)
+			{
+				AttachmentManager->ResolveAttachmentOverlaps(this);
+			}
+			else
+			{
+				AttachmentManager->ClearAttachmentOverlaps(this);
+			}
+		}
+		else
+		{
+			bResolveOverlaps = false;
+			OverlapCheckComponent->SetGenerateOverlapEvents(bEnable);
+		}
 	}
 }
 
 void ASKGAttachmentActor::OnAttachmentOverlapped_Implementation()
 {
+	if (bAttachmentCacheDirty)
+	{
+		CacheAttachments();
+	}
 	USKGAttachmentDefaultFunctions::OnAttachmentOverlapped(this, CachedAttachmentComponents);
 }
 
 void ASKGAttachmentActor::OnAttachmentOverlapEnd_Implementation()
 {
+	if (bAttachmentCacheDirty)
+	{
+		CacheAttachments();
+	}
 	USKGAttachmentDefaultFunctions::OnAttachmentOverlapEnd(this, CachedAttachmentComponents);
 }
@@ -0,0 +1,108 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MeshDescription.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectKey.h"
+#include "Misc/SKGAttachmentFunctionLibrary.h"
+#include "SKGAttachmentMeshMergeWorldSubsystem.generated.h"
+
+class UMaterialInterface;
+class UStaticMesh;
+class UStaticMeshComponent;
+
+namespace SKGAttachmentMeshMerge
+{
+	struct FPart
+	{
+		FObjectKey StaticMesh;
+		TArray<FObjectKey, TInlineAllocator<4>> Materials;
+		// Quantized so float noise from attaching does not create a new mesh
+		FIntVector Location;
+		FIntVector Rotation;
+		FIntVector Scale;
+
+		bool operator==(const FPart& Other) const
+		{
+			return StaticMesh == Other.StaticMesh && Location == Other.Location && Rotation == Other.Rotation && Scale == Other.Scale && Materials == Other.Materials;
+		}
+	};
+
+	// Everything baked into a merged mesh, compared in full on lookup so a hash collision never hands out the wrong mesh
+	struct FSignature
+	{
+		TArray<FPart> Parts;
+		uint32 Hash = 0;
+
+		bool operator==(const FSignature& Other) const
+		{
+			return Hash == Other.Hash && Parts == Other.Parts;
+		}
+
+		friend uint32 GetTypeHash(const FSignature& Signature)
+		{
+			return Signature.Hash;
+		}
+	};
+
+	struct FSource
+	{
+		UStaticMesh* StaticMesh = nullptr;
+		FTransform MeshTransform;
+		TArray<UMaterialInterface*, TInlineAllocator<4>> Materials;
+	};
+
+	// One build in flight per signature, keeps its source meshes and materials alive while the worker reads them
+	struct FPendingMerge : public FGCObject
+	{
+		TArray<FSource> Sources;
+		// Game thread only
+		TArray<FSKGOnMergedStaticMeshCreated> Callbacks;
+		FMeshDescription MeshDescription;
+		// Material of each polygon group, in group order
+		TArray<UMaterialInterface*> GroupMaterials;
+
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		{
+			for (FSource& Source : Sources)
+			{
+				Collector.AddReferencedObject(Source.StaticMesh);
+				for (UMaterialInterface*& Material : Source.Materials)
+				{
+					Collector.AddReferencedObject(Material);
+				}
+			}
+		}
+
+		virtual FString GetReferencerName() const override
+		{
+			return TEXT("SKGAttachmentMeshMerge::FPendingMerge");
+		}
+	};
+}
+
+// Merged attachment meshes shared by every attachment manager in the world. Dropped with the world so PIE sessions and level travel start clean
+UCLASS()
+class USKGAttachmentMeshMergeWorldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	// Merged meshes by signature so every weapon with the same build shares one mesh
+	TMap<SKGAttachmentMeshMerge::FSignature, TWeakObjectPtr<UStaticMesh>> MergedStaticMeshes;
+	TMap<SKGAttachmentMeshMerge::FSignature, TSharedPtr<SKGAttachmentMeshMerge::FPendingMerge>> PendingMerges;
+	// Meshes already reported for missing Allow CPUAccess, each is only logged once per world
+	TSet<FObjectKey> ReportedNonCPUAccessibleMeshes;
+
+	virtual void Deinitialize() override;
+	void FinishMerge(const SKGAttachmentMeshMerge::FSignature& Signature, const TSharedPtr<SKGAttachmentMeshMerge::FPendingMerge>& PendingMerge);
+
+public:
+	// See USKGAttachmentFunctionLibrary::CreateMergedStaticMeshAsync
+	void CreateMergedStaticMeshAsync(const FTransform& RelativeTo, const TArray<UStaticMeshComponent*>& StaticMeshComponents, FSKGOnMergedStaticMeshCreated OnCreated);
+	// Logs a mesh left out of a merge because its render data has no CPU copy
+	void ReportNonCPUAccessibleMesh(const UStaticMeshComponent* StaticMeshComponent);
+};
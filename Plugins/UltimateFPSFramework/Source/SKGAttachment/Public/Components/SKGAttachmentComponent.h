@@ -10,6 +10,8 @@
 
 class AActor;
 class UStaticMeshComponent;
+class UStaticMesh;
+class USkeletalMesh;
 class USkeletalMeshComponent;
 class USKGAttachmentManager;
 class UPDA_AttachmentCompatibility;
@@ -105,11 +107,18 @@ protected:
 	int OldAmount;
 	bool bSetInitialOffset;
 	TArray<float> CachedSnapPointOffsets;
+	// Snap points and rail ends in component space, built once per attachment
+	TArray<FVector> CachedSnapPointLocations;
+	FVector CachedRailStart;
+	FVector CachedRailEnd;
+	bool bRailDataCached;
+	void CacheRailData();
 
 	bool bCanAddAttachment;
 
 	UPROPERTY()
 	TObjectPtr<AActor> PreviewAttachment;
+	void ReleasePreviewAttachment();
 	
 	virtual void BeginPlay() override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
@@ -156,6 +165,8 @@ public:
 	USKGAttachmentManager* GetDirectOwnersAttachmentManager();
 	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Attachment")
 	USKGAttachmentManager* GetAttachmentManager();
+	// Clears the cached managers here and on the current attachment (and everything attached to it)
+	void InvalidateAttachmentManager();
 	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Attachment")
 	bool IsEssential() const { return bIsEssential; }
 	void SetMasterPoseComponent();
@@ -183,6 +194,10 @@ public:
 	TArray<float> GetSnapPoints();
 	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Attachment")
 	TArray<FVector> GetWorldSnapPoints();
+	const TArray<float>& GetCachedSnapPoints();
+	// World space start and end of the rail (Minimum to Maximum)
+	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Attachment")
+	void GetWorldRailExtents(FVector& Start, FVector& End);
 	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Attachment")
 	int32 GetAttachmentCurrentSnapPointIndex() const;
 	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Attachment")
@@ -240,7 +255,8 @@ public:
 
 #if WITH_EDITOR
 	const FSKGAttachmentComponentPreview& GetAttachmentComponentPreview() const { return AttachmentComponentPreview; }
-	UActorComponent* GetMeshComponentFromAttachment() const;
+	TSoftClassPtr<AActor> GetDisplayAttachmentClass() const;
+	bool GetPreviewMeshFromAttachment(UStaticMesh*& OutStaticMesh, USkeletalMesh*& OutSkeletalMesh) const;
 	int32 GetEditorAttachmentCurrentSnapPointIndex() const;
 	TArray<float> GetEditorSnapDistancePoints() const;
 	TArray<FVector> GetEditorSnapPoints() const;
@@ -4,15 +4,77 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "SKGAttachmentDataTypes.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "SKGAttachmentManager.generated.h"
 
 class USKGAttachmentComponent;
+class USKGAttachmentManager;
+class UMeshComponent;
+class UStaticMeshComponent;
+class ASKGAttachmentActor;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnAttachmentsCached);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAttachmentCacheChanged, const FSKGAttachmentChange&, AttachmentChange);
+
+USTRUCT()
+struct FSKGAttachmentComponentItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+	UPROPERTY()
+	USKGAttachmentComponent* AttachmentComponent = nullptr;
+	// Component this item last resolved to on this machine, so a change knows what to unregister
+	TWeakObjectPtr<USKGAttachmentComponent> RegisteredAttachmentComponent;
+
+	FSKGAttachmentComponentItem(){}
+	FSKGAttachmentComponentItem(USKGAttachmentComponent* INAttachmentComponent) : AttachmentComponent(INAttachmentComponent) {}
+
+	void PreReplicatedRemove(const struct FSKGAttachmentComponentArray& InArraySerializer);
+	void PostReplicatedAdd(const struct FSKGAttachmentComponentArray& InArraySerializer);
+	void PostReplicatedChange(const struct FSKGAttachmentComponentArray& InArraySerializer);
+};
+
+// Replicates the attachment managers top level components per item instead of resending the whole array
+USTRUCT()
+struct FSKGAttachmentComponentArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+	UPROPERTY()
+	TArray<FSKGAttachmentComponentItem> Items;
+	UPROPERTY(NotReplicated)
+	USKGAttachmentManager* AttachmentManager = nullptr;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FSKGAttachmentComponentItem, FSKGAttachmentComponentArray>(Items, DeltaParams, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FSKGAttachmentComponentArray> : public TStructOpsTypeTraitsBase2<FSKGAttachmentComponentArray>
+{
+	enum 
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+// Overlap shape bounds of an attachment in the manager owners space, used by the drag overlap broadphase
+struct FSKGAttachmentBoundsProxy
+{
+	TWeakObjectPtr<ASKGAttachmentActor> Attachment;
+	FBox Bounds = FBox(ForceInit);
+	// Attachments this one is currently overlapping
+	TArray<TWeakObjectPtr<ASKGAttachmentActor>> OverlappingAttachments;
+};
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class SKGATTACHMENT_API USKGAttachmentManager : public UActorComponent
 {
 	GENERATED_BODY()
+#if WITH_DEV_AUTOMATION_TESTS
+	// Lets the automation tests check the broadphase against a brute force overlap pass
+	friend struct FSKGAttachmentManagerTestAccess;
+#endif
 
 public:	
 	// Sets default values for this component's properties
@@ -31,12 +93,28 @@ protected:
 	// Optimization for construction. Will not call the OnUpdated functions until delay has passed and item is fully constructed
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGAttachment|Default")
 	float InitalOnAttachmentUpdatedDelay;
+	// Debug only. Compares the cache against a full rebuild after every incremental update and logs any mismatch
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGAttachment|Debug", AdvancedDisplay)
+	bool bValidateAttachmentCacheUpdates;
 	bool bInitDone;
+	// Bakes attachment static meshes into one mesh per bone once the attachment set has settled. Meshes need Allow CPUAccess enabled to be merged
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGAttachment|MeshMerge")
+	bool bMergeAttachmentMeshes;
+	// How long the attachments must go unchanged before merging
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGAttachment|MeshMerge", meta = (EditCondition = "bMergeAttachmentMeshes"))
+	float AttachmentMeshMergeDelay;
+	// By default only remote/third person copies are merged so the local first person view keeps per part meshes
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGAttachment|MeshMerge", meta = (EditCondition = "bMergeAttachmentMeshes"))
+	bool bMergeWhenLocallyControlled;
+	// Resolve attachment overlaps while dragging against neighbouring attachment bounds instead of physics overlap events
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGAttachment|Overlap")
+	bool bUseAttachmentBroadphase;
 	
-	UPROPERTY(ReplicatedUsing = OnRep_AttachmentComponents)
+	UPROPERTY(Replicated)
+	FSKGAttachmentComponentArray ReplicatedAttachmentComponents;
+	// Local mirror of ReplicatedAttachmentComponents
+	UPROPERTY()
 	TArray<USKGAttachmentComponent*> AttachmentComponents;
-	UFUNCTION()
-	void OnRep_AttachmentComponents();
 	UPROPERTY()
 	TArray<USKGAttachmentComponent*> CachedAttachmentComponents;
 	UPROPERTY()
@@ -44,19 +122,90 @@ protected:
 	bool bEssentialAttachmentsValid;
 	void HandleEssentialAttachmentValidation();
 
+	// The attachment each cached component held when it was cached, used to know what to remove when it changes
+	UPROPERTY()
+	TMap<USKGAttachmentComponent*, AActor*> CachedComponentAttachments;
+	// Cached component -> the attachment components on its attachment
+	TMultiMap<USKGAttachmentComponent*, USKGAttachmentComponent*> CachedChildAttachmentComponents;
+	// Cached component -> the component holding the attachment it is on, top level components have none
+	TMap<USKGAttachmentComponent*, USKGAttachmentComponent*> CachedParentAttachmentComponents;
+	// Cached attachments bucketed by their class and every parent class up to AActor. Filled in cache order on a rebuild,
+	// incremental adds append to the end so the buckets do not follow cache order after that
+	TMap<const UClass*, TArray<AActor*>> AttachmentClassIndex;
+	void AddAttachmentToClassIndex(AActor* Attachment);
+	void RemoveAttachmentFromClassIndex(AActor* Attachment);
+	TArray<AActor*> UninitializedAttachmentsOfClass;
+	// Changes applied by the incremental update currently being broadcast
+	UPROPERTY()
+	TArray<FSKGAttachmentChange> AttachmentChanges;
+	bool bApplyingAttachmentChanges;
+
 	FTimerHandle TCacheTimerHandle;
+	FTimerHandle TMeshMergeTimerHandle;
+	UPROPERTY()
+	TArray<UStaticMeshComponent*> MergedMeshComponents;
+	// Hidden part meshes represented by MergedMeshComponents
+	UPROPERTY()
+	TArray<UStaticMeshComponent*> MergedSourceMeshComponents;
+	// Visibility of each MergedSourceMeshComponents entry before it was hidden, restored on unmerge
+	TArray<bool> MergedSourceMeshVisibility;
+	// Bumped on every unmerge so merged meshes that finish building after the parts changed are dropped
+	uint32 MeshMergeSerial;
+	void MergeAttachmentMeshes();
+	void OnMergedStaticMeshCreated(UStaticMesh* MergedMesh, uint32 MergeSerial, FName Bone, TArray<TWeakObjectPtr<UStaticMeshComponent>> SourceMeshComponents);
+	bool ShouldMergeAttachmentMeshes() const;
+	bool GetMergeBone(const UStaticMeshComponent* StaticMeshComponent, const UMeshComponent* RootMesh, FName& OutBone) const;
 	void CacheAttachmentComponents();
 	void CallOnAttachmentUpdated();
+	// Inserts the components below Attachment at InsertIndex in the same pre order a full rebuild produces
+	void AddAttachmentToCache(USKGAttachmentComponent* AttachmentComponent, AActor* Attachment, bool bRecordChange, int32& InsertIndex);
+	void RemoveAttachmentFromCache(USKGAttachmentComponent* AttachmentComponent);
+	void RemoveCachedAttachment(USKGAttachmentComponent* AttachmentComponent);
+	// Number of cached components below this component, they directly follow it (or the root block for top level components)
+	int32 GetCachedSubtreeSize(USKGAttachmentComponent* AttachmentComponent) const;
+	int32 GetCachedSubtreeStart(USKGAttachmentComponent* AttachmentComponent) const;
+	void MarkOwnerAttachmentCachesDirty(const USKGAttachmentComponent* AttachmentComponent) const;
+	void BroadcastAttachmentChanges();
+
+	// Sorted by Bounds.Min on BroadphaseAxis
+	TArray<FSKGAttachmentBoundsProxy> AttachmentBoundsProxies;
+	// Attachment -> index in AttachmentBoundsProxies, rebuilt with every sort and patched over the shifted range on reinsert
+	TMap<const AActor*, int32> AttachmentBoundsProxyIndices;
+	int32 BroadphaseAxis;
+	// Largest proxy size along BroadphaseAxis since the last rebuild, bounds the binary searched start of the sweep
+	double BroadphaseMaxAxisSize;
+	bool bAttachmentBroadphaseDirty;
+	void RebuildAttachmentBroadphase();
+	void SortAttachmentBroadphase();
+	// Removes the moved proxies, updates their bounds and inserts them back at their sorted position
+	void ReinsertAttachmentBoundsProxies(TConstArrayView<ASKGAttachmentActor*> MovedAttachments);
+	FSKGAttachmentBoundsProxy* FindAttachmentBoundsProxy(const AActor* Attachment);
+	bool UpdateAttachmentBounds(FSKGAttachmentBoundsProxy& Proxy) const;
+	void SetAttachmentsOverlapping(FSKGAttachmentBoundsProxy& Proxy, ASKGAttachmentActor* OtherAttachment, bool bOverlapping);
 	
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+	virtual void PostInitProperties() override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	bool HasAuthority() const { return GetOwner() && GetOwner()->HasAuthority() ? true : false; }
 	
 public:
 	bool GetShouldSpawnDefaultOnPreset() const { return bSpawnDefaultPartsFromPreset; }
 	void AttachmentChanged(USKGAttachmentComponent* AttachmentComponent);
+	// Called for both the server and fast array callbacks on clients when a top level component is added or removed
+	void RegisterAttachmentComponent(USKGAttachmentComponent* AttachmentComponent);
+	void UnregisterAttachmentComponent(USKGAttachmentComponent* AttachmentComponent);
+	// Applies only the change of this one component to the cache, falls back to a full recache before init or if the component is unknown
+	void UpdateAttachmentCache(USKGAttachmentComponent* AttachmentComponent);
+	// True while OnAttachmentUpdated is being called for an incremental update, GetAttachmentChanges is only valid during this
+	bool IsApplyingAttachmentChanges() const { return bApplyingAttachmentChanges; }
+	const TArray<FSKGAttachmentChange>& GetAttachmentChanges() const { return AttachmentChanges; }
+	bool UsesAttachmentBroadphase() const { return bUseAttachmentBroadphase; }
+	// Updates the overlap state of the moved attachment (and everything attached to it) against its neighbours only
+	void ResolveAttachmentOverlaps(ASKGAttachmentActor* MovedAttachment);
+	// Ends every overlap the attachment currently has
+	void ClearAttachmentOverlaps(ASKGAttachmentActor* Attachment);
 
 	// Destroys all attachments (not the owner of the manager)
 	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Attachment")
@@ -78,24 +227,48 @@ public:
 	void SetCollisionAll(bool bEnable);
 	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Attachment")
 	void AddAttachment(USKGAttachmentComponent* AttachmentComponent);
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Attachment")
+	void RemoveAttachment(USKGAttachmentComponent* AttachmentComponent);
 	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Attachment")
 	TArray<USKGAttachmentComponent*> GetAllAttachmentComponents(bool bReCache);
+	// Same order as GetAllAttachmentComponents without the copy: top level components first, then each subtree in pre order
+	const TArray<USKGAttachmentComponent*>& GetCachedAttachmentComponents() const { return CachedAttachmentComponents; }
 	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Attachment")
 	void HandleCachingAttachmentComponents(float OverrideDelay = 0.0f);
 	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Attachment")
 	TArray<USKGAttachmentComponent*> GetAttachmentComponents() const { return AttachmentComponents; }
 	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Attachment")
 	bool AttachmentExists(USKGAttachmentComponent* AttachmentComponent);
+	// Attachments directly on the top level attachment components whose class is exactly Type
 	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Attachment")
 	TArray<AActor*> GetAttachmentsOfType(const TSubclassOf<AActor> Type);
+	// Every attachment in the tree that is or derives from Type
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Attachment")
+	TArray<AActor*> GetAllAttachmentsOfType(const TSubclassOf<AActor> Type);
+	// Same as GetAllAttachmentsOfType without the copy, the view is invalidated by the next attachment change
+	const TArray<AActor*>& GetAttachmentsOfClass(const UClass* Type);
 	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Attachment")
 	FString SerializeAttachments(FString& Error) const;
+	// Compares the current cache against a full rebuild without modifying it. Returns false and logs on mismatch
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Debug")
+	bool ValidateAttachmentCache() const;
+	// Restores the per part meshes and schedules a new merge, call when something outside the manager moves or changes parts
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|MeshMerge")
+	void InvalidateAttachmentMeshMerge();
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|MeshMerge")
+	void UnmergeAttachmentMeshes();
+	UFUNCTION(BlueprintPure, Category = "SKGAttachment|MeshMerge")
+	bool IsAttachmentMeshMerged() const { return MergedMeshComponents.Num() > 0; }
 
 	UPROPERTY(BlueprintAssignable, Category = "SKGAttachment|Delegates")
 	FOnAttachmentsCached OnAttachmentsCached;
+	// Called for every attachment added to or removed from the cache by an incremental update
+	UPROPERTY(BlueprintAssignable, Category = "SKGAttachment|Delegates")
+	FOnAttachmentCacheChanged OnAttachmentCacheChanged;
 
 	void SetMasterPoseComponent(USkeletalMeshComponent* SkeletalMeshComponent, float Delay = 0.0f) const;
 	
+	// Every attachment in the tree that is a Type (or implements it for interfaces), in cache order for interfaces
 	template <typename Type>
 	TArray<Type*> GetAttachmentsOfType();
 };
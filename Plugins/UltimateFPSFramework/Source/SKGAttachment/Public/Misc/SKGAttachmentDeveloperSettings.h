@@ -6,6 +6,8 @@
 #include "Engine/DeveloperSettings.h"
 #include "SKGAttachmentDeveloperSettings.generated.h"
 
+class UPDA_AttachmentMetadata;
+
 /**
  * 
  */
@@ -21,4 +23,16 @@ public:
 	FName AttachmentMeshTag = "SKGAttachment";
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "ComponentTags")
 	FName AttachmentOverlapTag = "SKGOverlap";
+
+	// Reuse hidden preview attachments instead of spawning and destroying one for every candidate
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Pooling")
+	bool bPoolPreviewAttachments = true;
+	// Max hidden attachments kept per class, anything released past this is destroyed
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Pooling", meta = (EditCondition = "bPoolPreviewAttachments", ClampMin = 0))
+	int32 MaxPooledAttachmentsPerClass = 4;
+
+	// Filled in when attachment blueprints compile, read by tools and UI instead of loading attachment classes.
+	// Cooked as the SKGAttachmentMetadata primary asset type, a warning is logged at runtime if it cannot be loaded
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Metadata")
+	TSoftObjectPtr<UPDA_AttachmentMetadata> AttachmentMetadata;
 };
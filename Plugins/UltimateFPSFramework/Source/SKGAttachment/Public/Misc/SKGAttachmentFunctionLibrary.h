@@ -4,11 +4,20 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "SKGAttachmentDataTypes.h"
+#include "Engine/StreamableManager.h"
 #include "SKGAttachmentFunctionLibrary.generated.h"
 
+DECLARE_STATS_GROUP(TEXT("SKGAttachment"), STATGROUP_SKGAttachment, STATCAT_Advanced);
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnAttachmentParentConstructed, AActor*, AttachmentParent, const FString&, Error);
+DECLARE_DELEGATE_OneParam(FSKGOnMergedStaticMeshCreated, UStaticMesh*);
+
 class USKGAttachmentManager;
 class USKGAttachmentComponent;
 class UMeshComponent;
+class UStaticMesh;
+class UStaticMeshComponent;
 
 UCLASS()
 class SKGATTACHMENT_API USKGAttachmentFunctionLibrary : public UBlueprintFunctionLibrary
@@ -16,11 +25,30 @@ class SKGATTACHMENT_API USKGAttachmentFunctionLibrary : public UBlueprintFunctio
 	GENERATED_BODY()
 public:
 	static int32 MaxAttachmentStack;
+	// Uses the cached manager on attachment actors, only walking the owner chain on a cache miss
 	static USKGAttachmentManager* GetOwningAttachmentManager(AActor* Actor);
+	static USKGAttachmentManager* WalkOwningAttachmentManager(AActor* Actor);
 	static USKGAttachmentManager* GetDirectOwnersAttachmentManager(AActor* Actor);
 	static TArray<USKGAttachmentComponent*> CreateCacheFromAttachmentComponents(TArray<USKGAttachmentComponent*>& AttachmentComponents);
 	static UMeshComponent* SetupAttachmentMesh(AActor* Actor);
 	static void PrintError(const UObject* WorldObject, const FString& Error);
+	// Stable across sessions/platforms, used to identify attachment components in binary presets
+	static uint32 HashComponentName(const FString& ComponentName);
+	static uint32 GetAttachListComponentHash(const FSKGAttachmentAttachList& AttachmentList);
+	// Buckets the entries by the component they target (name hash and owner class), each bucket in preset order
+	static TMap<uint32, TArray<int32>> CreateAttachListEntryMap(const TArray<FSKGAttachmentAttachList>& AttachmentList);
+	// Removes and returns the earliest entry targeting this component, INDEX_NONE if there is none
+	static int32 TakeAttachListEntry(TMap<uint32, TArray<int32>>& EntryMap, const TArray<FSKGAttachmentAttachList>& AttachmentList, const USKGAttachmentComponent* AttachmentComponent);
+	// The static mesh needs Allow CPUAccess enabled so its render data can be read at runtime
+	static bool CanMergeStaticMeshComponent(const UStaticMeshComponent* StaticMeshComponent);
+	// Bakes the components into one static mesh in RelativeTo space with one section per unique material. Identical sets reuse the same mesh.
+	// The mesh description is built on a worker thread, OnCreated runs on the game thread (right away when the mesh already exists).
+	// Merged meshes are cached per world, OnCreated gets nullptr in worlds without the mesh merge subsystem (editor previews)
+	static void CreateMergedStaticMeshAsync(const FTransform& RelativeTo, const TArray<UStaticMeshComponent*>& StaticMeshComponents, FSKGOnMergedStaticMeshCreated OnCreated);
+
+	// Reads the generated metadata table set in the attachment settings, the attachment class itself is not loaded
+	UFUNCTION(BlueprintPure, Category = "SKGAttachment|Metadata")
+	static bool GetAttachmentMetadata(TSoftClassPtr<AActor> AttachmentClass, FSKGAttachmentMetadata& Metadata);
 
 	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Serialize")
 	static FSKGAttachmentParent CreateAttachmentParentStruct(AActor* AttachmentParent, FString& Error);
@@ -28,13 +56,44 @@ public:
 	static FString SerializeAttachmentParent(AActor* AttachmentParent, FString& Error);
 	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Serialize")
 	static FSKGAttachmentParent DeserializeAttachmentString(const FString& JsonString, FString& Error);
+	// Compact versioned binary preset. Class paths are stored once in a string table and components are identified by hashed name
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Serialize")
+	static TArray<uint8> SerializeAttachmentParentBinary(AActor* AttachmentParent, bool bCompress, FString& Error);
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Serialize")
+	static TArray<uint8> SerializeAttachmentStructBinary(const FSKGAttachmentParent& AttachmentStruct, bool bCompress);
+	// Never loads, Error is set when a referenced class is not in memory. Preload the preset or construct it async first
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Serialize")
+	static FSKGAttachmentParent DeserializeAttachmentBinary(const TArray<uint8>& BinaryPreset, FString& Error);
+	// Same as DeserializeAttachmentBinary, classes that are not loaded are left null and their paths returned for an async load
+	static FSKGAttachmentParent DeserializeAttachmentBinaryWithoutLoading(const TArray<uint8>& BinaryPreset, TArray<FSoftObjectPath>& OutUnresolvedClassPaths, FString& Error);
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Serialize")
+	static TArray<uint8> ConvertJsonPresetToBinary(const FString& JsonString, bool bCompress, FString& Error);
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Serialize")
+	static FString ConvertBinaryPresetToJson(const TArray<uint8>& BinaryPreset, FString& Error);
 	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Serialize")
 	static AActor* ConstructAttachmentParent(UObject* WorldContextObject, FSKGAttachmentParent AttachmentStruct, AActor* Owner, APawn* Instigator, FString& Error);
 
+	// Every class referenced by the preset without loading any of them
+	static TArray<FSoftObjectPath> GetBinaryPresetClassPaths(const TArray<uint8>& BinaryPreset, FString& Error);
+	static TArray<FSoftObjectPath> GetJsonPresetClassPaths(const FString& JsonString, FString& Error);
+	static TSharedPtr<FStreamableHandle> RequestPresetClassesAsyncLoad(TArray<FSoftObjectPath> ClassPaths, FStreamableDelegate OnLoaded, TAsyncLoadPriority Priority = FStreamableManager::AsyncLoadHighPriority);
+	// Issues a single batched load for every class used by the presets (such as a squads loadouts). Keep the handle alive until constructed
+	static TSharedPtr<FStreamableHandle> PreloadBinaryPresets(const TArray<TArray<uint8>>& BinaryPresets, FStreamableDelegate OnLoaded, TAsyncLoadPriority Priority = FStreamableManager::AsyncLoadHighPriority);
+	static TSharedPtr<FStreamableHandle> PreloadJsonPresets(const TArray<FString>& JsonPresets, FStreamableDelegate OnLoaded, TAsyncLoadPriority Priority = FStreamableManager::AsyncLoadHighPriority);
+	// Loads every class in the preset in one batch and constructs the whole attachment parent once they are all resident
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Serialize", meta = (WorldContext = "WorldContextObject"))
+	static void ConstructAttachmentParentBinaryAsync(UObject* WorldContextObject, const TArray<uint8>& BinaryPreset, AActor* Owner, APawn* Instigator, FOnAttachmentParentConstructed OnConstructed, int32 Priority = 100);
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|Serialize", meta = (WorldContext = "WorldContextObject"))
+	static void ConstructAttachmentParentJsonAsync(UObject* WorldContextObject, const FString& JsonString, AActor* Owner, APawn* Instigator, FOnAttachmentParentConstructed OnConstructed, int32 Priority = 100);
+
 	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|File")
 	static bool SaveStringToFile(const FString& Path, const FString& FileName, const FString& FileContent);
 	UFUNCTION(BlueprintPure, Category = "SKGAttachment|File")
 	static bool LoadFileToString(const FString& Path, const FString& FileName, FString& OutString);
+	UFUNCTION(BlueprintCallable, Category = "SKGAttachment|File")
+	static bool SaveBytesToFile(const FString& Path, const FString& FileName, const TArray<uint8>& FileContent);
+	UFUNCTION(BlueprintPure, Category = "SKGAttachment|File")
+	static bool LoadFileToBytes(const FString& Path, const FString& FileName, TArray<uint8>& OutBytes);
 	UFUNCTION(BlueprintPure, Category = "SKGAttachment|File")
 	static bool GetAllFiles(FString Path, TArray<FString>& OutFiles);
 };
@@ -35,6 +35,9 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "SKGAttachment|Customization")
 	float OffsetSnapDistance;
 	TWeakObjectPtr<UShapeComponent> OverlapCheckComponent;
+	// Overlaps are resolved through the attachment manager broadphase instead of physics overlap events
+	bool bResolveOverlaps;
+	void HandleAttachmentMoved();
 	
 	float AccumulatedOffset;
 	float OldAccumulatedOffset;
@@ -45,6 +48,8 @@ protected:
 	UFUNCTION()
 	void OnRep_CurrentOffset();
 	void ApplyAttachmentAttachOffset();
+	// The offset moved this attachment, a merged mesh containing it is stale
+	void InvalidateMergedAttachmentMesh();
 	UFUNCTION(Server, Unreliable, WithValidation)
 	void Server_SetOffset(float Offset);
 	
@@ -57,6 +62,10 @@ protected:
 
 	UPROPERTY()
 	TArray<USKGAttachmentComponent*> CachedAttachmentComponents;
+	// Set when an attachment below this changes, CachedAttachmentComponents is rebuilt on next access
+	bool bAttachmentCacheDirty;
+	// Root attachment manager, set when attached and cleared when detached or re-owned
+	TWeakObjectPtr<USKGAttachmentManager> CachedOwningAttachmentManager;
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SKGAttachment|AssetID")
 	FPrimaryAssetType AssetType;
@@ -73,6 +82,7 @@ protected:
 	virtual void MarkComponentsAsPendingKill() override;
 	
 	virtual void OnRep_AttachmentReplication() override;
+	virtual void OnRep_Owner() override;
 	UFUNCTION()
 	void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& HitResult);
 	UFUNCTION()
@@ -84,6 +94,16 @@ protected:
 	void CacheAttachments();
 	
 public:
+	virtual void SetOwner(AActor* NewOwner) override;
+	USKGAttachmentManager* GetOwningAttachmentManager();
+	// Clears the cached manager on this and every attachment below it
+	void InvalidateOwningAttachmentManager();
+	void MarkAttachmentCacheDirty() { bAttachmentCacheDirty = true; }
+	UShapeComponent* GetOverlapCheckComponent() const { return OverlapCheckComponent.Get(); }
+	bool IsResolvingOverlaps() const { return bResolveOverlaps; }
+	// Records the overlap state with OtherActor on the owning attachment component, same as the physics overlap events
+	void HandleAttachmentOverlap(AActor* OtherActor, bool bOverlapped);
+	
 	// ATTACHMENT INTERFACE
 	virtual void SetOwningAttachmentComponent_Implementation(USKGAttachmentComponent* AttachmentComponent) override;
 	virtual USKGAttachmentComponent* GetOwningAttachmentComponent_Implementation() override { return OwningAttachmentComponent; }
@@ -25,7 +25,8 @@ public class SKGAttachment : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Core"
+				"Core",
+				"NetCore"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -54,7 +55,8 @@ public class SKGAttachment : ModuleRules
 				"Json",
 				"JsonUtilities",
 				"DeveloperSettings",
-				"NetCore"
+				"MeshDescription",
+				"StaticMeshDescription"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
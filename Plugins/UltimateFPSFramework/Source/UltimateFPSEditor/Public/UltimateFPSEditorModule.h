@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+class UBlueprint;
+
 class FUltimateFPSEditorModule : public IModuleInterface
 {
 public:
@@ -12,4 +14,10 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	// Attachment blueprints compiled since the last OnBlueprintCompiled, their metadata gets regenerated
+	TArray<TWeakObjectPtr<UBlueprint>> CompiledAttachmentBlueprints;
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
+	void OnBlueprintCompiled();
 };
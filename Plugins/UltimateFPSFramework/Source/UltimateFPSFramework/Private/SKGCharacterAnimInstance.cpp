@@ -15,14 +15,52 @@
 #include "Engine/World.h"
 #include "GameFramework/Pawn.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Misc/SKGFPSFrameworkDeveloperSettings.h"
 
 DECLARE_CYCLE_STAT(TEXT("SKGAnimNativeUpdateEntire"), STAT_SKGNativeUpdateEntire, STATGROUP_SKGAnimInstance);
+DECLARE_CYCLE_STAT(TEXT("SKGAnimThreadSafeUpdate"), STAT_SKGThreadSafeUpdate, STATGROUP_SKGAnimInstance);
 DECLARE_CYCLE_STAT(TEXT("FirearmCollision"), STAT_SKGFirearmCollision, STATGROUP_SKGAnimInstance);
 DECLARE_CYCLE_STAT(TEXT("SKGRecoil"), STAT_SKGRecoil, STATGROUP_SKGAnimInstance);
+DECLARE_CYCLE_STAT(TEXT("GatherHeldActorSnapshot"), STAT_SKGGatherHeldActorSnapshot, STATGROUP_SKGAnimInstance);
+DECLARE_CYCLE_STAT(TEXT("BakeCurveTables"), STAT_SKGBakeCurveTables, STATGROUP_SKGAnimInstance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HeldActorInterfaceCalls"), STAT_SKGHeldActorInterfaceCalls, STATGROUP_SKGAnimInstance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AimSocketRecomputes"), STAT_SKGAimSocketRecomputes, STATGROUP_SKGAnimInstance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FullSignificanceCharacters"), STAT_SKGFullSignificance, STATGROUP_SKGAnimInstance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ReducedSignificanceCharacters"), STAT_SKGReducedSignificance, STATGROUP_SKGAnimInstance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("MinimalSignificanceCharacters"), STAT_SKGMinimalSignificance, STATGROUP_SKGAnimInstance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ServerMinimalCharacters"), STAT_SKGServerMinimal, STATGROUP_SKGAnimInstance);
+
+namespace SKGAnimInterp
+{
+	// Same result as UKismetMathLibrary::TLerp/TInterpTo but inlined, these run for every layer of every character on the animation worker threads
+	FORCEINLINE FTransform TLerp(const FTransform& A, const FTransform& B, float Alpha)
+	{
+		FTransform NormalizedA = A;
+		FTransform NormalizedB = B;
+		NormalizedA.NormalizeRotation();
+		NormalizedB.NormalizeRotation();
+		FTransform Result;
+		Result.Blend(NormalizedA, NormalizedB, Alpha);
+		return Result;
+	}
+
+	FORCEINLINE FTransform TInterpTo(const FTransform& Current, const FTransform& Target, float DeltaSeconds, float InterpSpeed)
+	{
+		if (InterpSpeed <= 0.0f)
+		{
+			return Target;
+		}
+		return TLerp(Current, Target, FMath::Clamp(DeltaSeconds * InterpSpeed, 0.0f, 1.0f));
+	}
+}
 
 USKGCharacterAnimInstance::USKGCharacterAnimInstance()
 {
 	bRunOnDedicatedServer = true;
+	bMinimalDedicatedServerUpdate = true;
+	bServerMinimalUpdate = false;
 	
 	AimInterpolationSpeed = 20.0f;
 	HeadAimingInterpolationSpeed = 6.0f;
@@ -36,6 +74,8 @@ USKGCharacterAnimInstance::USKGCharacterAnimInstance()
 
 	bUseProceduralSpine = true;
 	SpineBlendPercents = { 1.0f };
+	SpineRollTolerance = 0.01f;
+	SpineRoll = 0.0f;
 	
 	bInterpRelativeToHand = false;
 	bFirstRun = true;
@@ -83,11 +123,38 @@ USKGCharacterAnimInstance::USKGCharacterAnimInstance()
 	bIndexOrTagForced = false;
 
 	bApplyForwardVector = false;
+
+	bHeldActorSnapshotStale = true;
+	bHeldActorReportsEquipChanges = false;
+	bRunThreadSafeUpdate = false;
+	bPendingHeldActorPoseFinished = false;
+	FirearmCollisionProbeTolerance = 0.1f;
+	FirearmCollisionProbeMaxInterval = 0.1f;
+	FirearmCollisionQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(SKGFirearmCollision), false);
+	bFirearmCollisionProbeHit = false;
+	FirearmCollisionProbeTime = -UE_BIG_NUMBER;
+	PendingRecoilControlRotation = FRotator::ZeroRotator;
+	AimSocketVersion = 0;
+	bAimSocketDataStale = true;
+	bAimSocketThirdPerson = false;
+	bAimSocketFollowsHand = false;
+	ShotCounter = 0;
+	RecoilSampleTime = 0.0f;
+
+	AnimSignificance = ESKGAnimSignificance::Full;
+	FramesSinceProceduralUpdate = 0;
+	ProceduralDeltaSeconds = 0.0f;
+	bRunProceduralUpdate = true;
+	bProceduralOutputBlended = false;
 }
 
 void USKGCharacterAnimInstance::NativeBeginPlay()
 {
 	Super::NativeBeginPlay();
+
+	SignificanceSettings = GetDefault<USKGFPSFrameworkDeveloperSettings>()->GetAnimSignificanceSettings();
+	BakeSpineBoneWeights();
+	bServerMinimalUpdate = bRunOnDedicatedServer && bMinimalDedicatedServerUpdate && UKismetSystemLibrary::IsDedicatedServer(GetWorld());
 	
 	if (const AActor* OwningActor = GetOwningActor())
 	{
@@ -104,8 +171,19 @@ void USKGCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 	Super::NativeUpdateAnimation(DeltaSeconds);
 
 	SCOPE_CYCLE_COUNTER(STAT_SKGNativeUpdateEntire);
-	
-	if ((!bRunOnDedicatedServer && UKismetSystemLibrary::IsDedicatedServer(GetWorld())) || !CharacterComponent || bCustomizingFirearm) { return; }
+
+	bRunThreadSafeUpdate = false;
+	if ((!bRunOnDedicatedServer && UKismetSystemLibrary::IsDedicatedServer(GetWorld())) || !CharacterComponent)
+	{
+		PendingInputs.Reset();
+		return;
+	}
+
+	// Applied before anything is gathered so this update already reacts to them
+	ApplyPendingInputs();
+	if (bCustomizingFirearm) { return; }
+
+	ApplyThreadSafeResults();
 
 	FVector FPSVelocity = CharacterComponent->GetOwner()->GetVelocity();
 	FPSVelocity.Z = 0.0f;
@@ -114,26 +192,590 @@ void USKGCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 	CharacterDirection = UKismetAnimationLibrary::CalculateDirection(FPSVelocity, CharacterComponent->GetOwner()->GetActorRotation());
 
 	HeldActor = CharacterComponent->GetHeldActor();
-	HandleHeldActor(DeltaSeconds);
-	HandleFirearmCollision(DeltaSeconds);
+
+	if (bServerMinimalUpdate)
+	{
+		INC_DWORD_STAT(STAT_SKGServerMinimal);
+		GatherCharacterFrameData();
+		GatherHeldActorSnapshot();
+		if (IsValid(HeldActor) && HeldActorSnapshot.bIsProcedural)
+		{
+			HandleSprinting();
+		}
+		bRunThreadSafeUpdate = true;
+		return;
+	}
+	
+	UpdateAnimSignificance();
+	ProceduralDeltaSeconds += DeltaSeconds;
+	bRunProceduralUpdate = AnimSignificance == ESKGAnimSignificance::Full || ++FramesSinceProceduralUpdate >= SignificanceSettings.ReducedUpdateInterval;
+	
+	GatherCharacterFrameData();
+	if (bRunProceduralUpdate)
+	{
+		FramesSinceProceduralUpdate = 0;
+		GatherHeldActorSnapshot();
+		// Only the work that touches components, traces or broadcasts stays here, the rest runs in NativeThreadSafeUpdateAnimation
+		HandleHeldActor(ProceduralDeltaSeconds);
+		if (AnimSignificance != ESKGAnimSignificance::Minimal)
+		{
+			HandleFirearmCollision(ProceduralDeltaSeconds);
+		}
+	}
+	bRunThreadSafeUpdate = true;
+}
+
+void USKGCharacterAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+	SCOPE_CYCLE_COUNTER(STAT_SKGThreadSafeUpdate);
+	
+	if (!bRunThreadSafeUpdate) { return; }
+
+	if (bServerMinimalUpdate)
+	{
+		// Sway and lag are never updated here so the additive stays zero
+		HandleHeldActorServer(DeltaSeconds);
+		if (bInterpRecoil)
+		{
+			RecoilInterpTo(DeltaSeconds);
+		}
+		HandleSpine(DeltaSeconds);
+		return;
+	}
+
+	if (bRunProceduralUpdate)
+	{
+		// The interpolations continue from the real state, not from the blend shown last frame
+		if (bProceduralOutputBlended)
+		{
+			ApplyProceduralOutput(CurrentProceduralOutput);
+		}
+		HandleHeldActorThreadSafe(ProceduralDeltaSeconds);
+		if (bInterpRecoil)
+		{
+			RecoilInterpTo(ProceduralDeltaSeconds);
+		}
+		ProceduralDeltaSeconds = 0.0f;
+		AdditiveLocation = SwayLocation + RotationLagLocation;
+		AdditiveRotation = SwayRotation + RotationLagRotation + MovementLagRotation;
+		PreviousProceduralOutput = CurrentProceduralOutput;
+		CaptureProceduralOutput(CurrentProceduralOutput);
+	}
+	// Spine and lean interpolate every frame so reduced rate characters still move smoothly between procedural updates
 	HandleSpine(DeltaSeconds);
 
-	if (bInterpRecoil)
+	// Reduced tiers show the pose one update interval late and blend towards the latest update on the frames in between
+	bProceduralOutputBlended = AnimSignificance != ESKGAnimSignificance::Full;
+	if (bProceduralOutputBlended)
+	{
+		BlendProceduralOutput(static_cast<float>(FramesSinceProceduralUpdate) / FMath::Max(SignificanceSettings.ReducedUpdateInterval, 1));
+	}
+}
+
+void USKGCharacterAnimInstance::CaptureProceduralOutput(FSKGProceduralAnimOutput& Output) const
+{
+	Output.AdditiveLocation = AdditiveLocation;
+	Output.AdditiveRotation = AdditiveRotation;
+	Output.RecoilLocation = RecoilLocation;
+	Output.RecoilRotation = RecoilRotation;
+	Output.SightLocation = SightLocation;
+	Output.SightRotation = SightRotation;
+	Output.AimingAlpha = AimingAlpha;
+	Output.AimCurveLocation = AimCurveLocation;
+	Output.AimCurveRotation = AimCurveRotation;
+	Output.AimCurveAlpha = AimCurveAlpha;
+	Output.RelativeToHandLocation = RelativeToHandLocation;
+	Output.RelativeToHandRotation = RelativeToHandRotation;
+}
+
+void USKGCharacterAnimInstance::ApplyProceduralOutput(const FSKGProceduralAnimOutput& Output)
+{
+	AdditiveLocation = Output.AdditiveLocation;
+	AdditiveRotation = Output.AdditiveRotation;
+	RecoilLocation = Output.RecoilLocation;
+	RecoilRotation = Output.RecoilRotation;
+	SightLocation = Output.SightLocation;
+	SightRotation = Output.SightRotation;
+	AimingAlpha = Output.AimingAlpha;
+	AimCurveLocation = Output.AimCurveLocation;
+	AimCurveRotation = Output.AimCurveRotation;
+	AimCurveAlpha = Output.AimCurveAlpha;
+	RelativeToHandLocation = Output.RelativeToHandLocation;
+	RelativeToHandRotation = Output.RelativeToHandRotation;
+}
+
+void USKGCharacterAnimInstance::BlendProceduralOutput(float Alpha)
+{
+	const FSKGProceduralAnimOutput& From = PreviousProceduralOutput;
+	const FSKGProceduralAnimOutput& To = CurrentProceduralOutput;
+	AdditiveLocation = FMath::Lerp(From.AdditiveLocation, To.AdditiveLocation, Alpha);
+	AdditiveRotation = FMath::Lerp(From.AdditiveRotation, To.AdditiveRotation, Alpha);
+	RecoilLocation = FMath::Lerp(From.RecoilLocation, To.RecoilLocation, Alpha);
+	RecoilRotation = FMath::Lerp(From.RecoilRotation, To.RecoilRotation, Alpha);
+	SightLocation = FMath::Lerp(From.SightLocation, To.SightLocation, Alpha);
+	SightRotation = FMath::Lerp(From.SightRotation, To.SightRotation, Alpha);
+	AimingAlpha = FMath::Lerp(From.AimingAlpha, To.AimingAlpha, Alpha);
+	AimCurveLocation = FMath::Lerp(From.AimCurveLocation, To.AimCurveLocation, Alpha);
+	AimCurveRotation = FMath::Lerp(From.AimCurveRotation, To.AimCurveRotation, Alpha);
+	AimCurveAlpha = FMath::Lerp(From.AimCurveAlpha, To.AimCurveAlpha, Alpha);
+	RelativeToHandLocation = FMath::Lerp(From.RelativeToHandLocation, To.RelativeToHandLocation, Alpha);
+	RelativeToHandRotation = FMath::Lerp(From.RelativeToHandRotation, To.RelativeToHandRotation, Alpha);
+}
+
+void USKGCharacterAnimInstance::UpdateAnimSignificance()
+{
+	AnimSignificance = ESKGAnimSignificance::Full;
+	const USkeletalMeshComponent* InUseMesh = CharacterComponent->GetInUseMesh();
+	if (!SignificanceSettings.bEnabled || !InUseMesh || CharacterComponent->IsLocallyControlled() || GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		INC_DWORD_STAT(STAT_SKGFullSignificance);
+		return;
+	}
+
+	if (!InUseMesh->WasRecentlyRendered(SignificanceSettings.NotRenderedGracePeriod))
+	{
+		AnimSignificance = ESKGAnimSignificance::Minimal;
+		INC_DWORD_STAT(STAT_SKGMinimalSignificance);
+		return;
+	}
+
+	const FVector BoundsOrigin = InUseMesh->Bounds.Origin;
+	float MinDistance = UE_BIG_NUMBER;
+	float MaxScreenSize = 0.0f;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if (PlayerController && PlayerController->IsLocalController() && PlayerController->PlayerCameraManager)
+		{
+			const float Distance = FVector::Dist(PlayerController->PlayerCameraManager->GetCameraLocation(), BoundsOrigin);
+			const float HalfFOVTan = FMath::Tan(FMath::DegreesToRadians(PlayerController->PlayerCameraManager->GetFOVAngle() * 0.5f));
+			MinDistance = FMath::Min(MinDistance, Distance);
+			MaxScreenSize = FMath::Max(MaxScreenSize, InUseMesh->Bounds.SphereRadius / FMath::Max(Distance * HalfFOVTan, 1.0f));
+		}
+	}
+
+	if (MinDistance <= SignificanceSettings.FullMaxDistance || MaxScreenSize >= SignificanceSettings.FullMinScreenSize)
+	{
+		INC_DWORD_STAT(STAT_SKGFullSignificance);
+	}
+	else if (MinDistance <= SignificanceSettings.ReducedMaxDistance || MaxScreenSize >= SignificanceSettings.ReducedMinScreenSize)
+	{
+		AnimSignificance = ESKGAnimSignificance::Reduced;
+		INC_DWORD_STAT(STAT_SKGReducedSignificance);
+	}
+	else
+	{
+		AnimSignificance = ESKGAnimSignificance::Minimal;
+		INC_DWORD_STAT(STAT_SKGMinimalSignificance);
+	}
+}
+
+void USKGCharacterAnimInstance::GatherCharacterFrameData()
+{
+	FrameData.WorldTimeSeconds = GetWorld()->GetTimeSeconds();
+	bIsLocallyControlled = CharacterComponent->IsLocallyControlled();
+	FrameData.bIsLocallyControlled = bIsLocallyControlled;
+	FrameData.bIsInThirdPerson = CharacterComponent->IsInThirdPerson();
+	FrameData.ControlRotation = CharacterComponent->GetControlRotation();
+	CharacterComponent->UpdateRemoteControlYaw();
+	FrameData.BaseAimRotation = CharacterComponent->GetBaseAimRotation();
+	FrameData.ActorRotation = CharacterComponent->GetOwner()->GetActorRotation();
+	FrameData.ActorRightVector = CharacterComponent->GetActorRightVector();
+	
+	const UPawnMovementComponent* MovementComponent = CharacterComponent->GetMovementComponent();
+	FrameData.MovementVelocity = MovementComponent ? MovementComponent->Velocity : FVector::ZeroVector;
+	FrameData.MovementComponentSprintSpeed = CharacterComponent->GetMovementComponentSprintSpeed();
+	
+	if (const USkeletalMeshComponent* InUseMesh = CharacterComponent->GetInUseMesh())
+	{
+		FrameData.CameraSocketTransform = InUseMesh->GetSocketTransform(CharacterComponent->GetCameraSocket(), RTS_ParentBoneSpace);
+	}
+	FrameData.RightHandAxis = CharacterComponent->GetRightHandAxis();
+
+	// Only used while a lean interpolates. SetLeaning starts one, so every new lean still picks up the current curves
+	if (bInterpLeaning)
+	{
+		FrameData.LeanSettings = CharacterComponent->GetLeanSettings();
+		FrameData.LeanSpeed = CharacterComponent->GetLeanSpeed(false);
+		FrameData.EndLeanSpeed = CharacterComponent->GetLeanSpeed(true);
+		if (FrameData.LeanSettings.bAllowOverrideFromAimingActor && IsValid(HeldActor) && HeldActorSnapshot.bIsProcedural)
+		{
+			INC_DWORD_STAT(STAT_SKGHeldActorInterfaceCalls);
+		}
+	}
+}
+
+void USKGCharacterAnimInstance::ApplyThreadSafeResults()
+{
+	if (bPendingHeldActorPoseFinished)
+	{
+		bPendingHeldActorPoseFinished = false;
+		CharacterComponent->OnHeldActorPoseFinished.Broadcast();
+	}
+
+	if (!PendingRecoilControlRotation.IsZero())
+	{
+		CharacterComponent->AddControlRotation(PendingRecoilControlRotation);
+		PendingRecoilControlRotation = FRotator::ZeroRotator;
+	}
+}
+
+FSKGPendingAnimInput& USKGCharacterAnimInstance::QueueInput(FSKGPendingAnimInput::EType Type)
+{
+	check(IsInGameThread());
+	// A later call of the same setter replaces the earlier one, it would have overwritten the same state anyway
+	const int32 Index = PendingInputs.IndexOfByPredicate([Type](const FSKGPendingAnimInput& Input) { return Input.Type == Type; });
+	if (Index != INDEX_NONE)
+	{
+		if (Type == FSKGPendingAnimInput::EType::Recoil)
+		{
+			return PendingInputs[Index];
+		}
+		PendingInputs.RemoveAt(Index, 1, false);
+	}
+	FSKGPendingAnimInput& Input = PendingInputs.AddDefaulted_GetRef();
+	Input.Type = Type;
+	return Input;
+}
+
+void USKGCharacterAnimInstance::ApplyPendingInputs()
+{
+	for (int32 Index = 0; Index < PendingInputs.Num(); ++Index)
+	{
+		const FSKGPendingAnimInput& Input = PendingInputs[Index];
+		switch (Input.Type)
+		{
+		case FSKGPendingAnimInput::EType::Aiming: ApplyIsAiming(Input.bValue); break;
+		case FSKGPendingAnimInput::EType::HeadAiming: ApplyHeadAiming(Input.bValue); break;
+		case FSKGPendingAnimInput::EType::CycledSights: ApplyCycledSights(); break;
+		case FSKGPendingAnimInput::EType::ShakeCurve: ApplyFirearmShakeCurve(Input.bValue); break;
+		case FSKGPendingAnimInput::EType::CustomCurve: ApplyCustomCurve(Input.CurveData); break;
+		case FSKGPendingAnimInput::EType::Leaning: ApplyLeaning(Input.Value); break;
+		case FSKGPendingAnimInput::EType::FirearmPose: ApplyFirearmPose(Input.Pose); break;
+		case FSKGPendingAnimInput::EType::Reloading: ApplyIsReloading(Input.bValue, Input.Value); break;
+		case FSKGPendingAnimInput::EType::Recoil: ApplyRecoil(Input.Value, Input.Count); break;
+		case FSKGPendingAnimInput::EType::FreeLook: ApplyFreeLook(Input.bValue); break;
+		}
+	}
+	PendingInputs.Reset();
+}
+
+void USKGCharacterAnimInstance::SetIsAiming(bool IsAiming)
+{
+	QueueInput(FSKGPendingAnimInput::EType::Aiming).bValue = IsAiming;
+}
+
+void USKGCharacterAnimInstance::SetHeadAiming(bool IsAiming)
+{
+	QueueInput(FSKGPendingAnimInput::EType::HeadAiming).bValue = IsAiming;
+}
+
+void USKGCharacterAnimInstance::CycledSights()
+{
+	QueueInput(FSKGPendingAnimInput::EType::CycledSights);
+}
+
+void USKGCharacterAnimInstance::PlayFirearmShakeCurve(bool ManuallyPlay)
+{
+	QueueInput(FSKGPendingAnimInput::EType::ShakeCurve).bValue = ManuallyPlay;
+}
+
+void USKGCharacterAnimInstance::PlayCustomCurve(FSKGCurveData INCurveData)
+{
+	QueueInput(FSKGPendingAnimInput::EType::CustomCurve).CurveData = INCurveData;
+}
+
+void USKGCharacterAnimInstance::SetLeaning(float TargetGraphTime)
+{
+	QueueInput(FSKGPendingAnimInput::EType::Leaning).Value = TargetGraphTime;
+}
+
+void USKGCharacterAnimInstance::SetFirearmPose(ESKGFirearmPose Pose)
+{
+	QueueInput(FSKGPendingAnimInput::EType::FirearmPose).Pose = Pose;
+}
+
+void USKGCharacterAnimInstance::SetIsReloading(bool IsReloading, float BlendAlpha)
+{
+	FSKGPendingAnimInput& Input = QueueInput(FSKGPendingAnimInput::EType::Reloading);
+	Input.bValue = IsReloading;
+	Input.Value = BlendAlpha;
+}
+
+void USKGCharacterAnimInstance::PerformRecoil(float Multiplier)
+{
+	FSKGPendingAnimInput& Input = QueueInput(FSKGPendingAnimInput::EType::Recoil);
+	Input.Value = Multiplier;
+	++Input.Count;
+}
+
+void USKGCharacterAnimInstance::SetFreeLook(bool FreeLook)
+{
+	QueueInput(FSKGPendingAnimInput::EType::FreeLook).bValue = FreeLook;
+}
+
+void USKGCharacterAnimInstance::GatherHeldActorSnapshot()
+{
+	SCOPE_CYCLE_COUNTER(STAT_SKGGatherHeldActorSnapshot);
+	if (!IsValid(HeldActor))
+	{
+		if (SnapshotHeldActor.IsValid() || StatsFirearm.IsValid())
+		{
+			BindFirearmStatsChanged(nullptr);
+		}
+		SnapshotHeldActor.Reset();
+		HeldActorSnapshot = FSKGHeldActorAnimSnapshot();
+		MovementSwayCurveTable.Reset();
+		ShakeCurveTable.Reset();
+		return;
+	}
+
+	if (SnapshotHeldActor.Get() != HeldActor)
+	{
+		BindFirearmStatsChanged(HeldActor);
+		GatherHeldActorEquipData();
+	}
+	else if (bHeldActorSnapshotStale)
+	{
+		GatherHeldActorEquipData();
+	}
+	else if (!bHeldActorReportsEquipChanges)
+	{
+		// Nothing tells us when another implementer's getters change, so they are asked again every update
+		GatherHeldActorEquipGetters();
+	}
+
+	if (HeldActorSnapshot.bIsProcedural)
+	{
+		HeldActorSnapshot.BasePoseOffset = ISKGProceduralAnimationInterface::Execute_GetBasePoseOffset(HeldActor);
+		HeldActorSnapshot.LeftHandIKData = ISKGProceduralAnimationInterface::Execute_GetLeftHandIKData(HeldActor);
+		HeldActorSnapshot.SprintPose = ISKGProceduralAnimationInterface::Execute_GetSprintPose(HeldActor);
+		HeldActorSnapshot.SuperSprintPose = ISKGProceduralAnimationInterface::Execute_GetSuperSprintPose(HeldActor);
+		HeldActorSnapshot.bUseBasePoseCorrection = ISKGProceduralAnimationInterface::Execute_GetUseBasePoseCorrection(HeldActor);
+		HeldActorSnapshot.SwayMultiplier = ISKGProceduralAnimationInterface::Execute_GetSwayMultiplier(HeldActor);
+		HeldActorSnapshot.AnimationIndex = ISKGProceduralAnimationInterface::Execute_GetAnimationIndex(HeldActor);
+		HeldActorSnapshot.AnimationGameplayTag = ISKGProceduralAnimationInterface::Execute_GetAnimationGameplayTag(HeldActor);
+		INC_DWORD_STAT_BY(STAT_SKGHeldActorInterfaceCalls, 8);
+
+		if (IsAimSocketDataStale())
+		{
+			GatherAimSocketData();
+		}
+	}
+	if (HeldActorSnapshot.bHasFirearmParts)
+	{
+		HeldActorSnapshot.AimStockOffset = ISKGFirearmPartsInterface::Execute_GetAimStockOffset(HeldActor);
+		INC_DWORD_STAT(STAT_SKGHeldActorInterfaceCalls);
+	}
+	if (HeldActorSnapshot.bHasFirearmCollision)
+	{
+		HeldActorSnapshot.CollisionSettings = ISKGFirearmCollisionInterface::Execute_GetCollisionSettings(HeldActor);
+		INC_DWORD_STAT(STAT_SKGHeldActorInterfaceCalls);
+	}
+}
+
+bool USKGCharacterAnimInstance::IsAimSocketDataStale() const
+{
+	const ASKGFirearm* Firearm = AimSocketFirearm.Get();
+	const USceneComponent* HeldActorRoot = HeldActor->GetRootComponent();
+	if (bAimSocketDataStale || !bAimSocketFollowsHand || !Firearm || !HeldActorRoot)
+	{
+		return true;
+	}
+	// The sockets are cached relative to the hand, so only a change on the firearm or in how it is attached moves them
+	return Firearm->GetAimSocketVersion() != AimSocketVersion || FrameData.bIsInThirdPerson != bAimSocketThirdPerson ||
+		HeldActorRoot->GetAttachParent() != AimSocketAttachParent.Get() || HeldActorRoot->GetAttachSocketName() != AimSocketAttachSocket ||
+		!HeldActorRoot->GetRelativeTransform().Equals(AimSocketHeldActorRelative);
+}
+
+void USKGCharacterAnimInstance::GatherAimSocketData()
+{
+	INC_DWORD_STAT(STAT_SKGAimSocketRecomputes);
+	bAimSocketDataStale = false;
+	bAimSocketThirdPerson = FrameData.bIsInThirdPerson;
+	bAimSocketFollowsHand = false;
+	const USkeletalMeshComponent* InUseMesh = CharacterComponent->GetInUseMesh();
+	if (const ASKGFirearm* Firearm = AimSocketFirearm.Get())
+	{
+		AimSocketVersion = Firearm->GetAimSocketVersion();
+	}
+	if (const USceneComponent* HeldActorRoot = HeldActor->GetRootComponent())
+	{
+		AimSocketAttachParent = HeldActorRoot->GetAttachParent();
+		AimSocketAttachSocket = HeldActorRoot->GetAttachSocketName();
+		AimSocketHeldActorRelative = HeldActorRoot->GetRelativeTransform();
+		// Cached relative to the hand, which only holds while the held actor rides on the hand bone itself
+		bAimSocketFollowsHand = InUseMesh && AimSocketAttachParent.Get() == InUseMesh && InUseMesh->GetSocketBoneName(AimSocketAttachSocket) == RightHandBone;
+	}
+
+	HeldActorSnapshot.HeadAimTransform = ISKGProceduralAnimationInterface::Execute_GetHeadAimTransform(HeldActor);
+	HeldActorSnapshot.NeckAimTransform = ISKGProceduralAnimationInterface::Execute_GetNeckAimTransform(HeldActor);
+	const FTransform Hand_RTransform = InUseMesh ? InUseMesh->GetSocketTransform(RightHandBone) : FTransform::Identity;
+	HeldActorSnapshot.DefaultAimSocketRelativeToHand = UKismetMathLibrary::MakeRelativeTransform(ISKGProceduralAnimationInterface::Execute_GetDefaultAimSocketTransform(HeldActor), Hand_RTransform);
+	HeldActorSnapshot.AimSocketRelativeToHand = UKismetMathLibrary::MakeRelativeTransform(ISKGProceduralAnimationInterface::Execute_GetAimSocketTransform(HeldActor), Hand_RTransform);
+	INC_DWORD_STAT_BY(STAT_SKGHeldActorInterfaceCalls, 4);
+}
+
+void USKGCharacterAnimInstance::GatherHeldActorEquipData()
+{
+	SnapshotHeldActor = HeldActor;
+	bHeldActorSnapshotStale = false;
+	HeldActorSnapshot = FSKGHeldActorAnimSnapshot();
+	AimSocketFirearm = Cast<ASKGFirearm>(HeldActor);
+	bAimSocketDataStale = true;
+	// ASKGFirearm invalidates on attachment and stats changes (and cycled sights come through ApplyCycledSights)
+	bHeldActorReportsEquipChanges = AimSocketFirearm.IsValid();
+
+	const UClass* HeldActorClass = HeldActor->GetClass();
+	HeldActorSnapshot.bIsProcedural = HeldActorClass->ImplementsInterface(USKGProceduralAnimationInterface::StaticClass());
+	HeldActorSnapshot.bIsFirearm = HeldActorClass->ImplementsInterface(USKGFirearmInterface::StaticClass());
+	HeldActorSnapshot.bHasFirearmParts = HeldActorClass->ImplementsInterface(USKGFirearmPartsInterface::StaticClass());
+	HeldActorSnapshot.bHasFirearmCollision = HeldActorClass->ImplementsInterface(USKGFirearmCollisionInterface::StaticClass());
+
+	GatherHeldActorEquipGetters();
+	if (HeldActorSnapshot.bIsFirearm)
+	{
+		HeldActorSnapshot.RecoilData = ISKGFirearmInterface::Execute_GetRecoilData(HeldActor);
+		INC_DWORD_STAT(STAT_SKGHeldActorInterfaceCalls);
+
+		// Same seed on every machine so the listen server, owner and simulated proxies see the same pattern
+		const int32 RecoilSeed = HeldActorSnapshot.RecoilData.RecoilSeed ? HeldActorSnapshot.RecoilData.RecoilSeed : static_cast<int32>(GetTypeHash(HeldActor->GetClass()->GetPathName()));
+		RecoilPattern.Build(HeldActorSnapshot.RecoilData, RecoilSeed);
+	}
+	else
+	{
+		RecoilPattern.Reset();
+	}
+	// Parts only change with attachments, so the ignore list is rebuilt here instead of every probe
+	ResetFirearmCollisionProbe();
+}
+
+void USKGCharacterAnimInstance::GatherHeldActorEquipGetters()
+{
+	if (HeldActorSnapshot.bIsProcedural)
+	{
+		HeldActorSnapshot.SwayMultipliers = ISKGProceduralAnimationInterface::Execute_GetSwayMultipliers(HeldActor);
+		ISKGProceduralAnimationInterface::Execute_GetCameraSettings(HeldActor, HeldActorSnapshot.CameraSettings);
+		HeldActorSnapshot.AimInterpolationMultiplier = ISKGProceduralAnimationInterface::Execute_GetAimInterpolationMultiplier(HeldActor);
+		HeldActorSnapshot.UnAimInterpolationMultiplier = ISKGProceduralAnimationInterface::Execute_GetUnAimInterpolationMultiplier(HeldActor);
+		HeldActorSnapshot.RotationLagInterpolationMultiplier = ISKGProceduralAnimationInterface::Execute_GetRotationLagInterpolationMultiplier(HeldActor);
+		HeldActorSnapshot.LeaningSpeedMultiplier = ISKGProceduralAnimationInterface::Execute_GetLeaningSpeedMultiplier(HeldActor);
+		HeldActorSnapshot.HighLowPortPoseInterpolationSpeed = ISKGProceduralAnimationInterface::Execute_GetHighLowPortPoseInterpolationSpeed(HeldActor);
+		HeldActorSnapshot.MaxSightDistanceOffset = ISKGProceduralAnimationInterface::Execute_GetMaxSightDistanceOffset(HeldActor);
+		HeldActorSnapshot.CurveAndShakeSettings = ISKGProceduralAnimationInterface::Execute_GetCurveAndShakeSettings(HeldActor);
+		INC_DWORD_STAT_BY(STAT_SKGHeldActorInterfaceCalls, 9);
+	}
+	BakeCurveTables();
+	if (HeldActorSnapshot.bIsFirearm)
+	{
+		if (const ASKGFirearmBase* Firearm = StatsFirearm.Get())
+		{
+			HeldActorSnapshot.FirearmStats = Firearm->GetFirearmStatsRef();
+		}
+		else
+		{
+			HeldActorSnapshot.FirearmStats = ISKGFirearmInterface::Execute_GetFirearmStats(HeldActor);
+			INC_DWORD_STAT(STAT_SKGHeldActorInterfaceCalls);
+		}
+	}
+	FirearmStats = HeldActorSnapshot.FirearmStats;
+	CacheFirearmStatsMultipliers();
+	if (HeldActorSnapshot.bHasFirearmParts)
+	{
+		HeldActorSnapshot.StockLengthOfPull = ISKGFirearmPartsInterface::Execute_GetStockLengthOfPull(HeldActor);
+		HeldActorSnapshot.CurrentSightActor = ISKGFirearmPartsInterface::Execute_GetCurrentSightActor(HeldActor);
+		INC_DWORD_STAT_BY(STAT_SKGHeldActorInterfaceCalls, 2);
+	}
+	if (HeldActorSnapshot.bHasFirearmCollision)
+	{
+		HeldActorSnapshot.FirearmGripSocket = ISKGFirearmCollisionInterface::Execute_GetFirearmGripSocket(HeldActor);
+		const FTransform MuzzleTransform = ISKGFirearmCollisionInterface::Execute_GetCollisionMuzzleSocketTransform(HeldActor);
+		HeldActorSnapshot.CollisionRelativeMuzzle = MuzzleTransform.GetRelativeTransform(HeldActor->GetActorTransform());
+		INC_DWORD_STAT_BY(STAT_SKGHeldActorInterfaceCalls, 2);
+	}
+}
+
+void USKGCharacterAnimInstance::BakeCurveTables()
+{
+	SCOPE_CYCLE_COUNTER(STAT_SKGBakeCurveTables);
+	const FSKGCurveAndShakeSettings& CurveAndShakeSettings = HeldActorSnapshot.CurveAndShakeSettings;
+	if (MovementSwayCurveTable.GetSourceCurve() != CurveAndShakeSettings.MovementSwayCurve)
+	{
+		MovementSwayCurveTable.Bake(CurveAndShakeSettings.MovementSwayCurve);
+		// Blend from the old sway into the new curve instead of snapping
+		bLerpingNewGraph = CurveAndShakeSettings.MovementSwayCurve != nullptr;
+	}
+	if (ShakeCurveTable.GetSourceCurve() != CurveAndShakeSettings.ShakeCurve)
+	{
+		ShakeCurveTable.Bake(CurveAndShakeSettings.ShakeCurve);
+	}
+}
+
+void USKGCharacterAnimInstance::CacheFirearmStatsMultipliers()
+{
+	const FSKGFirearmStats& Stats = HeldActorSnapshot.FirearmStats;
+	HeldActorSnapshot.VerticalRecoilMultiplier = Stats.VerticalRecoilMultiplier;
+	HeldActorSnapshot.HorizontalRecoilMultiplier = Stats.HorizontalRecoilMultiplier;
+	if (HeldActorSnapshot.bIsFirearm)
 	{
-		RecoilInterpTo(DeltaSeconds);
+		const float LagMultiplier = UKismetMathLibrary::NormalizeToRange(HeldActorSnapshot.RotationLagInterpolationMultiplier, -40.0f, 150.0f);
+		HeldActorSnapshot.RotationLagWeightMultiplier = UKismetMathLibrary::NormalizeToRange(Stats.Weight, 0.0f, 25.0f) * (0.3f / LagMultiplier);
+		HeldActorSnapshot.MovementSwayStatsMultiplier = FMath::Clamp(Stats.Weight * (Stats.Weight * 3.0f / (Stats.Ergonomics * 1.5f)) + 1.0f, 0.5f, 1.0f);
 	}
+	else
+	{
+		HeldActorSnapshot.RotationLagWeightMultiplier = 1.0f;
+		HeldActorSnapshot.MovementSwayStatsMultiplier = 1.1f;
+	}
+}
 
-	AdditiveLocation = SwayLocation + RotationLagLocation;
-	AdditiveRotation = SwayRotation + RotationLagRotation + MovementLagRotation;
+void USKGCharacterAnimInstance::BindFirearmStatsChanged(AActor* NewHeldActor)
+{
+	if (ASKGFirearmBase* OldFirearm = StatsFirearm.Get())
+	{
+		OldFirearm->OnFirearmStatsChanged.Remove(FirearmStatsChangedHandle);
+	}
+	FirearmStatsChangedHandle.Reset();
+	
+	StatsFirearm = Cast<ASKGFirearmBase>(NewHeldActor);
+	if (ASKGFirearmBase* NewFirearm = StatsFirearm.Get())
+	{
+		FirearmStatsChangedHandle = NewFirearm->OnFirearmStatsChanged.AddUObject(this, &USKGCharacterAnimInstance::OnFirearmStatsChanged);
+	}
+}
+
+void USKGCharacterAnimInstance::OnFirearmStatsChanged(ASKGFirearmBase* Firearm)
+{
+	// Stats also drive the aim and lag interpolation multipliers of the firearm, so the whole equip section is refreshed
+	bHeldActorSnapshotStale = true;
 }
 
 void USKGCharacterAnimInstance::HandleHeldActor(float DeltaSeconds)
 {
-	if (IsValid(HeldActor) && HeldActor->GetClass()->ImplementsInterface(USKGProceduralAnimationInterface::StaticClass()))
+	if (IsValid(HeldActor) && HeldActorSnapshot.bIsProcedural)
 	{
-		SetEssentials(DeltaSeconds);
 		HandleLeftHandIK();
 		HandleSprinting();
+		
+		if (FrameData.bIsLocallyControlled && bInterpCameraZoom)
+		{
+			InterpCameraZoom(DeltaSeconds);
+		}
+	}
+	else
+	{
+		bValidLeftHandPose = false;
+		LeftHandIKAlpha = 0.0f;
+	}
+}
+
+void USKGCharacterAnimInstance::HandleHeldActorThreadSafe(float DeltaSeconds)
+{
+	if (IsValid(HeldActor) && HeldActorSnapshot.bIsProcedural)
+	{
+		SetEssentials(DeltaSeconds);
 	
 		if (bInterpHeldActorPose)
 		{
@@ -142,7 +784,15 @@ void USKGCharacterAnimInstance::HandleHeldActor(float DeltaSeconds)
 
 		if (bInterpShakeCurve)
 		{
-			InterpShakeCurve(DeltaSeconds);
+			if (AnimSignificance == ESKGAnimSignificance::Minimal)
+			{
+				ShakeCurveAlpha = 0.0f;
+				bInterpShakeCurve = false;
+			}
+			else
+			{
+				InterpShakeCurve(DeltaSeconds);
+			}
 		}
 		
 		if (bInterpAiming)
@@ -154,15 +804,9 @@ void USKGCharacterAnimInstance::HandleHeldActor(float DeltaSeconds)
 			InterpHeadAimingAlpha(DeltaSeconds);
 		}
 		
-		if (CharacterComponent->IsLocallyControlled())
+		if (FrameData.bIsLocallyControlled)
 		{
-			if (bInterpCameraZoom)
-			{
-				InterpCameraZoom(DeltaSeconds);
-			}
-
-			const UPawnMovementComponent* MovementComponent = CharacterComponent->GetMovementComponent();
-			if ((MovementComponent && MovementComponent->Velocity.Size()) || (!MovementLagRotation.Equals(FRotator::ZeroRotator)))
+			if (FrameData.MovementVelocity.Size() || !MovementLagRotation.Equals(FRotator::ZeroRotator))
 			{
 				SetMovementLag(DeltaSeconds);
 			}
@@ -176,10 +820,22 @@ void USKGCharacterAnimInstance::HandleHeldActor(float DeltaSeconds)
 			InterpCustomCurve(DeltaSeconds);
 		}
 	}
-	else
+}
+
+void USKGCharacterAnimInstance::HandleHeldActorServer(float DeltaSeconds)
+{
+	if (IsValid(HeldActor) && HeldActorSnapshot.bIsProcedural)
 	{
-		bValidLeftHandPose = false;
-		LeftHandIKAlpha = 0.0f;
+		// Same interpolation as the clients so the server's sockets line up with what they see
+		SetEssentials(DeltaSeconds);
+		if (bInterpHeldActorPose)
+		{
+			InterpHeldActorPose(DeltaSeconds);
+		}
+		if (bInterpAiming)
+		{
+			InterpAimingAlpha(DeltaSeconds);
+		}
 	}
 }
 
@@ -187,7 +843,7 @@ void USKGCharacterAnimInstance::HandleLeftHandIK()
 {
 	if (CharacterComponent->GetUseLeftHandIK())
 	{	// Handles Left Hand IK and Pose
-		const FSKGLeftHandIKData LeftHandIKData = ISKGProceduralAnimationInterface::Execute_GetLeftHandIKData(HeldActor);
+		const FSKGLeftHandIKData& LeftHandIKData = HeldActorSnapshot.LeftHandIKData;
 		LeftHandPose = LeftHandIKData.GripAnimation;
 		if (LeftHandPose)
 		{
@@ -211,51 +867,15 @@ void USKGCharacterAnimInstance::HandleLeftHandIK()
 
 void USKGCharacterAnimInstance::HandleSpine(float DeltaSeconds)
 {
-	if (bUseProceduralSpine && !bFreeLook)
+	if (bUseProceduralSpine && !bFreeLook && AnimSignificance != ESKGAnimSignificance::Minimal)
 	{
-		if (!IsLocallyControlled())
+		const FRotator& AimRotation = FrameData.bIsLocallyControlled ? FrameData.ControlRotation : FrameData.BaseAimRotation;
+		SpineToInterpTo = FRotator(0.0f, 0.0f, -FRotator::NormalizeAxis(AimRotation.Pitch - FrameData.ActorRotation.Pitch));
+		if (!FMath::IsNearlyEqual(SpineRoll, SpineToInterpTo.Roll, SpineRollTolerance))
 		{
-			SpineToInterpTo = CharacterComponent->GetBaseAimRotation();
-			SpineToInterpTo = UKismetMathLibrary::NormalizedDeltaRotator(SpineToInterpTo, TryGetPawnOwner()->GetActorRotation());
-			SpineToInterpTo.Roll = (SpineToInterpTo.Pitch * -1.0f);
-			SpineToInterpTo.Pitch = 0.0f;
-			SpineToInterpTo.Yaw = 0.0f;
-			FRotator TempRotator = SpineToInterpTo;
-			for (uint8 i = 0; i < SpineBlendPercents.Num(); ++i)
-			{
-				TempRotator.Roll = SpineToInterpTo.Roll * SpineBlendPercents[i];
-				switch (i)
-				{
-				case 0: Spine0Rotation = UKismetMathLibrary::RInterpTo(Spine0Rotation, TempRotator, DeltaSeconds, 10.0f); break;
-				case 1: Spine1Rotation = UKismetMathLibrary::RInterpTo(Spine1Rotation, TempRotator, DeltaSeconds, 10.0f); break;
-				case 2: Spine2Rotation = UKismetMathLibrary::RInterpTo(Spine2Rotation, TempRotator, DeltaSeconds, 10.0f); break;
-				case 3: Spine3Rotation = UKismetMathLibrary::RInterpTo(Spine3Rotation, TempRotator, DeltaSeconds, 10.0f); break;
-				case 4: Spine4Rotation = UKismetMathLibrary::RInterpTo(Spine4Rotation, TempRotator, DeltaSeconds, 10.0f); break;
-				default: checkNoEntry(); break;
-				}
-			}
-		}
-		else
-		{
-			SpineToInterpTo = CharacterComponent->GetControlRotation();
-			SpineToInterpTo = UKismetMathLibrary::NormalizedDeltaRotator(SpineToInterpTo, TryGetPawnOwner()->GetActorRotation());
-			SpineToInterpTo.Roll = (SpineToInterpTo.Pitch * -1.0f);
-			SpineToInterpTo.Pitch = 0.0f;
-			SpineToInterpTo.Yaw = 0.0f;
-			FRotator TempRotator = SpineToInterpTo;
-			for (uint8 i = 0; i < SpineBlendPercents.Num(); ++i)
-			{
-				TempRotator.Roll = SpineToInterpTo.Roll * SpineBlendPercents[i];
-				switch (i)
-				{
-				case 0: Spine0Rotation = TempRotator; break;
-				case 1: Spine1Rotation = TempRotator; break;
-				case 2: Spine2Rotation = TempRotator; break;
-				case 3: Spine3Rotation = TempRotator; break;
-				case 4: Spine4Rotation = TempRotator; break;
-				default: checkNoEntry(); break;
-				}
-			}
+			// Remote characters smooth the replicated aim, locally controlled characters follow the control rotation directly
+			SpineRoll = FrameData.bIsLocallyControlled ? SpineToInterpTo.Roll : FMath::FInterpTo(SpineRoll, SpineToInterpTo.Roll, DeltaSeconds, 10.0f);
+			ApplySpineRoll();
 		}
 	}
 
@@ -265,22 +885,42 @@ void USKGCharacterAnimInstance::HandleSpine(float DeltaSeconds)
 	}
 }
 
+void USKGCharacterAnimInstance::BakeSpineBoneWeights()
+{
+	const int32 NumSpineBones = FMath::Min(SpineBlendPercents.Num(), MaxSpineBones);
+	SpineBoneWeights.SetNum(NumSpineBones);
+	for (int32 i = 0; i < NumSpineBones; ++i)
+	{
+		SpineBoneWeights[i] = SpineBlendPercents[i];
+	}
+	SpineRotations.Init(FRotator::ZeroRotator, NumSpineBones);
+	ApplySpineRoll();
+}
+
+void USKGCharacterAnimInstance::ApplySpineRoll()
+{
+	FRotator* BoneRotations[MaxSpineBones] = { &Spine0Rotation, &Spine1Rotation, &Spine2Rotation, &Spine3Rotation, &Spine4Rotation };
+	for (int32 i = 0; i < SpineBoneWeights.Num(); ++i)
+	{
+		SpineRotations[i].Roll = SpineRoll * SpineBoneWeights[i];
+		*BoneRotations[i] = SpineRotations[i];
+	}
+}
+
 void USKGCharacterAnimInstance::HandleFirearmCollision(float DeltaSeconds)
 {
 	SCOPE_CYCLE_COUNTER(STAT_SKGFirearmCollision);
 	if (IsValid(HeldActor) && IsValid(CharacterComponent) && CharacterComponent->IsUsingFirearmCollision())
 	{
-		if (HeldActor->GetClass()->ImplementsInterface(USKGFirearmCollisionInterface::StaticClass()))
+		if (HeldActorSnapshot.bHasFirearmCollision)
 		{
-			// UPDATE THIS IN CHARACTER COMPONENT UPON AIMING ACTOR CHANGED
-			FTransform FirearmGripOffset = CharacterComponent->GetInUseMesh()->GetSocketTransform(ISKGFirearmCollisionInterface::Execute_GetFirearmGripSocket(HeldActor), RTS_ParentBoneSpace);
+			FTransform FirearmGripOffset = CharacterComponent->GetInUseMesh()->GetSocketTransform(HeldActorSnapshot.FirearmGripSocket, RTS_ParentBoneSpace);
 			FirearmCollisionBoneLocationOffset = FirearmGripOffset.GetLocation();
 			FirearmCollisionBoneRotationOffset = FirearmGripOffset.Rotator();
-			CurrentCollisionSettings = ISKGFirearmCollisionInterface::Execute_GetCollisionSettings(HeldActor);
+			CurrentCollisionSettings = HeldActorSnapshot.CollisionSettings;
+			const FSKGCollisionSettings& CollisionSettings = CurrentCollisionSettings;
 		
-			const FTransform MuzzleTransform = ISKGFirearmCollisionInterface::Execute_GetCollisionMuzzleSocketTransform(HeldActor);
-			FTransform RelativeMuzzle = MuzzleTransform.GetRelativeTransform(HeldActor->GetActorTransform());
-			FSKGCollisionSettings CollisionSettings = ISKGFirearmCollisionInterface::Execute_GetCollisionSettings(HeldActor);
+			FTransform RelativeMuzzle = HeldActorSnapshot.CollisionRelativeMuzzle;
 			RelativeMuzzle.SetLocation(RelativeMuzzle.GetLocation() + CollisionSettings.MuzzlePositionOffset);
 		
 			float MuzzleDistanceToRoot = RelativeMuzzle.GetLocation().Size();
@@ -289,15 +929,12 @@ void USKGCharacterAnimInstance::HandleFirearmCollision(float DeltaSeconds)
 		
 			FVector End = (EndTransform).GetTranslation();
 			FVector Start = End + (EndTransform.Rotator().Vector() * -1.0f) * MuzzleDistanceToRoot + CollisionSettings.TraceStartOffset;
-		
-			FHitResult HitResult;
-			// Needs refactors to be set upon changes to the given firearm
-			TArray<AActor*> IgnoredActors;
-			IgnoredActors.Append(ISKGFirearmCollisionInterface::Execute_GetPartsToIgnore(HeldActor));
-			IgnoredActors.Add(CharacterComponent->GetOwner());
-			IgnoredActors.Add(HeldActor);
-			
-			const bool bHit = UKismetSystemLibrary::SphereTraceSingle(GetWorld(), Start, End, CurrentCollisionSettings.TraceRadius, UEngineTypes::ConvertToTraceType(CharacterComponent->GetFirearmCollisionChannel()), false, IgnoredActors, CurrentCollisionSettings.DebugTrace, HitResult, true);
+
+			// Consume last frames probe and queue the next one, the pose below reacts to the latest completed probe
+			UpdateFirearmCollisionProbe(Start, End);
+			const bool bHit = bFirearmCollisionProbeHit;
+			const FHitResult& HitResult = FirearmCollisionProbeHitResult;
+			End = FirearmCollisionProbeEnd;
 
 			if (bHit)
 			{
@@ -333,14 +970,14 @@ void USKGCharacterAnimInstance::HandleFirearmCollision(float DeltaSeconds)
 				{
 					if (bIsAiming && FirearmMovedDistance > CurrentCollisionSettings.PushDistanceToStopAiming)
 					{
-						SetFirearmPose(ESKGFirearmPose::None);
-						SetIsAiming(false);
+						ApplyFirearmPose(ESKGFirearmPose::None);
+						ApplyIsAiming(false);
 					}
 					else
 					{
 						if (!bIsAiming && CharacterComponent->IsAiming())
 						{
-							SetIsAiming(true);
+							ApplyIsAiming(true);
 						}
 					}
 					CollisionPose = FTransform();
@@ -348,14 +985,14 @@ void USKGCharacterAnimInstance::HandleFirearmCollision(float DeltaSeconds)
 
 					FTransform CurrentTransform = FTransform(FirearmCollisionRotation, FirearmCollisionLocation);
 					const FTransform InterpToTransform = FTransform(FRotator::ZeroRotator, Pose);
-					CurrentTransform = UKismetMathLibrary::TInterpTo(CurrentTransform, InterpToTransform, DeltaSeconds, CurrentCollisionSettings.InterpolationSpeed);
+					CurrentTransform = SKGAnimInterp::TInterpTo(CurrentTransform, InterpToTransform, DeltaSeconds, CurrentCollisionSettings.InterpolationSpeed);
 
 					FirearmCollisionLocation = CurrentTransform.GetLocation();
 					FirearmCollisionRotation = CurrentTransform.Rotator();
 				}
 				else
 				{
-					SetFirearmPose(ESKGFirearmPose::None);
+					ApplyFirearmPose(ESKGFirearmPose::None);
 					const FTransform ShortStockPose = ISKGFirearmCollisionInterface::Execute_GetCollisionShortStockPose(HeldActor);
 					float MaxPush = -ShortStockPose.GetLocation().Y;
 					ShortStockBlend = UKismetMathLibrary::NormalizeToRange(FirearmMovedDistance, 0.0f, MaxPush);
@@ -364,27 +1001,27 @@ void USKGCharacterAnimInstance::HandleFirearmCollision(float DeltaSeconds)
 					{
 						if (bIsAiming)
 						{
-							SetIsAiming(false);
+							ApplyIsAiming(false);
 						}
 					}
 					else
 					{
 						if (!bIsAiming && CharacterComponent->IsAiming())
 						{
-							SetIsAiming(true);
+							ApplyIsAiming(true);
 						}
 					}
 				
 					if (ShortStockBlend < CurrentCollisionSettings.ShortStockMaxDistance)
 					{
-						const FTransform ShortStockLerpped = UKismetMathLibrary::TLerp(FTransform(), ShortStockPose, ShortStockBlend);
-						CollisionPose = UKismetMathLibrary::TInterpTo(CollisionPose, ShortStockLerpped, DeltaSeconds, CurrentCollisionSettings.InterpolationSpeed);
+						const FTransform ShortStockLerpped = SKGAnimInterp::TLerp(FTransform(), ShortStockPose, ShortStockBlend);
+						CollisionPose = SKGAnimInterp::TInterpTo(CollisionPose, ShortStockLerpped, DeltaSeconds, CurrentCollisionSettings.InterpolationSpeed);
 					}
 					else
 					{
 						CollisionPose = ISKGFirearmCollisionInterface::Execute_GetCollisionPose(HeldActor);
 						const FTransform CurrentPoseTransform = FTransform(FirearmCollisionRotation, FirearmCollisionLocation);
-						CollisionPose = UKismetMathLibrary::TInterpTo(CurrentPoseTransform, CollisionPose, DeltaSeconds, CurrentCollisionSettings.InterpolationSpeed);
+						CollisionPose = SKGAnimInterp::TInterpTo(CurrentPoseTransform, CollisionPose, DeltaSeconds, CurrentCollisionSettings.InterpolationSpeed);
 
 						if (CollisionPose.GetLocation().Y < FirearmMovedDistance)
 						{
@@ -412,28 +1049,98 @@ void USKGCharacterAnimInstance::HandleFirearmCollision(float DeltaSeconds)
 				FirearmMovedDistance = 0.0f;
 				if (CharacterComponent->IsAiming())
 				{
-					SetIsAiming(true);
+					ApplyIsAiming(true);
 				}
 				else
 				{
-					SetFirearmPose(CharacterComponent->GetFirearmPose());
+					ApplyFirearmPose(CharacterComponent->GetFirearmPose());
 				}
 			}
 			else
 			{
 				if (!CharacterComponent->IsAiming())
 				{
-					SetFirearmPose(CharacterComponent->GetFirearmPose());
+					ApplyFirearmPose(CharacterComponent->GetFirearmPose());
 				}
 			}
 		}
 	}
 }
 
+void USKGCharacterAnimInstance::UpdateFirearmCollisionProbe(const FVector& Start, const FVector& End)
+{
+	UWorld* World = GetWorld();
+	if (FirearmCollisionTraceHandle.IsValid())
+	{
+		if (World->QueryTraceData(FirearmCollisionTraceHandle, FirearmCollisionTraceDatum))
+		{
+			FirearmCollisionTraceHandle = FTraceHandle();
+			const FHitResult* BlockingHit = FirearmCollisionTraceDatum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+			bFirearmCollisionProbeHit = BlockingHit != nullptr;
+			if (BlockingHit)
+			{
+				FirearmCollisionProbeHitResult = *BlockingHit;
+			}
+			FirearmCollisionProbeEnd = FirearmCollisionTraceDatum.End;
+			
+#if ENABLE_DRAW_DEBUG
+			if (CurrentCollisionSettings.DebugTrace != EDrawDebugTrace::None)
+			{
+				const bool bPersistent = CurrentCollisionSettings.DebugTrace == EDrawDebugTrace::Persistent;
+				const float LifeTime = CurrentCollisionSettings.DebugTrace == EDrawDebugTrace::ForDuration ? 5.0f : 0.0f;
+				const FVector TraceEnd = bFirearmCollisionProbeHit ? FirearmCollisionProbeHitResult.Location : FirearmCollisionTraceDatum.End;
+				DrawDebugLine(World, FirearmCollisionTraceDatum.Start, TraceEnd, FColor::Red, bPersistent, LifeTime);
+				DrawDebugSphere(World, TraceEnd, CurrentCollisionSettings.TraceRadius, 12, bFirearmCollisionProbeHit ? FColor::Green : FColor::Red, bPersistent, LifeTime);
+			}
+#endif
+		}
+		else if (World->IsTraceHandleValid(FirearmCollisionTraceHandle, false))
+		{	// Still in flight, keep using the last result
+			return;
+		}
+		else
+		{	// Result expired because this instance skipped an update (reduced significance, customizing), probe again now
+			FirearmCollisionTraceHandle = FTraceHandle();
+			FirearmCollisionProbeTime = -UE_BIG_NUMBER;
+		}
+	}
+
+	// Skip the probe while the weapon sits still relative to the world, the last result still applies
+	const float CurrentTime = FrameData.WorldTimeSeconds;
+	if (FirearmCollisionProbeEnd.Equals(End, FirearmCollisionProbeTolerance) && FirearmCollisionProbeStart.Equals(Start, FirearmCollisionProbeTolerance)
+		&& CurrentTime - FirearmCollisionProbeTime < FirearmCollisionProbeMaxInterval)
+	{
+		return;
+	}
+
+	FirearmCollisionProbeStart = Start;
+	FirearmCollisionProbeTime = CurrentTime;
+	FirearmCollisionTraceHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, Start, End, FQuat::Identity, CharacterComponent->GetFirearmCollisionChannel(),
+		FCollisionShape::MakeSphere(CurrentCollisionSettings.TraceRadius), FirearmCollisionQueryParams);
+}
+
+void USKGCharacterAnimInstance::ResetFirearmCollisionProbe()
+{
+	FirearmCollisionTraceHandle = FTraceHandle();
+	bFirearmCollisionProbeHit = false;
+	FirearmCollisionProbeTime = -UE_BIG_NUMBER;
+	FirearmCollisionQueryParams.ClearIgnoredActors();
+	if (CharacterComponent)
+	{
+		FirearmCollisionQueryParams.AddIgnoredActor(CharacterComponent->GetOwner());
+	}
+	if (HeldActorSnapshot.bHasFirearmCollision)
+	{
+		FirearmCollisionQueryParams.AddIgnoredActor(HeldActor);
+		FirearmCollisionQueryParams.AddIgnoredActors(ISKGFirearmCollisionInterface::Execute_GetPartsToIgnore(HeldActor));
+		INC_DWORD_STAT(STAT_SKGHeldActorInterfaceCalls);
+	}
+}
+
 void USKGCharacterAnimInstance::SetEssentials(float DeltaSeconds)
 {
-	BasePoseOffsetLocation = ISKGProceduralAnimationInterface::Execute_GetBasePoseOffset(HeldActor).GetLocation();
-	BasePoseOffsetRotation = ISKGProceduralAnimationInterface::Execute_GetBasePoseOffset(HeldActor).Rotator();
+	BasePoseOffsetLocation = HeldActorSnapshot.BasePoseOffset.GetLocation();
+	BasePoseOffsetRotation = HeldActorSnapshot.BasePoseOffset.Rotator();
 
 	//if (bInterpRelativeToHand)
 	{
@@ -444,12 +1151,12 @@ void USKGCharacterAnimInstance::SetEssentials(float DeltaSeconds)
 
 void USKGCharacterAnimInstance::InterpLeaning(float DeltaSeconds)
 {
-	const FSKGLeanCurves LeanGraphs = CharacterComponent->GetLeanSettings().LeanCurves;
+	const FSKGLeanCurves& LeanGraphs = FrameData.LeanSettings.LeanCurves;
 	if (LeanGraphs.IsValid())
 	{
 		const UCurveFloat* GraphToUse = LeanGraphs.LeanCurve;
 		bool bEndingLean = false;
-		if (!CharacterComponent->GetLeanSettings().bIncrementalLeaning && LeanGraphs.LeanEndCurve)
+		if (!FrameData.LeanSettings.bIncrementalLeaning && LeanGraphs.LeanEndCurve)
 		{
 			if ((GraphTimeToGoTo <= 0.0f && CurrentGraphTime < GraphTimeToGoTo) || (GraphTimeToGoTo >= 0.0f && CurrentGraphTime > GraphTimeToGoTo))
 			{
@@ -458,17 +1165,17 @@ void USKGCharacterAnimInstance::InterpLeaning(float DeltaSeconds)
 			}
 		}
 		
-		float InterpSpeed = CharacterComponent->GetLeanSpeed(bEndingLean);
-		if (HeldActor && HeldActor->GetClass()->ImplementsInterface(USKGProceduralAnimationInterface::StaticClass()))
+		float InterpSpeed = bEndingLean ? FrameData.EndLeanSpeed : FrameData.LeanSpeed;
+		if (HeldActor && HeldActorSnapshot.bIsProcedural)
 		{
-			InterpSpeed *= ISKGProceduralAnimationInterface::Execute_GetLeaningSpeedMultiplier(HeldActor);
+			InterpSpeed *= HeldActorSnapshot.LeaningSpeedMultiplier;
 		}
-		CurrentGraphTime = UKismetMathLibrary::FInterpTo_Constant(CurrentGraphTime, GraphTimeToGoTo, DeltaSeconds, InterpSpeed);
+		CurrentGraphTime = FMath::FInterpConstantTo(CurrentGraphTime, GraphTimeToGoTo, DeltaSeconds, InterpSpeed);
 		
 		float GraphValue = GraphToUse->GetFloatValue(CurrentGraphTime);
 		GraphValue = (CurrentGraphTime < 0.0f ? -GraphValue : GraphValue);
 		
-		GraphValue = UKismetMathLibrary::FInterpTo_Constant(LeanRotation.Pitch, GraphValue, DeltaSeconds, CharacterComponent->GetLeanSettings().LeaningSmoothInterpSpeed);
+		GraphValue = FMath::FInterpConstantTo(LeanRotation.Pitch, GraphValue, DeltaSeconds, FrameData.LeanSettings.LeaningSmoothInterpSpeed);
 		
 		LeanRotation.Pitch = GraphValue;
 		
@@ -479,7 +1186,7 @@ void USKGCharacterAnimInstance::InterpLeaning(float DeltaSeconds)
 	}
 }
 
-void USKGCharacterAnimInstance::SetLeaning(float TargetGraphTime)
+void USKGCharacterAnimInstance::ApplyLeaning(float TargetGraphTime)
 {
 	PressedGraphTime = CurrentGraphTime;
 	GraphTimeToGoTo = TargetGraphTime;
@@ -487,7 +1194,7 @@ void USKGCharacterAnimInstance::SetLeaning(float TargetGraphTime)
 	bInterpLeaning = true;
 }
 
-void USKGCharacterAnimInstance::SetFreeLook(bool FreeLook)
+void USKGCharacterAnimInstance::ApplyFreeLook(bool FreeLook)
 {
 	if (IsValid(CharacterComponent))
 	{
@@ -509,18 +1216,18 @@ void USKGCharacterAnimInstance::InterpRelativeToHand(float DeltaSeconds)
 	// Change InterpSpeed to weight of firearm
 	if (!bIndexOrTagForced)
 	{
-		AnimationIndex = ISKGProceduralAnimationInterface::Execute_GetAnimationIndex(HeldActor);
-		AnimationGameplayTag = ISKGProceduralAnimationInterface::Execute_GetAnimationGameplayTag(HeldActor);
+		AnimationIndex = HeldActorSnapshot.AnimationIndex;
+		AnimationGameplayTag = HeldActorSnapshot.AnimationGameplayTag;
 	}
 	
 	float InterpSpeed = AimInterpolationSpeed;
-	float Multiplier = ISKGProceduralAnimationInterface::Execute_GetAimInterpolationMultiplier(HeldActor);
+	float Multiplier = HeldActorSnapshot.AimInterpolationMultiplier;
 	Multiplier = UKismetMathLibrary::NormalizeToRange(Multiplier, -40.0f, 150.0f);
 	Multiplier = FMath::Clamp(Multiplier, 0.0f, 1.0f);
 	InterpSpeed *= Multiplier;
 
 	// Change InterpSpeed to be modified by firearm in hand
-	RelativeToHandTransform = UKismetMathLibrary::TInterpTo(RelativeToHandTransform, FinalRelativeHand, DeltaSeconds, InterpSpeed);
+	RelativeToHandTransform = SKGAnimInterp::TInterpTo(RelativeToHandTransform, FinalRelativeHand, DeltaSeconds, InterpSpeed);
 	RelativeToHandLocation = RelativeToHandTransform.GetLocation();
 	RelativeToHandRotation = RelativeToHandTransform.Rotator();
 	
@@ -528,9 +1235,8 @@ void USKGCharacterAnimInstance::InterpRelativeToHand(float DeltaSeconds)
 	float HandToSightOffset = 0.0f;
 	
 	bool bUseFixedCameraDistance = false;
-	FSKGAimCameraSettings CameraSettings;
-	ISKGProceduralAnimationInterface::Execute_GetCameraSettings(HeldActor, CameraSettings);
-	if (CharacterComponent->IsLocallyControlled() && !CharacterComponent->IsInThirdPerson())
+	const FSKGAimCameraSettings& CameraSettings = HeldActorSnapshot.CameraSettings;
+	if (FrameData.bIsLocallyControlled && !FrameData.bIsInThirdPerson)
 	{
 		bUseFixedCameraDistance = CameraSettings.bUseFixedCameraDistance;
 		if (bUseFixedCameraDistance)
@@ -555,12 +1261,12 @@ void USKGCharacterAnimInstance::InterpRelativeToHand(float DeltaSeconds)
 		}
 	}
 
-	if (!bUseFixedCameraDistance && HeldActor->GetClass()->ImplementsInterface(USKGFirearmPartsInterface::StaticClass()))
+	if (!bUseFixedCameraDistance && HeldActorSnapshot.bHasFirearmParts)
 	{
-		HandToSightOffset -= ISKGFirearmPartsInterface::Execute_GetStockLengthOfPull(HeldActor) / 2.0f;
+		HandToSightOffset -= HeldActorSnapshot.StockLengthOfPull / 2.0f;
 	}
 	
-	const float MaxOffset = ISKGProceduralAnimationInterface::Execute_GetMaxSightDistanceOffset(HeldActor);
+	const float MaxOffset = HeldActorSnapshot.MaxSightDistanceOffset;
 	if (HandToSightOffset > MaxOffset)
 	{
 		HandToSightOffset = MaxOffset;
@@ -575,14 +1281,14 @@ void USKGCharacterAnimInstance::InterpRelativeToHand(float DeltaSeconds)
 		HandToSightDistance -= HandToSightOffset;
 	}
 	
-	SightDistance = UKismetMathLibrary::FInterpTo(SightDistance, HandToSightDistance * -1.0f, DeltaSeconds, InterpSpeed);
+	SightDistance = FMath::FInterpTo(SightDistance, HandToSightDistance * -1.0f, DeltaSeconds, InterpSpeed);
 	SetSightTransform();
 
 	if (RelativeToHandTransform.Equals(FinalRelativeHand))
 	{
 		if (SprintAlpha == 0.0f)
 		{
-			if (HeldActor->Implements<USKGFirearmPartsInterface>() && ISKGFirearmPartsInterface::Execute_GetCurrentSightActor(HeldActor) != HeldActor)
+			if (HeldActorSnapshot.bHasFirearmParts && HeldActorSnapshot.CurrentSightActor != HeldActor)
 			{
 				const float Distance = FVector::Dist(FinalRelativeHand.GetLocation(), DefaultRelativeToHand.GetLocation());
 				if (Distance != 0.0f)
@@ -608,7 +1314,7 @@ void USKGCharacterAnimInstance::InterpRelativeToHand(float DeltaSeconds)
 
 void USKGCharacterAnimInstance::SetSightTransform()
 {
-	FTransform CameraTransform = CharacterComponent->GetInUseMesh()->GetSocketTransform(CharacterComponent->GetCameraSocket(), RTS_ParentBoneSpace);
+	FTransform CameraTransform = FrameData.CameraSocketTransform;
 
 	FRotator NewRot = FRotator::ZeroRotator;
 	NewRot.Roll += -90.0f;
@@ -619,7 +1325,7 @@ void USKGCharacterAnimInstance::SetSightTransform()
 	FVector CameraVector = CameraTransform.GetLocation();
 	const float AdditiveDistance = SightDistance + 10.0f;
 	
-	switch (CharacterComponent->GetRightHandAxis())
+	switch (FrameData.RightHandAxis)
 	{
 	case EAxis::Type::Y : CameraVector.Y += AdditiveDistance; break;
 	case EAxis::Type::Z : CameraVector.Z += AdditiveDistance; break;
@@ -627,13 +1333,13 @@ void USKGCharacterAnimInstance::SetSightTransform()
 	case EAxis::Type::None : break;
 	}
 
-	if (HeldActor->GetClass()->ImplementsInterface(USKGFirearmPartsInterface::StaticClass()))
+	if (HeldActorSnapshot.bHasFirearmParts)
 	{
-		const float LengthOfPull = ISKGFirearmPartsInterface::Execute_GetStockLengthOfPull(HeldActor);
+		const float LengthOfPull = HeldActorSnapshot.StockLengthOfPull;
 		StockLOPOffset.Y = -LengthOfPull;
-		if (!CharacterComponent->IsLocallyControlled() || CharacterComponent->IsInThirdPerson())
+		if (!FrameData.bIsLocallyControlled || FrameData.bIsInThirdPerson)
 		{
-			FVector StockOffset = ISKGFirearmPartsInterface::Execute_GetAimStockOffset(HeldActor) * -1.0f;
+			FVector StockOffset = HeldActorSnapshot.AimStockOffset * -1.0f;
 			StockOffset.Y -= LengthOfPull;
 			CameraVector.X += StockOffset.Z * -1.0f;
 			CameraVector.Z += StockOffset.X;
@@ -649,38 +1355,37 @@ void USKGCharacterAnimInstance::SetSightTransform()
 
 void USKGCharacterAnimInstance::SetRelativeToHand()
 {
-	if (IsValid(HeldActor) && HeldActor->GetClass()->ImplementsInterface(USKGProceduralAnimationInterface::StaticClass()))
+	if (IsValid(HeldActor) && HeldActorSnapshot.bIsProcedural)
 	{
-		const FTransform HeadAimTransform = ISKGProceduralAnimationInterface::Execute_GetHeadAimTransform(HeldActor);
+		const FTransform& HeadAimTransform = HeldActorSnapshot.HeadAimTransform;
 		HeadAimingLocation = HeadAimTransform.GetLocation();
 		HeadAimingRotation = HeadAimTransform.Rotator();
-		const FTransform NeckAimTransform = ISKGProceduralAnimationInterface::Execute_GetNeckAimTransform(HeldActor);
+		const FTransform& NeckAimTransform = HeldActorSnapshot.NeckAimTransform;
 		NeckAimingLocation = NeckAimTransform.GetLocation();
 		NeckAimingRotation = NeckAimTransform.Rotator();
 		SightAimingRotation = NeckAimingRotation.GetInverse() + HeadAimingRotation.GetInverse();
 
-		const FTransform DefaultTransform = ISKGProceduralAnimationInterface::Execute_GetDefaultAimSocketTransform(HeldActor);
-		FTransform SightSocketTransform = ISKGProceduralAnimationInterface::Execute_GetAimSocketTransform(HeldActor);
-
+		// Both sockets are already relative to the hand, blending them here matches blending in world space first
+		const FTransform& DefaultTransform = HeldActorSnapshot.DefaultAimSocketRelativeToHand;
 		if (SprintAlpha > 0.0f || SuperSprintAlpha > 0.0f || HeldActorPose != ESKGFirearmPose::None || FirearmCollisionAlpha > 0.0f)
 		{
-			SightSocketTransform = DefaultTransform;
+			FinalRelativeHand = DefaultTransform;
 		}
-		else if (ISKGProceduralAnimationInterface::Execute_GetUseBasePoseCorrection(HeldActor))
+		else if (HeldActorSnapshot.bUseBasePoseCorrection)
 		{
-			SightSocketTransform = UKismetMathLibrary::TLerp(DefaultTransform, SightSocketTransform, AimingAlpha);
+			FinalRelativeHand = SKGAnimInterp::TLerp(DefaultTransform, HeldActorSnapshot.AimSocketRelativeToHand, AimingAlpha);
 		}
-		
-		const FTransform Hand_RTransform = CharacterComponent->GetInUseMesh()->GetSocketTransform(RightHandBone);
-		FinalRelativeHand = UKismetMathLibrary::MakeRelativeTransform(SightSocketTransform, Hand_RTransform);
-	
-		DefaultRelativeToHand = UKismetMathLibrary::MakeRelativeTransform(DefaultTransform, Hand_RTransform);
+		else
+		{
+			FinalRelativeHand = HeldActorSnapshot.AimSocketRelativeToHand;
+		}
+		DefaultRelativeToHand = DefaultTransform;
 	}
 }
 
 void USKGCharacterAnimInstance::SetLeftHandIK()
 {
-	const FTransform LeftHandIK = ISKGProceduralAnimationInterface::Execute_GetLeftHandIKData(HeldActor).Transform;
+	const FTransform& LeftHandIK = HeldActorSnapshot.LeftHandIKData.Transform;
 	if (LeftHandIK.GetLocation().Equals(FVector::ZeroVector))
 	{
 		LeftHandIKAlpha = 0.0f; return;
@@ -702,28 +1407,28 @@ void USKGCharacterAnimInstance::InterpHeldActorPose(float DeltaSeconds)
 	if (HeldActorPoseGraphSettings.bUseLegacySystem)
 	{
 		FTransform ToInterpFrom = FTransform(HeldActorPoseRotation, HeldActorPoseLocation);
-		ToInterpFrom = UKismetMathLibrary::TInterpTo(ToInterpFrom, HeldActorPoseToInterpTo, DeltaSeconds, ISKGProceduralAnimationInterface::Execute_GetHighLowPortPoseInterpolationSpeed(HeldActor));
+		ToInterpFrom = SKGAnimInterp::TInterpTo(ToInterpFrom, HeldActorPoseToInterpTo, DeltaSeconds, HeldActorSnapshot.HighLowPortPoseInterpolationSpeed);
 		HeldActorPoseLocation = ToInterpFrom.GetLocation();
 		HeldActorPoseRotation = ToInterpFrom.Rotator();
 		
 		if (HeldActorPoseLocation.Equals(HeldActorPoseToInterpTo.GetLocation()) && HeldActorPoseRotation.Equals(HeldActorPoseToInterpTo.Rotator()))
 		{
-			CharacterComponent->OnHeldActorPoseFinished.Broadcast();
+			bPendingHeldActorPoseFinished = true;
 			bInterpHeldActorPose = false;
 		}
 	}
 	else
 	{
-		HeldActorPoseCurrentTime = (GetWorld()->GetTimeSeconds() - HeldActorPoseStartTime) * HeldActorPoseGraphSettings.GetActiveCurveSetting().CurveSpeedMultiplier;
+		HeldActorPoseCurrentTime = (FrameData.WorldTimeSeconds - HeldActorPoseStartTime) * HeldActorPoseGraphSettings.GetActiveCurveSetting().CurveSpeedMultiplier;
 	
-		const FTransform PoseTransform = HeldActorPoseGraphSettings.GetTransform(HeldActorPoseCurrentTime, CharacterComponent->IsLocallyControlled());
+		const FTransform PoseTransform = HeldActorPoseGraphSettings.GetTransform(HeldActorPoseCurrentTime, FrameData.bIsLocallyControlled);
 
 		HeldActorPoseLocation = PoseTransform.GetLocation();
 		HeldActorPoseRotation = PoseTransform.Rotator();
 		
 		if (HeldActorPoseCurrentTime >= HeldActorPoseGraphSettings.GetActiveCurveSetting().CurveLength)
 		{
-			CharacterComponent->OnHeldActorPoseFinished.Broadcast();
+			bPendingHeldActorPoseFinished = true;
 			HeldActorPoseCurrentTime = 0.0f;
 			bInterpHeldActorPose = false;
 		}
@@ -735,7 +1440,7 @@ void USKGCharacterAnimInstance::InterpHeldActorPose(float DeltaSeconds)
 	}
 }
 
-void USKGCharacterAnimInstance::SetFirearmPose(ESKGFirearmPose Pose)
+void USKGCharacterAnimInstance::ApplyFirearmPose(ESKGFirearmPose Pose)
 {
 	if (IsValid(HeldActor) && HeldActorPose != Pose)
 	{
@@ -756,15 +1461,15 @@ void USKGCharacterAnimInstance::SetFirearmPose(ESKGFirearmPose Pose)
 			default: HeldActorPoseToInterpTo = FTransform(); HeldActorPoseGraphSettings.bGoIntoPose = false;
 			}
 			HeldActorPoseGraphSettings.bGoIntoPose = true;
-			SetIsAiming(false);
+			ApplyIsAiming(false);
 		}
 		else
 		{
 			HeldActorPoseToInterpTo = FTransform();
 			HeldActorPoseGraphSettings.bGoIntoPose = false;
-			if (HeldActorPoseGraphSettings.bUseLegacySystem && ISKGProceduralAnimationInterface::Execute_GetCurveAndShakeSettings(HeldActor).PerformShakeAfterPortPose)
+			if (HeldActorPoseGraphSettings.bUseLegacySystem && HeldActorSnapshot.CurveAndShakeSettings.PerformShakeAfterPortPose)
 			{
-				PlayFirearmShakeCurve(true);
+				ApplyFirearmShakeCurve(true);
 			}
 		}
 
@@ -773,6 +1478,9 @@ void USKGCharacterAnimInstance::SetFirearmPose(ESKGFirearmPose Pose)
 			RelativeToHandTransform = DefaultRelativeToHand;
 			RelativeToHandLocation = RelativeToHandTransform.GetLocation();
 			RelativeToHandRotation = RelativeToHandTransform.Rotator();
+			// Snapped, so reduced rate blending must not ease back from the old offset
+			PreviousProceduralOutput.RelativeToHandLocation = CurrentProceduralOutput.RelativeToHandLocation = RelativeToHandLocation;
+			PreviousProceduralOutput.RelativeToHandRotation = CurrentProceduralOutput.RelativeToHandRotation = RelativeToHandRotation;
 		}
 		HeldActorPoseAlpha = 1.0f;
 		bInterpHeldActorPose = true;
@@ -781,14 +1489,15 @@ void USKGCharacterAnimInstance::SetFirearmPose(ESKGFirearmPose Pose)
 
 void USKGCharacterAnimInstance::InterpShakeCurve(float DeltaSeconds)
 {
-	if (const UCurveVector* Curve = ISKGProceduralAnimationInterface::Execute_GetCurveAndShakeSettings(HeldActor).ShakeCurve)
+	const FSKGCurveAndShakeSettings& CurveAndShakeSettings = HeldActorSnapshot.CurveAndShakeSettings;
+	if (ShakeCurveTable.GetSourceCurve())
 	{
-		const float CurrentTime = (GetWorld()->GetTimeSeconds() - ShakeCurveStartTime) * ISKGProceduralAnimationInterface::Execute_GetCurveAndShakeSettings(HeldActor).ShakeCurveSpeed;
-		FVector Shake = Curve->GetVectorValue(CurrentTime);
-		Shake *= ISKGProceduralAnimationInterface::Execute_GetCurveAndShakeSettings(HeldActor).ShakeCurveMultplier;
+		const float CurrentTime = (FrameData.WorldTimeSeconds - ShakeCurveStartTime) * CurveAndShakeSettings.ShakeCurveSpeed;
+		FVector Shake = ShakeCurveTable.Evaluate(CurrentTime);
+		Shake *= CurveAndShakeSettings.ShakeCurveMultplier;
 		ShakeRotation = FRotator(Shake.X, Shake.Y, Shake.Z);
 
-		if (CurrentTime > ISKGProceduralAnimationInterface::Execute_GetCurveAndShakeSettings(HeldActor).ShakeCurveDuration)
+		if (CurrentTime > CurveAndShakeSettings.ShakeCurveDuration)
 		{
 			bInterpShakeCurve = false;
 			ShakeCurveAlpha = 0.0f;
@@ -807,7 +1516,7 @@ void USKGCharacterAnimInstance::InterpShakeCurve(float DeltaSeconds)
 	}
 }
 
-void USKGCharacterAnimInstance::PlayFirearmShakeCurve(bool ManuallyPlay)
+void USKGCharacterAnimInstance::ApplyFirearmShakeCurve(bool ManuallyPlay)
 {
 	if (IsValid(HeldActor) && bCanPlayShakeCurve)
 	{
@@ -823,7 +1532,7 @@ void USKGCharacterAnimInstance::InterpCustomCurve(float DeltaSeconds)
 {
 	if (IsValid(CustomCurveData.RotationCurve) || IsValid(CustomCurveData.LocationCurve))
 	{
-		const float CurrentTime = (GetWorld()->GetTimeSeconds() - CustomCurveStartTime) * CustomCurveData.CurveSpeed;
+		const float CurrentTime = (FrameData.WorldTimeSeconds - CustomCurveStartTime) * CustomCurveData.CurveSpeed;
 		if (CustomCurveData.LocationCurve)
 		{
 			CustomCurveLocation = CustomCurveData.LocationCurve->GetVectorValue(CurrentTime);
@@ -848,7 +1557,7 @@ void USKGCharacterAnimInstance::InterpCustomCurve(float DeltaSeconds)
 	}
 }
 
-void USKGCharacterAnimInstance::PlayCustomCurve(FSKGCurveData INCurveData)
+void USKGCharacterAnimInstance::ApplyCustomCurve(const FSKGCurveData& INCurveData)
 {
 	if (IsValid(INCurveData.RotationCurve) || IsValid(INCurveData.LocationCurve))
 	{
@@ -868,12 +1577,11 @@ void USKGCharacterAnimInstance::InterpCameraZoom(float DeltaSeconds)
 		float InterpSpeed = 10.0f;
 		if (bIsAiming)
 		{
-			FSKGAimCameraSettings CameraSettings;
-			ISKGProceduralAnimationInterface::Execute_GetCameraSettings(HeldActor, CameraSettings);
+			const FSKGAimCameraSettings& CameraSettings = HeldActorSnapshot.CameraSettings;
 			TargetFOV -= CameraSettings.CameraFOVZoom;
 			InterpSpeed = CameraSettings.CameraFOVZoomSpeed;
 		}
-		CurrentFOV = UKismetMathLibrary::FInterpTo(CurrentFOV, TargetFOV, DeltaSeconds, InterpSpeed);
+		CurrentFOV = FMath::FInterpTo(CurrentFOV, TargetFOV, DeltaSeconds, InterpSpeed);
 		CharacterComponent->SetCameraFOV(CurrentFOV);
 		if (CurrentFOV == TargetFOV)
 		{
@@ -888,21 +1596,21 @@ void USKGCharacterAnimInstance::InterpAimingAlpha(float DeltaSeconds)
 	float Multiplier;
 	if (bIsAiming)
 	{
-		Multiplier = ISKGProceduralAnimationInterface::Execute_GetAimInterpolationMultiplier(HeldActor);
+		Multiplier = HeldActorSnapshot.AimInterpolationMultiplier;
 	}
 	else
 	{
-		Multiplier = ISKGProceduralAnimationInterface::Execute_GetUnAimInterpolationMultiplier(HeldActor);
+		Multiplier = HeldActorSnapshot.UnAimInterpolationMultiplier;
 	}
 	
 	Multiplier = UKismetMathLibrary::NormalizeToRange(Multiplier, -40.0f, 150.0f);
 	InterpSpeed *= Multiplier;
 
-	AimingAlpha = UKismetMathLibrary::FInterpTo(AimingAlpha, bIsAiming - RotationAlpha, DeltaSeconds, InterpSpeed);
-	if (!AimCurveSettings.bUseLegacySystem && AimCurveSettings.IsValid())
+	AimingAlpha = FMath::FInterpTo(AimingAlpha, bIsAiming - RotationAlpha, DeltaSeconds, InterpSpeed);
+	if (!bServerMinimalUpdate && !AimCurveSettings.bUseLegacySystem && AimCurveSettings.IsValid())
 	{
 		AimCurveAlpha = bIsAiming ? 1.0f - AimingAlpha : AimingAlpha;
-		const float AimCurveTime = GetWorld()->GetTimeSeconds() - AimCurveStartTime;
+		const float AimCurveTime = FrameData.WorldTimeSeconds - AimCurveStartTime;
 		const FTransform AimCurves = AimCurveSettings.GetTransformMultiplied(AimCurveTime, true, 4.0f);
 		AimCurveLocation = AimCurves.GetLocation();
 		AimCurveRotation = AimCurves.Rotator();
@@ -917,7 +1625,7 @@ void USKGCharacterAnimInstance::InterpAimingAlpha(float DeltaSeconds)
 
 void USKGCharacterAnimInstance::InterpHeadAimingAlpha(float DeltaSeconds)
 {
-	HeadAimingAlpha = UKismetMathLibrary::FInterpTo(HeadAimingAlpha, bIsHeadAiming, DeltaSeconds, HeadAimingInterpolationSpeed);
+	HeadAimingAlpha = FMath::FInterpTo(HeadAimingAlpha, static_cast<float>(bIsHeadAiming), DeltaSeconds, HeadAimingInterpolationSpeed);
 	if (HeadAimingAlpha >= 1.0f || HeadAimingAlpha <= 0.0f)
 	{
 		bInterpHeadAimingAlpha = false;
@@ -927,26 +1635,21 @@ void USKGCharacterAnimInstance::InterpHeadAimingAlpha(float DeltaSeconds)
 void USKGCharacterAnimInstance::SetRotationLag(float DeltaSeconds)
 {
 	float InterpSpeed = RotationLagResetInterpolationSpeed;
-	float Multiplier = ISKGProceduralAnimationInterface::Execute_GetRotationLagInterpolationMultiplier(HeldActor);
+	float Multiplier = HeldActorSnapshot.RotationLagInterpolationMultiplier;
 	Multiplier = UKismetMathLibrary::NormalizeToRange(Multiplier, -40.0f, 150.0f);
 	InterpSpeed *= Multiplier;
 	// Temp Workaround for consistency
 	InterpSpeed *= 1.5f;
 	const float Delta = (1.0f - (DeltaSeconds * 35.0f));
 	
-	const FRotator CurrentRotation = CharacterComponent->GetControlRotation();
+	const FRotator CurrentRotation = FrameData.ControlRotation;
 	const FQuat Difference = (CurrentRotation - OldRotation).Quaternion() * Delta;
 
-	FRotator Rotation = UKismetMathLibrary::RInterpTo(UnmodifiedRotationLag, Difference.Rotator(), DeltaSeconds, InterpSpeed);
+	FRotator Rotation = FMath::RInterpTo(UnmodifiedRotationLag, Difference.Rotator(), DeltaSeconds, InterpSpeed);
 	UnmodifiedRotationLag = Rotation;
 
-	float FirearmWeightMultiplier = 1.0f;
-	if (HeldActor->Implements<USKGFirearmInterface>())
-	{
-		// Modify on HELD weapon weight	
-		FirearmWeightMultiplier = UKismetMathLibrary::NormalizeToRange(ISKGFirearmInterface::Execute_GetFirearmStats(HeldActor).Weight, 0.0f, 25.0f);
-		FirearmWeightMultiplier = FirearmWeightMultiplier * (0.3f / Multiplier);
-	}
+	// Modify on HELD weapon weight, computed once per stats change
+	const float FirearmWeightMultiplier = HeldActorSnapshot.RotationLagWeightMultiplier;
 	
 	Rotation *= 3.0f;
 	Rotation *= FirearmWeightMultiplier;
@@ -971,37 +1674,31 @@ void USKGCharacterAnimInstance::SetRotationLag(float DeltaSeconds)
 
 void USKGCharacterAnimInstance::SetMovementLag(float DeltaSeconds)
 {
-	const FVector FPSVelocity = CharacterComponent->GetMovementComponent()->Velocity;
-	float RightSpeed = FVector::DotProduct(FPSVelocity, CharacterComponent->GetActorRightVector());
+	const FVector& FPSVelocity = FrameData.MovementVelocity;
+	float RightSpeed = FVector::DotProduct(FPSVelocity, FrameData.ActorRightVector);
 	float VerticalSpeed = FPSVelocity.Z;
 	RightSpeed = UKismetMathLibrary::NormalizeToRange(RightSpeed, 0.0f, 75.0f);
 	VerticalSpeed = UKismetMathLibrary::NormalizeToRange(VerticalSpeed, 0.0f, 75.0f);
 
-	const FSKGSwayMultipliers SwayMultipliers = ISKGProceduralAnimationInterface::Execute_GetSwayMultipliers(HeldActor);
+	const FSKGSwayMultipliers& SwayMultipliers = HeldActorSnapshot.SwayMultipliers;
 	
 	FRotator NewRot = MovementLagRotation;
-	NewRot.Pitch = UKismetMathLibrary::FInterpTo(NewRot.Pitch, RightSpeed * SwayMultipliers.MovementRollMultiplier, DeltaSeconds, 10.0f);
-	NewRot.Yaw = UKismetMathLibrary::FInterpTo(NewRot.Yaw, (RightSpeed * SwayMultipliers.MovementYawMultiplier) * -1.0f, DeltaSeconds, 10.0f);
-	NewRot.Roll = UKismetMathLibrary::FInterpTo(NewRot.Roll, VerticalSpeed * SwayMultipliers.MovementPitchMultiplier, DeltaSeconds, 10.0f);
+	NewRot.Pitch = FMath::FInterpTo(NewRot.Pitch, RightSpeed * SwayMultipliers.MovementRollMultiplier, DeltaSeconds, 10.0f);
+	NewRot.Yaw = FMath::FInterpTo(NewRot.Yaw, (RightSpeed * SwayMultipliers.MovementYawMultiplier) * -1.0f, DeltaSeconds, 10.0f);
+	NewRot.Roll = FMath::FInterpTo(NewRot.Roll, VerticalSpeed * SwayMultipliers.MovementPitchMultiplier, DeltaSeconds, 10.0f);
 	
 	MovementLagRotation = NewRot;
 }
 
 void USKGCharacterAnimInstance::HandleMovementSway(float DeltaSeconds)
 {
-	if (UCurveVector* Curve = ISKGProceduralAnimationInterface::Execute_GetCurveAndShakeSettings(HeldActor).MovementSwayCurve)
+	if (MovementSwayCurveTable.GetSourceCurve())
 	{
-		if (!bLerpingNewGraph)
-		{
-			bLerpingNewGraph = Curve != CachedMovementCurve;
-		}
-		CachedMovementCurve = Curve;
-		
 		const float OldVelocityMultiplier = VelocityMultiplier;
-		VelocityMultiplier = UKismetMathLibrary::NormalizeToRange(CharacterVelocity, 0.0f, CharacterComponent->GetMovementComponentSprintSpeed());
+		VelocityMultiplier = UKismetMathLibrary::NormalizeToRange(CharacterVelocity, 0.0f, FrameData.MovementComponentSprintSpeed);
 		if (VelocityMultiplier < OldVelocityMultiplier)
 		{
-			VelocityMultiplier = UKismetMathLibrary::FInterpTo(OldVelocityMultiplier, VelocityMultiplier, DeltaSeconds, 3.2f);
+			VelocityMultiplier = FMath::FInterpTo(OldVelocityMultiplier, VelocityMultiplier, DeltaSeconds, 3.2f);
 		}
 		if (VelocityMultiplier < 0.25f)
 		{
@@ -1009,24 +1706,22 @@ void USKGCharacterAnimInstance::HandleMovementSway(float DeltaSeconds)
 		}
 		float Multiplier = 1.1f;
 		
-		if (ISKGProceduralAnimationInterface::Execute_GetCurveAndShakeSettings(HeldActor).ControlMovementSwayByStats && HeldActor->Implements<USKGFirearmInterface>())
+		if (HeldActorSnapshot.CurveAndShakeSettings.ControlMovementSwayByStats && HeldActorSnapshot.bIsFirearm)
 		{
-			const FSKGFirearmStats Stats = ISKGFirearmInterface::Execute_GetFirearmStats(HeldActor);
-			Multiplier = Stats.Weight * (Stats.Weight * 3.0f / (Stats.Ergonomics * 1.5f)) + 1.0f;
-			Multiplier = FMath::Clamp(Multiplier, 0.5f, 1.0f);
+			Multiplier = HeldActorSnapshot.MovementSwayStatsMultiplier;
 		}
 
-		SwayMultiplier = UKismetMathLibrary::FInterpTo(SwayMultiplier, ISKGProceduralAnimationInterface::Execute_GetSwayMultiplier(HeldActor), DeltaSeconds, 2.0f);
+		SwayMultiplier = FMath::FInterpTo(SwayMultiplier, HeldActorSnapshot.SwayMultiplier, DeltaSeconds, 2.0f);
 		
 		CurveTimer += (DeltaSeconds * VelocityMultiplier);
-		FVector Graph = Curve->GetVectorValue(CurveTimer);
+		FVector Graph = MovementSwayCurveTable.Evaluate(CurveTimer);
 		Graph *= VelocityMultiplier * Multiplier;
 		const FRotator Rotation = FRotator(Graph.Y, Graph.X, Graph.Z);
 		
 		if (bLerpingNewGraph)
 		{
-			SwayLocation = UKismetMathLibrary::VInterpTo(SwayLocation, Graph * SwayMultiplier, DeltaSeconds, CurveChangeInterpSpeed);
-			SwayRotation = UKismetMathLibrary::RInterpTo(SwayRotation, Rotation * SwayMultiplier, DeltaSeconds, CurveChangeInterpSpeed);
+			SwayLocation = FMath::VInterpTo(SwayLocation, Graph * SwayMultiplier, DeltaSeconds, CurveChangeInterpSpeed);
+			SwayRotation = FMath::RInterpTo(SwayRotation, Rotation * SwayMultiplier, DeltaSeconds, CurveChangeInterpSpeed);
 			if (SwayLocation.Equals(Graph * SwayMultiplier, CurveChangeEqualTolerance))
 			{
 				bLerpingNewGraph = false;
@@ -1054,14 +1749,14 @@ void USKGCharacterAnimInstance::HandleSprinting()
 		{
 			bInterpRelativeToHand = true;
 			bSprinting = true;
-			SetIsAiming(false);
+			ApplyIsAiming(false);
 		}
 
-		const FTransform SprintTransform = ISKGProceduralAnimationInterface::Execute_GetSprintPose(HeldActor);
+		const FTransform& SprintTransform = HeldActorSnapshot.SprintPose;
 		SprintPoseLocation = SprintTransform.GetLocation();
 		SprintPoseRotation = SprintTransform.Rotator();
 		
-		const FTransform SuperSprintTransform = ISKGProceduralAnimationInterface::Execute_GetSuperSprintPose(HeldActor);
+		const FTransform& SuperSprintTransform = HeldActorSnapshot.SuperSprintPose;
 		SuperSprintPoseLocation = SuperSprintTransform.GetLocation();
 		SuperSprintPoseRotation = SuperSprintTransform.Rotator();
 		
@@ -1102,7 +1797,7 @@ void USKGCharacterAnimInstance::HandleSprinting()
 		bSprinting = false;
 		if (CharacterComponent->IsAiming())
 		{
-			SetIsAiming(true);
+			ApplyIsAiming(true);
 		}
 		SprintAlpha = 0.0f;
 		SuperSprintAlpha = 0.0f;
@@ -1118,7 +1813,7 @@ bool USKGCharacterAnimInstance::IsLocallyControlled()
 	return bIsLocallyControlled;
 }
 
-void USKGCharacterAnimInstance::SetIsAiming(bool IsAiming)
+void USKGCharacterAnimInstance::ApplyIsAiming(bool IsAiming)
 {
 	if (!(FirearmMovedDistance > CurrentCollisionSettings.PushDistanceToStopAiming) || !IsAiming)
 	{
@@ -1137,7 +1832,7 @@ void USKGCharacterAnimInstance::SetIsAiming(bool IsAiming)
 
 		if (bIsAiming != IsAiming)
 		{
-			SetFirearmPose(ESKGFirearmPose::None);
+			ApplyFirearmPose(ESKGFirearmPose::None);
 			bIsAiming = IsAiming;
 			bInterpAiming = true;
 			bInterpCameraZoom = true;
@@ -1147,7 +1842,7 @@ void USKGCharacterAnimInstance::SetIsAiming(bool IsAiming)
 	}
 }
 
-void USKGCharacterAnimInstance::SetHeadAiming(bool IsAiming)
+void USKGCharacterAnimInstance::ApplyHeadAiming(bool IsAiming)
 {
 	if (IsAiming && (FirearmMovedDistance > CurrentCollisionSettings.PushDistanceToStopAiming))
 	{
@@ -1160,7 +1855,7 @@ void USKGCharacterAnimInstance::SetHeadAiming(bool IsAiming)
 	}
 }
 
-void USKGCharacterAnimInstance::SetIsReloading(bool IsReloading, float BlendAlpha)
+void USKGCharacterAnimInstance::ApplyIsReloading(bool IsReloading, float BlendAlpha)
 {
 	if (IsReloading)
 	{
@@ -1181,8 +1876,9 @@ void USKGCharacterAnimInstance::SetCanAim(bool CanAim)
 	bCanAim = CanAim;
 }
 
-void USKGCharacterAnimInstance::CycledSights()
+void USKGCharacterAnimInstance::ApplyCycledSights()
 {
+	bHeldActorSnapshotStale = true;
 	bInterpRelativeToHand = true;
 	bInterpCameraZoom = true;
 }
@@ -1201,12 +1897,13 @@ void USKGCharacterAnimInstance::ClearCustomPose()
 
 void USKGCharacterAnimInstance::RecoilInterpToZero(float DeltaSeconds)
 {
-	FinalRecoilTransform = UKismetMathLibrary::TInterpTo(FinalRecoilTransform, FTransform(), DeltaSeconds, 8.0f); // def = 6
+	FinalRecoilTransform = SKGAnimInterp::TInterpTo(FinalRecoilTransform, FTransform(), DeltaSeconds, 8.0f); // def = 6
 	RecoilLocation = FinalRecoilTransform.GetLocation();
 	RecoilRotation = FinalRecoilTransform.Rotator();
 	if (RecoilLocation.Equals(FVector::ZeroVector, 0.1f) && RecoilRotation.Equals(FRotator::ZeroRotator, 0.1f))
 	{
 		bInterpRecoil = false;
+		ShotCounter = 0;
 	}
 }
 
@@ -1214,36 +1911,32 @@ void USKGCharacterAnimInstance::RecoilInterpTo(float DeltaSeconds)
 {
 	SCOPE_CYCLE_COUNTER(STAT_SKGRecoil);
 	TRACE_CPUPROFILER_EVENT_SCOPE(SKGRecoilInterpTo)
-	if (IsValid(HeldActor) && HeldActor->GetClass()->ImplementsInterface(USKGFirearmInterface::StaticClass()))
+	if (IsValid(HeldActor) && HeldActorSnapshot.bIsFirearm)
 	{
-		const float CurrentTime = GetWorld()->GetTimeSeconds() - RecoilStartTime;
-		const FSKGRecoilData RecoilData = ISKGFirearmInterface::Execute_GetRecoilData(HeldActor);
-		const float VerticalRecoilMultiplier = ISKGFirearmInterface::Execute_GetFirearmStats(HeldActor).VerticalRecoilMultiplier * RecoilMultiplier;
-		const float HorizontalRecoilMultiplier = ISKGFirearmInterface::Execute_GetFirearmStats(HeldActor).HorizontalRecoilMultiplier * RecoilMultiplier;
-	
-		if (RecoilData.RecoilLocationCurve)
+		const float CurrentTime = FrameData.WorldTimeSeconds - RecoilStartTime;
+		const float PreviousTime = RecoilSampleTime;
+		RecoilSampleTime = CurrentTime;
+		const int32 Shot = FMath::Max(ShotCounter - 1, 0);
+		const float VerticalRecoilMultiplier = HeldActorSnapshot.VerticalRecoilMultiplier * RecoilMultiplier;
+		const float HorizontalRecoilMultiplier = HeldActorSnapshot.HorizontalRecoilMultiplier * RecoilMultiplier;
+
+		// The pattern holds the integral of each curve so the offset added over a span of time is the same at any frame rate
+		if (RecoilPattern.HasLocation())
 		{
-			const float Randomess = FMath::RandRange(RecoilData.RecoilLocationRandomness.Min, RecoilData.RecoilLocationRandomness.Max);
-			RecoilLocation += ((RecoilData.RecoilLocationCurve->GetVectorValue(CurrentTime) * Randomess) * RecoilMultiplier) * (100.0f * DeltaSeconds);
+			RecoilLocation += RecoilPattern.GetLocationDelta(Shot, PreviousTime, CurrentTime) * RecoilMultiplier;
 			FinalRecoilTransform.SetLocation(RecoilLocation);
 		}
-		if (RecoilData.RecoilRotationCurve)
+		if (RecoilPattern.HasRotation())
 		{
-			const FVector CurveData = RecoilData.RecoilRotationCurve->GetVectorValue(CurrentTime);
-			const float PitchRandom = (CurveData.X * FMath::RandRange(RecoilData.RecoilPitchRandomness.Min, RecoilData.RecoilPitchRandomness.Max)) * VerticalRecoilMultiplier;
-			const float YawRandom = (CurveData.Y * FMath::RandRange(RecoilData.RecoilYawRandomness.Min, RecoilData.RecoilYawRandomness.Max)) * HorizontalRecoilMultiplier;
-			const float RollRandom = (CurveData.Z * FMath::RandRange(RecoilData.RecoilRollRandomness.Min, RecoilData.RecoilRollRandomness.Max)) * HorizontalRecoilMultiplier;
-		
-			RecoilRotation += FRotator(RollRandom, PitchRandom, YawRandom) * (100.0f * DeltaSeconds);
+			const FVector Rotation = RecoilPattern.GetRotationDelta(Shot, PreviousTime, CurrentTime);
+			RecoilRotation += FRotator(Rotation.Z * HorizontalRecoilMultiplier, Rotation.X * VerticalRecoilMultiplier, Rotation.Y * HorizontalRecoilMultiplier);
 			FinalRecoilTransform.SetRotation(RecoilRotation.Quaternion());
 		}
-		if (RecoilData.bUseControlRotation && RecoilData.ControlRotationCurve && CharacterComponent && CharacterComponent->IsLocallyControlled())
+		if (RecoilPattern.HasControlRotation() && FrameData.bIsLocallyControlled)
 		{
-			const FVector CurveData = RecoilData.ControlRotationCurve->GetVectorValue(CurrentTime);
-			const float PitchRandom = ((CurveData.X * FMath::RandRange(RecoilData.ControlRotationPitchRandomness.Min, RecoilData.ControlRotationPitchRandomness.Max)) * VerticalRecoilMultiplier) * RecoilData.ControlRotationScale;
-			const float YawRandom = ((CurveData.Y * FMath::RandRange(RecoilData.ControlRotationYawRandomness.Min, RecoilData.ControlRotationYawRandomness.Max)) * HorizontalRecoilMultiplier) * RecoilData.ControlRotationScale;
-		
-			CharacterComponent->AddControlRotation(FRotator(PitchRandom, YawRandom, 0.0f) * (100.0f * DeltaSeconds));
+			const FVector2D ControlRotation = RecoilPattern.GetControlRotationDelta(Shot, PreviousTime, CurrentTime);
+			// Applied on the game thread at the start of the next update
+			PendingRecoilControlRotation += FRotator(ControlRotation.X * VerticalRecoilMultiplier, ControlRotation.Y * HorizontalRecoilMultiplier, 0.0f);
 		}
 		/*if (bApplyForwardVector && IsValid(HeldActor) && HeldActor->GetClass()->ImplementsInterface(USKGFirearmPartsInterface::StaticClass()))
 		{
@@ -1261,18 +1954,19 @@ void USKGCharacterAnimInstance::RecoilInterpTo(float DeltaSeconds)
 	}
 }
 
-void USKGCharacterAnimInstance::PerformRecoil(float Multiplier)
+void USKGCharacterAnimInstance::ApplyRecoil(float Multiplier, int32 NumShots)
 {
 	if (HeldActor)
 	{
 		RecoilStartTime = GetWorld()->GetTimeSeconds();
+		RecoilSampleTime = 0.0f;
 		RecoilMultiplier = Multiplier;
 
 		if (ShotCounter == 0)
 		{
 			ShotCounterStartTime = RecoilStartTime;
 		}
-		++ShotCounter;
+		ShotCounter += NumShots;
 		
 		bApplyForwardVector = true;
 		bInterpRecoil = true;
@@ -0,0 +1,95 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+
+#include "SKGInfraredWorldSubsystem.h"
+#include "Components/SKGCharacterComponent.h"
+
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("SKGInfraredStrobeToggles"), STAT_SKGInfraredStrobeToggles, STATGROUP_SKGCharacterComponent);
+
+namespace SKGInfraredStrobe
+{
+	static const FName InfraredStrobeOnName = FName("InfraredStrobeOn");
+}
+
+bool USKGInfraredWorldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USKGInfraredWorldSubsystem::Deinitialize()
+{
+	StopStrobe();
+	StrobeViewers.Empty();
+	Super::Deinitialize();
+}
+
+void USKGInfraredWorldSubsystem::UpdateStrobeViewer(USKGCharacterComponent* Viewer)
+{
+	if (!Viewer)
+	{
+		return;
+	}
+
+	const FSKGInfraredMaterialSettings& Settings = Viewer->GetInfraredMaterialSettings();
+	if (!Settings.bUseInfraredMaterialSettings || !Settings.InfraredMPC || !Viewer->NightVisionOn() || !Viewer->HasInfraredDevices())
+	{
+		RemoveStrobeViewer(Viewer);
+		return;
+	}
+
+	StrobeViewers.AddUnique(Viewer);
+	if (!IsStrobeRunning())
+	{
+		StrobeMPC = Settings.InfraredMPC;
+		const float Interval = FMath::Max(Settings.InfraredStrobeIntervalSeconds, KINDA_SMALL_NUMBER);
+		GetWorld()->GetTimerManager().SetTimer(StrobeTimerHandle, this, &USKGInfraredWorldSubsystem::ToggleStrobe, Interval, true);
+	}
+}
+
+void USKGInfraredWorldSubsystem::RemoveStrobeViewer(USKGCharacterComponent* Viewer)
+{
+	StrobeViewers.Remove(Viewer);
+	if (StrobeViewers.IsEmpty())
+	{
+		StopStrobe();
+	}
+}
+
+void USKGInfraredWorldSubsystem::ToggleStrobe()
+{
+	// Viewers can lose their devices (destroyed lights) without telling us, drop them here
+	StrobeViewers.RemoveAll([](const TWeakObjectPtr<USKGCharacterComponent>& Viewer)
+	{
+		return !Viewer.IsValid() || !Viewer->NightVisionOn() || !Viewer->HasInfraredDevices();
+	});
+	
+	if (StrobeViewers.IsEmpty() || !StrobeMPC.IsValid())
+	{
+		StopStrobe();
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_SKGInfraredStrobeToggles);
+	bStrobeOn = !bStrobeOn;
+	StrobeMPC->SetScalarParameterValue(SKGInfraredStrobe::InfraredStrobeOnName, bStrobeOn ? 1.0f : 0.0f);
+}
+
+void USKGInfraredWorldSubsystem::StopStrobe()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(StrobeTimerHandle);
+	}
+	StrobeTimerHandle.Invalidate();
+	
+	if (bStrobeOn && StrobeMPC.IsValid())
+	{
+		StrobeMPC->SetScalarParameterValue(SKGInfraredStrobe::InfraredStrobeOnName, 0.0f);
+	}
+	bStrobeOn = false;
+	StrobeMPC.Reset();
+}
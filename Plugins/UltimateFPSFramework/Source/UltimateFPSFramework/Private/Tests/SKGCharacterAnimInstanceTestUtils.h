@@ -0,0 +1,86 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SKGCharacterAnimInstance.h"
+#include "Actors/SKGFirearm.h"
+#include "Components/SKGCharacterComponent.h"
+#include "Misc/SKGFPSFrameworkDeveloperSettings.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+struct FSKGCharacterAnimInstanceTestAccess
+{
+	static void SetHeldActor(USKGCharacterAnimInstance* AnimInstance, AActor* HeldActor) { AnimInstance->HeldActor = HeldActor; }
+	static void GatherHeldActorSnapshot(USKGCharacterAnimInstance* AnimInstance) { AnimInstance->GatherHeldActorSnapshot(); }
+	static FSKGHeldActorAnimSnapshot& GetHeldActorSnapshot(USKGCharacterAnimInstance* AnimInstance) { return AnimInstance->HeldActorSnapshot; }
+	static const FSKGFirearmStats& GetFirearmStats(const USKGCharacterAnimInstance* AnimInstance) { return AnimInstance->FirearmStats; }
+	static const FSKGRecoilPattern& GetRecoilPattern(const USKGCharacterAnimInstance* AnimInstance) { return AnimInstance->RecoilPattern; }
+	static void SetWorldTime(USKGCharacterAnimInstance* AnimInstance, float WorldTimeSeconds) { AnimInstance->FrameData.WorldTimeSeconds = WorldTimeSeconds; }
+
+	static void ResetFirearmCollisionProbe(USKGCharacterAnimInstance* AnimInstance) { AnimInstance->ResetFirearmCollisionProbe(); }
+	static void UpdateFirearmCollisionProbe(USKGCharacterAnimInstance* AnimInstance, const FVector& Start, const FVector& End) { AnimInstance->UpdateFirearmCollisionProbe(Start, End); }
+	static FTraceHandle& GetFirearmCollisionTraceHandle(USKGCharacterAnimInstance* AnimInstance) { return AnimInstance->FirearmCollisionTraceHandle; }
+	static const FCollisionQueryParams& GetFirearmCollisionQueryParams(const USKGCharacterAnimInstance* AnimInstance) { return AnimInstance->FirearmCollisionQueryParams; }
+	static float GetFirearmCollisionProbeMaxInterval(const USKGCharacterAnimInstance* AnimInstance) { return AnimInstance->FirearmCollisionProbeMaxInterval; }
+	// Stands in for QueryTraceData returning a miss that ended at End
+	static void CompleteFirearmCollisionProbe(USKGCharacterAnimInstance* AnimInstance, const FVector& End)
+	{
+		AnimInstance->FirearmCollisionTraceHandle = FTraceHandle();
+		AnimInstance->bFirearmCollisionProbeHit = false;
+		AnimInstance->FirearmCollisionProbeEnd = End;
+	}
+};
+
+namespace SKGCharacterAnimInstanceTests
+{
+	struct FScopedTestWorld
+	{
+		UWorld* World;
+
+		FScopedTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+		}
+
+		~FScopedTestWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+	};
+
+	// Character component and anim instance on a bare actor, no skeletal mesh asset is needed for the gather and probe steps
+	inline USKGCharacterAnimInstance* CreateAnimInstance(UWorld* World)
+	{
+		AActor* Character = World->SpawnActor<AActor>();
+		USKGCharacterComponent* CharacterComponent = NewObject<USKGCharacterComponent>(Character);
+		USkeletalMeshComponent* Mesh = NewObject<USkeletalMeshComponent>(Character);
+		USKGCharacterAnimInstance* AnimInstance = NewObject<USKGCharacterAnimInstance>(Mesh);
+		AnimInstance->SetCharacterComponent(CharacterComponent);
+		return AnimInstance;
+	}
+
+	// The firearm requires a mesh carrying the FirearmMeshTag before its components are initialized
+	inline ASKGFirearm* SpawnFirearm(UWorld* World)
+	{
+		ASKGFirearm* Firearm = World->SpawnActorDeferred<ASKGFirearm>(ASKGFirearm::StaticClass(), FTransform::Identity);
+		UStaticMeshComponent* FirearmMesh = NewObject<UStaticMeshComponent>(Firearm, TEXT("FirearmMesh"));
+		FirearmMesh->ComponentTags.Add(GetDefault<USKGFPSFrameworkDeveloperSettings>()->FirearmMeshTag);
+		Firearm->SetRootComponent(FirearmMesh);
+		Firearm->AddInstanceComponent(FirearmMesh);
+		Firearm->FinishSpawning(FTransform::Identity);
+		return Firearm;
+	}
+}
+
+#endif
@@ -0,0 +1,160 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/SKGCharacterAnimInstanceTestUtils.h"
+#include "Actors/FirearmParts/SKGForwardGrip.h"
+#include "Actors/FirearmParts/SKGHandguard.h"
+#include "Actors/FirearmParts/SKGPart.h"
+#include "Components/SKGAttachmentComponent.h"
+#include "Components/SKGAttachmentManager.h"
+#include "Interfaces/SKGAttachmentInterface.h"
+#include "Misc/SKGAttachmentDeveloperSettings.h"
+
+#include "Algo/Sort.h"
+#include "UObject/UnrealType.h"
+
+namespace SKGFirearmPartIndexTests
+{
+	// Compatibility is normally set up in the editor, the test attaches anything anywhere
+	static USKGAttachmentComponent* CreateAttachmentComponent(AActor* Owner)
+	{
+		USKGAttachmentComponent* AttachmentComponent = NewObject<USKGAttachmentComponent>(Owner);
+		if (const FBoolProperty* AllowAllProperty = FindFProperty<FBoolProperty>(USKGAttachmentComponent::StaticClass(), TEXT("bAllowAllAttachments")))
+		{
+			AllowAllProperty->SetPropertyValue_InContainer(AttachmentComponent, true);
+		}
+		AttachmentComponent->SetupAttachment(Owner->GetRootComponent());
+		return AttachmentComponent;
+	}
+
+	template <typename PartType>
+	static PartType* SpawnPart(UWorld* World, int32 NumAttachmentComponents)
+	{
+		PartType* Part = World->SpawnActorDeferred<PartType>(PartType::StaticClass(), FTransform::Identity);
+		UStaticMeshComponent* PartMesh = NewObject<UStaticMeshComponent>(Part, TEXT("PartMesh"));
+		PartMesh->ComponentTags.Add(GetDefault<USKGAttachmentDeveloperSettings>()->AttachmentMeshTag);
+		Part->SetRootComponent(PartMesh);
+		Part->AddInstanceComponent(PartMesh);
+		for (int32 i = 0; i < NumAttachmentComponents; ++i)
+		{
+			Part->AddInstanceComponent(CreateAttachmentComponent(Part));
+		}
+		Part->FinishSpawning(FTransform::Identity);
+		return Part;
+	}
+
+	static TArray<USKGAttachmentComponent*> GetAttachmentComponents(AActor* Attachment)
+	{
+		return ISKGAttachmentInterface::Execute_GetAttachmentComponents(Attachment);
+	}
+
+	// Every attachment in the tree, walked with the public interface only
+	static void GatherAttachments(const TArray<USKGAttachmentComponent*>& AttachmentComponents, TArray<AActor*>& OutAttachments)
+	{
+		for (const USKGAttachmentComponent* AttachmentComponent : AttachmentComponents)
+		{
+			if (AActor* Attachment = AttachmentComponent->GetAttachment())
+			{
+				OutAttachments.Add(Attachment);
+				GatherAttachments(GetAttachmentComponents(Attachment), OutAttachments);
+			}
+		}
+	}
+
+	static TArray<AActor*> Sorted(TArray<AActor*> Attachments)
+	{
+		Algo::Sort(Attachments);
+		return Attachments;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGFirearmPartIndexTest, "UltimateFPSFramework.Firearm.PartIndexesMatchTree", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGFirearmPartIndexTest::RunTest(const FString& Parameters)
+{
+	using namespace SKGCharacterAnimInstanceTests;
+	using namespace SKGFirearmPartIndexTests;
+	FScopedTestWorld TestWorld;
+	ASKGFirearm* Firearm = SpawnFirearm(TestWorld.World);
+	USKGAttachmentManager* AttachmentManager = ISKGAttachmentInterface::Execute_GetAttachmentManager(Firearm);
+	if (!TestNotNull(TEXT("Firearm has an attachment manager"), AttachmentManager))
+	{
+		return false;
+	}
+	TArray<USKGAttachmentComponent*> RootComponents;
+	for (int32 i = 0; i < 3; ++i)
+	{
+		USKGAttachmentComponent* AttachmentComponent = CreateAttachmentComponent(Firearm);
+		AttachmentComponent->RegisterComponent();
+		AttachmentManager->AddAttachment(AttachmentComponent);
+		RootComponents.Add(AttachmentComponent);
+	}
+	// Builds the cache now instead of after the initial delay, every change from here on is incremental
+	AttachmentManager->GetAllAttachmentComponents(true);
+
+	const TArray<UClass*> Classes = { AActor::StaticClass(), ASKGAttachmentActor::StaticClass(), ASKGPart::StaticClass(), ASKGHandguard::StaticClass(), ASKGForwardGrip::StaticClass() };
+	auto CheckIndexes = [&](const TCHAR* Step)
+	{
+		TArray<AActor*> Attachments;
+		GatherAttachments(RootComponents, Attachments);
+		for (UClass* Class : Classes)
+		{
+			TArray<AActor*> Expected = Attachments.FilterByPredicate([Class](const AActor* Attachment) { return Attachment->IsA(Class); });
+			TestEqual(FString::Printf(TEXT("%s: attachments of class %s"), Step, *Class->GetName()), Sorted(AttachmentManager->GetAttachmentsOfClass(Class)), Sorted(Expected));
+
+			// The Blueprint lookup only looks at the top level components and matches the exact class
+			TArray<AActor*> ExpectedTopLevel;
+			for (const USKGAttachmentComponent* RootComponent : RootComponents)
+			{
+				if (RootComponent->GetAttachment() && RootComponent->GetAttachment()->GetClass() == Class)
+				{
+					ExpectedTopLevel.Add(RootComponent->GetAttachment());
+				}
+			}
+			TestEqual(FString::Printf(TEXT("%s: top level attachments of exactly %s"), Step, *Class->GetName()), AttachmentManager->GetAttachmentsOfType(Class), ExpectedTopLevel);
+		}
+
+		const UEnum* PartTypeEnum = StaticEnum<ESKGPartType>();
+		for (int32 i = 0; i < PartTypeEnum->NumEnums() - 1; ++i)
+		{
+			const ESKGPartType PartType = static_cast<ESKGPartType>(PartTypeEnum->GetValueByIndex(i));
+			TArray<AActor*> Expected = Attachments.FilterByPredicate([PartType](const AActor* Attachment)
+			{
+				return Attachment->Implements<USKGFirearmAttachmentsInterface>() && ISKGFirearmAttachmentsInterface::Execute_GetPartType(Attachment) == PartType;
+			});
+			TestEqual(FString::Printf(TEXT("%s: parts of type %s"), Step, *PartTypeEnum->GetNameStringByIndex(i)), Sorted(Firearm->GetPartsOfType(PartType)), Sorted(Expected));
+		}
+	};
+
+	ASKGHandguard* Handguard = SpawnPart<ASKGHandguard>(TestWorld.World, 2);
+	ASKGForwardGrip* Grip = SpawnPart<ASKGForwardGrip>(TestWorld.World, 0);
+	ASKGForwardGrip* OtherGrip = SpawnPart<ASKGForwardGrip>(TestWorld.World, 0);
+	ASKGPart* Part = SpawnPart<ASKGPart>(TestWorld.World, 0);
+
+	CheckIndexes(TEXT("Empty"));
+	RootComponents[0]->AddExistingAttachment(Handguard);
+	CheckIndexes(TEXT("Handguard"));
+	GetAttachmentComponents(Handguard)[1]->AddExistingAttachment(Grip);
+	CheckIndexes(TEXT("Grip on the handguard"));
+	RootComponents[1]->AddExistingAttachment(Part);
+	CheckIndexes(TEXT("Generic part"));
+	RootComponents[2]->AddExistingAttachment(OtherGrip);
+	CheckIndexes(TEXT("Grip on the firearm"));
+
+	GetAttachmentComponents(Handguard)[1]->ClearCurrentAttachment();
+	CheckIndexes(TEXT("Grip removed"));
+	GetAttachmentComponents(Handguard)[0]->AddExistingAttachment(Grip);
+	CheckIndexes(TEXT("Grip moved"));
+	RootComponents[0]->ClearCurrentAttachment();
+	CheckIndexes(TEXT("Handguard removed"));
+
+	// A full rebuild has to land on the same buckets
+	AttachmentManager->GetAllAttachmentComponents(true);
+	CheckIndexes(TEXT("Rebuilt"));
+	return true;
+}
+
+#endif
@@ -0,0 +1,46 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/SKGCharacterAnimInstanceTestUtils.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGFirearmStatsGatherTest, "UltimateFPSFramework.AnimInstance.FirearmStatsGather", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGFirearmStatsGatherTest::RunTest(const FString& Parameters)
+{
+	using namespace SKGCharacterAnimInstanceTests;
+	using FAccess = FSKGCharacterAnimInstanceTestAccess;
+	FScopedTestWorld TestWorld;
+	USKGCharacterAnimInstance* AnimInstance = CreateAnimInstance(TestWorld.World);
+	ASKGFirearm* Firearm = SpawnFirearm(TestWorld.World);
+
+	FAccess::SetHeldActor(AnimInstance, Firearm);
+	FAccess::GatherHeldActorSnapshot(AnimInstance);
+	const FSKGHeldActorAnimSnapshot& Snapshot = AnimInstance->GetHeldActorSnapshot();
+	TestTrue(TEXT("The firearm is gathered as a firearm"), Snapshot.bIsFirearm);
+	TestTrue(TEXT("Equipping builds the recoil pattern"), FAccess::GetRecoilPattern(AnimInstance).IsValid());
+
+	// Any stats read on the per frame path would overwrite the marker
+	constexpr float MarkerWeight = -1.0f;
+	FAccess::GetHeldActorSnapshot(AnimInstance).FirearmStats.Weight = MarkerWeight;
+	for (int32 Frame = 0; Frame < 10; ++Frame)
+	{
+		FAccess::GatherHeldActorSnapshot(AnimInstance);
+	}
+	TestEqual(TEXT("Per frame gathers do not read the firearm stats"), Snapshot.FirearmStats.Weight, MarkerWeight);
+
+	Firearm->OnFirearmStatsChanged.Broadcast(Firearm);
+	FAccess::GatherHeldActorSnapshot(AnimInstance);
+	TestEqual(TEXT("A stats change refreshes the gathered stats"), Snapshot.FirearmStats.Weight, Firearm->GetFirearmStatsRef().Weight);
+	TestEqual(TEXT("A stats change refreshes the anim instance stats"), FAccess::GetFirearmStats(AnimInstance).Weight, Firearm->GetFirearmStatsRef().Weight);
+
+	FAccess::SetHeldActor(AnimInstance, nullptr);
+	FAccess::GatherHeldActorSnapshot(AnimInstance);
+	TestFalse(TEXT("Unequipping unbinds from the stats change"), Firearm->OnFirearmStatsChanged.IsBound());
+	return true;
+}
+
+
+#endif
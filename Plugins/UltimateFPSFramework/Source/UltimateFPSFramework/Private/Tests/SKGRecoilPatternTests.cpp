@@ -0,0 +1,146 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "DataTypes/SKGFPSDataTypes.h"
+#include "Curves/CurveVector.h"
+#include "UObject/Package.h"
+
+namespace SKGRecoilPatternTests
+{
+	static constexpr int32 TestSeed = 1234;
+
+	struct FRecoilTotals
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Rotation = FVector::ZeroVector;
+		FVector2D ControlRotation = FVector2D::ZeroVector;
+	};
+
+	// Kick up, overshoot back down and settle, on every axis with a different scale so the axes do not mirror each other
+	static UCurveVector* CreateRecoilCurve()
+	{
+		UCurveVector* Curve = NewObject<UCurveVector>(GetTransientPackage(), NAME_None, RF_Transient);
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const float Scale = 1.0f + Axis * 0.5f;
+			Curve->FloatCurves[Axis].AddKey(0.0f, 0.0f);
+			Curve->FloatCurves[Axis].AddKey(0.04f, 1.0f * Scale);
+			Curve->FloatCurves[Axis].AddKey(0.15f, -0.35f * Scale);
+			Curve->FloatCurves[Axis].AddKey(0.4f, 0.0f);
+		}
+		return Curve;
+	}
+
+	static FSKGRecoilData CreateRecoilData(UCurveVector* Curve)
+	{
+		FSKGRecoilData RecoilData;
+		RecoilData.RecoilLocationCurve = Curve;
+		RecoilData.RecoilRotationCurve = Curve;
+		RecoilData.ControlRotationCurve = Curve;
+		RecoilData.bUseControlRotation = true;
+		return RecoilData;
+	}
+
+	// Steps the sample time the same way RecoilInterpTo does and sums the deltas until well past the end of the curve
+	static FRecoilTotals IntegrateShot(const FSKGRecoilPattern& Pattern, int32 ShotIndex, float StepSeconds)
+	{
+		FRecoilTotals Totals;
+		float SampleTime = 0.0f;
+		while (SampleTime < 1.0f)
+		{
+			const float PreviousTime = SampleTime;
+			SampleTime += StepSeconds;
+			Totals.Location += Pattern.GetLocationDelta(ShotIndex, PreviousTime, SampleTime);
+			Totals.Rotation += Pattern.GetRotationDelta(ShotIndex, PreviousTime, SampleTime);
+			Totals.ControlRotation += Pattern.GetControlRotationDelta(ShotIndex, PreviousTime, SampleTime);
+		}
+		return Totals;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGRecoilPatternFrameRateTest, "UltimateFPSFramework.RecoilPattern.FrameRateIndependent", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGRecoilPatternFrameRateTest::RunTest(const FString& Parameters)
+{
+	using namespace SKGRecoilPatternTests;
+	FSKGRecoilPattern Pattern;
+	Pattern.Build(CreateRecoilData(CreateRecoilCurve()), TestSeed);
+	TestTrue(TEXT("Pattern has location"), Pattern.HasLocation());
+	TestTrue(TEXT("Pattern has rotation"), Pattern.HasRotation());
+	TestTrue(TEXT("Pattern has control rotation"), Pattern.HasControlRotation());
+
+	constexpr double Tolerance = 1.e-3;
+	for (int32 ShotIndex = 0; ShotIndex < 3; ++ShotIndex)
+	{
+		const FRecoilTotals Totals30 = IntegrateShot(Pattern, ShotIndex, 1.0f / 30.0f);
+		const FRecoilTotals Totals144 = IntegrateShot(Pattern, ShotIndex, 1.0f / 144.0f);
+		TestFalse(FString::Printf(TEXT("Shot %d location kick is not zero"), ShotIndex), Totals30.Location.IsNearlyZero());
+		TestTrue(FString::Printf(TEXT("Shot %d location total at 30 Hz equals 144 Hz"), ShotIndex), Totals30.Location.Equals(Totals144.Location, Tolerance));
+		TestTrue(FString::Printf(TEXT("Shot %d rotation total at 30 Hz equals 144 Hz"), ShotIndex), Totals30.Rotation.Equals(Totals144.Rotation, Tolerance));
+		TestTrue(FString::Printf(TEXT("Shot %d control rotation total at 30 Hz equals 144 Hz"), ShotIndex), Totals30.ControlRotation.Equals(Totals144.ControlRotation, Tolerance));
+		TestTrue(FString::Printf(TEXT("Shot %d control rotation total equals its kick"), ShotIndex), Totals144.ControlRotation.Equals(Pattern.GetControlRotationKick(ShotIndex), Tolerance));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGRecoilPatternSeedTest, "UltimateFPSFramework.RecoilPattern.SameSeedSameKick", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGRecoilPatternSeedTest::RunTest(const FString& Parameters)
+{
+	using namespace SKGRecoilPatternTests;
+	const FSKGRecoilData RecoilData = CreateRecoilData(CreateRecoilCurve());
+	FSKGRecoilPattern Pattern;
+	FSKGRecoilPattern SameSeedPattern;
+	FSKGRecoilPattern OtherSeedPattern;
+	Pattern.Build(RecoilData, TestSeed);
+	SameSeedPattern.Build(RecoilData, TestSeed);
+	OtherSeedPattern.Build(RecoilData, TestSeed + 1);
+
+	bool bAnyShotDiffers = false;
+	for (int32 ShotIndex = 0; ShotIndex < FSKGRecoilPattern::NumShots; ++ShotIndex)
+	{
+		TestTrue(FString::Printf(TEXT("Shot %d kick with the same seed"), ShotIndex), Pattern.GetControlRotationKick(ShotIndex) == SameSeedPattern.GetControlRotationKick(ShotIndex));
+		TestEqual(FString::Printf(TEXT("Shot %d rotation with the same seed"), ShotIndex), Pattern.GetShot(ShotIndex).Rotation, SameSeedPattern.GetShot(ShotIndex).Rotation);
+		bAnyShotDiffers |= !Pattern.GetControlRotationKick(ShotIndex).Equals(OtherSeedPattern.GetControlRotationKick(ShotIndex));
+	}
+	TestTrue(TEXT("A different seed produces a different pattern"), bAnyShotDiffers);
+	TestTrue(TEXT("Shot indices past the table wrap"), Pattern.GetControlRotationKick(FSKGRecoilPattern::NumShots + 2) == Pattern.GetControlRotationKick(2));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSKGRecoilPatternStorageTest, "UltimateFPSFramework.RecoilPattern.RebuildReusesStorage", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSKGRecoilPatternStorageTest::RunTest(const FString& Parameters)
+{
+	using namespace SKGRecoilPatternTests;
+	const FSKGRecoilData RecoilData = CreateRecoilData(CreateRecoilCurve());
+	FSKGRecoilPattern Pattern;
+	Pattern.Build(RecoilData, TestSeed);
+
+	const FVector* LocationData = Pattern.LocationIntegral.GetData();
+	const FVector* RotationData = Pattern.RotationIntegral.GetData();
+	const FVector* ControlRotationData = Pattern.ControlRotationIntegral.GetData();
+	const FSKGRecoilPattern::FShotRandomness* ShotData = Pattern.Shots.GetData();
+	const SIZE_T AllocatedSize = Pattern.LocationIntegral.GetAllocatedSize() + Pattern.RotationIntegral.GetAllocatedSize() +
+		Pattern.ControlRotationIntegral.GetAllocatedSize() + Pattern.Shots.GetAllocatedSize();
+
+	// Sampling a burst and re-equipping the same firearm must not touch the heap
+	for (int32 ShotIndex = 0; ShotIndex < FSKGRecoilPattern::NumShots; ++ShotIndex)
+	{
+		IntegrateShot(Pattern, ShotIndex, 1.0f / 60.0f);
+	}
+	Pattern.Build(RecoilData, TestSeed);
+
+	TestTrue(TEXT("Location table kept its allocation"), Pattern.LocationIntegral.GetData() == LocationData);
+	TestTrue(TEXT("Rotation table kept its allocation"), Pattern.RotationIntegral.GetData() == RotationData);
+	TestTrue(TEXT("Control rotation table kept its allocation"), Pattern.ControlRotationIntegral.GetData() == ControlRotationData);
+	TestTrue(TEXT("Shot table kept its allocation"), Pattern.Shots.GetData() == ShotData);
+	TestTrue(TEXT("Allocated size is unchanged"), Pattern.LocationIntegral.GetAllocatedSize() + Pattern.RotationIntegral.GetAllocatedSize() +
+		Pattern.ControlRotationIntegral.GetAllocatedSize() + Pattern.Shots.GetAllocatedSize() == AllocatedSize);
+	return true;
+}
+
+#endif
@@ -36,6 +36,8 @@ protected:
 	
 	UFUNCTION(Server, Unreliable, WithValidation)
 	void Server_Flip(bool bFlip);
+	// Flipping changes which sight socket the firearm aims through
+	void MarkFirearmAimSocketsDirty();
 	
 public:
 	UFUNCTION(BlueprintCallable, Category = "SKGFPSFramework|Default")
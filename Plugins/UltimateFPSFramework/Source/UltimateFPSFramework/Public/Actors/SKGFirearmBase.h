@@ -14,6 +14,9 @@
 
 #define DEFAULT_STATS_MULTIPLIER (FirearmStats.Ergonomics * (10.0f / (FirearmStats.Weight * 1.5f)))
 
+class ASKGFirearmBase;
+DECLARE_MULTICAST_DELEGATE_OneParam(FSKGOnFirearmStatsChanged, ASKGFirearmBase*);
+
 UCLASS()
 class ULTIMATEFPSFRAMEWORK_API ASKGFirearmBase : public AActor, public ISKGAttachmentInterface, public ISKGFirearmPartsInterface
 {
@@ -46,8 +49,19 @@ protected:
 	FSKGFirearmCachedParts CachedComponents;
 	UFUNCTION()
 	virtual void OnRep_CachedComponent() {}
-	UPROPERTY(Replicated)
+	UPROPERTY(ReplicatedUsing = OnRep_FirearmStats)
 	FSKGFirearmStats FirearmStats;
+	UFUNCTION()
+	void OnRep_FirearmStats() { NotifyFirearmStatsChanged(); }
+	// Incremented every time FirearmStats is recomputed or replicated
+	uint32 FirearmStatsVersion;
+	void NotifyFirearmStatsChanged();
+	// Per attachment component info, only entries for changed components are refreshed on an incremental update
+	UPROPERTY()
+	TMap<USKGAttachmentComponent*, FSKGFirearmCachedPartInfo> CachedPartInfo;
+	// Firearm parts bucketed by part type, updated with CachedParts. Neither keeps a particular order
+	TMap<ESKGPartType, TArray<AActor*>> PartTypeIndex;
+	FSKGFirearmPartStatsTotals PartStatsTotals;
 
 	bool bHasRunBeginPlay;
 	UPROPERTY()
@@ -57,7 +71,12 @@ protected:
 	virtual void PostInitializeComponents() override;
 	
 	void HandleCachingAttachment(USKGAttachmentComponent* AttachmentComponent);
-	void HandleUpdateFirearmStats(USKGAttachmentComponent* AttachmentComponent);
+	// Rebuilds CachedComponents, CachedParts and FirearmStats from CachedPartInfo in attachment manager order
+	void RebuildCachedParts();
+	// Incremental counterparts of RebuildCachedParts for a single part. RemoveCachedPart returns false if a full rebuild is needed
+	void AddCachedPart(USKGAttachmentComponent* AttachmentComponent, const FSKGFirearmCachedPartInfo& PartInfo);
+	bool RemoveCachedPart(USKGAttachmentComponent* AttachmentComponent, const FSKGFirearmCachedPartInfo& PartInfo);
+	void FinishCachedPartsUpdate();
 public:
 	UFUNCTION(BlueprintCallable, Category = "SKGFPSFramework|Firearm")
 	void DestroyAllParts();
@@ -82,6 +101,15 @@ public:
 	ASKGMuzzle* GetMuzzleDevice();
 	UFUNCTION(BlueprintPure, Category = "SKGFPSFramework|Part")
 	AActor* GetMuzzleActor();
+	UFUNCTION(BlueprintPure, Category = "SKGFPSFramework|Part")
+	TArray<AActor*> GetPartsOfPartType(ESKGPartType PartType) const { return GetPartsOfType(PartType); }
+	const TArray<AActor*>& GetPartsOfType(ESKGPartType PartType) const;
+
+	// Const access to the current stats without the by value copy of the firearm interface, pair with GetFirearmStatsVersion to detect changes
+	const FSKGFirearmStats& GetFirearmStatsRef() const { return FirearmStats; }
+	uint32 GetFirearmStatsVersion() const { return FirearmStatsVersion; }
+	// Broadcast after FirearmStats changes (attachment change on the server, replication on the owning client)
+	FSKGOnFirearmStatsChanged OnFirearmStatsChanged;
 	
 	// ATTACHMENT INTERFACE
 	virtual UMeshComponent* GetMesh_Implementation() override { return FirearmMesh; }
@@ -0,0 +1,35 @@
+// Copyright 2023, Dakota Dawe, All rights reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SKGInfraredWorldSubsystem.generated.h"
+
+class USKGCharacterComponent;
+class UMaterialParameterCollectionInstance;
+
+// Drives the InfraredStrobeOn material parameter from one looping world timer. The timer only runs
+// while a local viewer with night vision on and infrared devices is registered
+UCLASS()
+class ULTIMATEFPSFRAMEWORK_API USKGInfraredWorldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+protected:
+	TArray<TWeakObjectPtr<USKGCharacterComponent>> StrobeViewers;
+	TWeakObjectPtr<UMaterialParameterCollectionInstance> StrobeMPC;
+	FTimerHandle StrobeTimerHandle;
+	bool bStrobeOn = false;
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	void ToggleStrobe();
+	void StopStrobe();
+
+public:
+	// Starts the strobe for this viewer if it uses infrared material settings, has night vision on and has infrared devices, otherwise removes it
+	void UpdateStrobeViewer(USKGCharacterComponent* Viewer);
+	void RemoveStrobeViewer(USKGCharacterComponent* Viewer);
+	bool IsStrobeRunning() const { return StrobeTimerHandle.IsValid(); }
+};